@@ -25,7 +25,8 @@ ConfigurationParameters::ConfigurationParameters(string inputFile, Solver output
         string solverServer, string solverCommand,
         string systusRBE2TranslationMode, double systusRBEStiffness, double systusRBECoefficient,
         string systusOptionAnalysis, string systusOutputProduct, vector<vector<int> > systusSubcases,
-        string systusOutputMatrix, int systusSizeMatrix, string systusDynamicMethod, string nastranOutputDialect) :
+        string systusOutputMatrix, int systusSizeMatrix, string systusDynamicMethod, string nastranOutputDialect,
+        string profileReportFile, bool keepInputContext, int sampledAssertionNodes) :
                 inputFile(inputFile), outputSolver(outputSolver), solverVersion(solverVersion), outputFile(
                 outputFile), outputPath(outputPath), logLevel(logLevel), translationMode(
                 translationMode), resultFile(resultFile), testTolerance(tolerance), runSolver(
@@ -34,7 +35,8 @@ ConfigurationParameters::ConfigurationParameters(string inputFile, Solver output
                 systusRBECoefficient(systusRBECoefficient), systusOptionAnalysis(systusOptionAnalysis),
                 systusOutputProduct(systusOutputProduct), systusSubcases(systusSubcases),
                 systusOutputMatrix(systusOutputMatrix), systusSizeMatrix(systusSizeMatrix), systusDynamicMethod(systusDynamicMethod),
-                nastranOutputDialect(nastranOutputDialect)
+                nastranOutputDialect(nastranOutputDialect), profileReportFile(profileReportFile),
+                keepInputContext(keepInputContext), sampledAssertionNodes(sampledAssertionNodes)
 {
 
 }
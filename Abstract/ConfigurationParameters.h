@@ -210,7 +210,8 @@ public:
             std::string systusOptionAnalysis="auto", std::string systusOutputProduct="systus",
             std::vector< std::vector<int> > systusSubcases = {},
             std::string systusOutputMatrix="table", int systusSizeMatrix=9,
-            std::string systusDynamicMethod="auto", std::string nastranOutputDialect="cosmic95");
+            std::string systusDynamicMethod="auto", std::string nastranOutputDialect="cosmic95",
+            std::string profileReportFile="", bool keepInputContext = true, int sampledAssertionNodes = 0);
     ModelConfiguration getModelConfiguration() const;
 
     const std::string inputFile;
@@ -250,6 +251,20 @@ public:
      * Nastran syntax that should be written: cosmic95 or modern
      */
     const std::string nastranOutputDialect;
+    /**
+     * JSON file receiving the time and memory used by each translation phase. Empty for no report.
+     */
+    const std::string profileReportFile;
+    /**
+     * Keep the input file and line where each object has been found, for messages. Can be dropped
+     * to save memory on large production conversions.
+     */
+    const bool keepInputContext;
+    /**
+     * Number of nodes, evenly chosen, checked in each subcase by the displacement assertions read
+     * from the result file. 0 to check every node.
+     */
+    const int sampledAssertionNodes;
 };
 
 }
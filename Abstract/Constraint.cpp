@@ -25,6 +25,7 @@
 #include "Model.h"
 #include <ciso646>
 #include <string>
+#include <algorithm>
 #include <boost/geometry.hpp>
 #include <boost/geometry/index/rtree.hpp>
 #include <boost/geometry/geometries/geometries.hpp>
@@ -87,6 +88,16 @@ set<shared_ptr<Constraint>, ptrLess<Constraint> > ConstraintSet::getConstraints(
 set<shared_ptr<Constraint>, ptrLess<Constraint> > ConstraintSet::getConstraintsByType(
         Constraint::Type type) const noexcept {
     set<shared_ptr<Constraint>, ptrLess<Constraint> > result;
+    if (constraintSetReferences.empty()) {
+        // resolved constraints are sorted by reference, so each type is a contiguous bucket
+        const auto& constraints = model.getResolvedConstraints(this->getReference());
+        const auto& bucketBegin = partition_point(constraints.begin(), constraints.end(),
+                [type](const shared_ptr<Constraint>& constraint) {return constraint->type < type;});
+        const auto& bucketEnd = partition_point(bucketBegin, constraints.end(),
+                [type](const shared_ptr<Constraint>& constraint) {return constraint->type == type;});
+        result.insert(bucketBegin, bucketEnd);
+        return result;
+    }
     for (const auto& constraint : getConstraints()) {
         if (constraint->type == type) {
             result.insert(constraint);
@@ -96,6 +107,9 @@ set<shared_ptr<Constraint>, ptrLess<Constraint> > ConstraintSet::getConstraintsB
 }
 
 size_t ConstraintSet::size() const noexcept {
+    if (constraintSetReferences.empty()) {
+        return model.getResolvedConstraints(this->getReference()).size();
+    }
     return getConstraints().size();
 }
 
@@ -109,6 +123,11 @@ const map<ConstraintSet::Type, string> ConstraintSet::stringByType = {
     };
 
 bool ConstraintSet::hasFunctions() const noexcept {
+    if (constraintSetReferences.empty()) {
+        const auto& constraints = model.getResolvedConstraints(this->getReference());
+        return any_of(constraints.begin(), constraints.end(),
+                [](const shared_ptr<Constraint>& constraint) {return constraint->hasFunctions();});
+    }
     for (const auto& constraint : getConstraints()) {
 		if (constraint->hasFunctions()) {
 			return true;
@@ -118,6 +137,11 @@ bool ConstraintSet::hasFunctions() const noexcept {
 }
 
 bool ConstraintSet::hasContacts() const noexcept {
+    if (constraintSetReferences.empty()) {
+        const auto& constraints = model.getResolvedConstraints(this->getReference());
+        return any_of(constraints.begin(), constraints.end(),
+                [](const shared_ptr<Constraint>& constraint) {return constraint->isContact();});
+    }
     for (const auto& constraint : getConstraints()) {
 		if (constraint->isContact()) {
 			return true;
@@ -495,16 +519,15 @@ void SinglePointConstraint::emulateLocalDisplacementConstraint() {
         const Node& node = model.mesh.findNode(nodePosition);
         if (node.displacementCS != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID) {
             const auto& coordSystem = model.mesh.getCoordinateSystemByPosition(node.displacementCS);
-            // TODO LD: this should be done differently: is used to compute different nodes but every this it changes the coordinate system instance!
-            coordSystem->updateLocalBase(VectorialValue(node.x, node.y, node.z));
+            const VectorialValue point(node.x, node.y, node.z);
             const DOFS& dofs = this->getDOFSForNode(nodePosition);
             if (model.configuration.logLevel >= LogLevel::TRACE)
                 cout << "Replacing local spc " << *this << " for: " << node << ",dofs " << this->getDOFSForNode(nodePosition) << endl;
             for (char i = 0; i < 6; i++) {
                 const DOF& currentDOF = *DOF::dofByPosition[i];
                 if (dofs.contains(currentDOF)) {
-                    const VectorialValue& participation = coordSystem->vectorToGlobal(
-                            VectorialValue::XYZ[i % 3]);
+                    const VectorialValue& participation = coordSystem->vectorToGlobalAt(
+                            point, VectorialValue::XYZ[i % 3]);
                     shared_ptr<LinearMultiplePointConstraint> lmpc =
                             make_shared<LinearMultiplePointConstraint>(model,
                                     this->getDoubleForDOF(currentDOF));
@@ -25,6 +25,9 @@
 #include "Mesh.h"
 #include <boost/numeric/ublas/matrix.hpp>
 #include <math.h>
+#include <algorithm>
+#include <functional>
+#include <thread>
 
 namespace vega {
 
@@ -89,6 +92,136 @@ VectorialValue CoordinateSystem::getEulerAnglesIntrinsicZYX(const CoordinateSyst
     return VectorialValue(ax, ay, az);
 }
 
+VectorialValue CoordinateSystem::vectorToGlobalAt(const VectorialValue& point, const VectorialValue& local) const {
+    UNUSEDV(point);
+    return vectorToGlobal(local);
+}
+
+void CoordinateSystem::flatten() {
+    flattened = false;
+    // This coordinate system and its references, up to the global coordinate system
+    vector<const CoordinateSystem*> chain{this};
+    while (chain.back()->rcs != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM) {
+        const auto& reference = mesh.findCoordinateSystem(chain.back()->rcs);
+        if (reference == nullptr or reference->coordType == CoordinateType::CYLINDRICAL
+                or reference->coordType == CoordinateType::SPHERICAL
+                or find(chain.begin(), chain.end(), reference.get()) != chain.end()) {
+            return;
+        }
+        chain.push_back(reference.get());
+    }
+    for (const CoordinateSystem* cs : chain) {
+        if (cs->isVirtual) {
+            return;
+        }
+    }
+    globalOrigin = origin;
+    globalEx = ex;
+    globalEy = ey;
+    globalEz = ez;
+    for (size_t i = 1; i < chain.size(); i++) {
+        const CoordinateSystem& reference = *chain[i];
+        auto rotate = [&reference](const VectorialValue& v) {
+            return VectorialValue(v.x() * reference.ex.x() + v.y() * reference.ey.x() + v.z() * reference.ez.x(),
+                    v.x() * reference.ex.y() + v.y() * reference.ey.y() + v.z() * reference.ez.y(),
+                    v.x() * reference.ex.z() + v.y() * reference.ey.z() + v.z() * reference.ez.z());
+        };
+        globalOrigin = reference.origin + rotate(globalOrigin);
+        globalEx = rotate(globalEx);
+        globalEy = rotate(globalEy);
+        globalEz = rotate(globalEz);
+    }
+    flattened = true;
+}
+
+/**
+ * Run transform(begin, end) over [0, count), in slices on several threads for large counts.
+ */
+static void runInSlices(size_t count, const function<void(size_t, size_t)>& transform) {
+    const size_t threads = count < CoordinateSystem::PARALLEL_TRANSFORM_MINIMUM_COUNT ? 1 :
+            max(1u, thread::hardware_concurrency());
+    if (threads == 1) {
+        transform(0, count);
+        return;
+    }
+    vector<thread> workers;
+    for (size_t t = 0; t < threads; t++) {
+        workers.emplace_back(transform, count * t / threads, count * (t + 1) / threads);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void CoordinateSystem::positionsToGlobal(const double* local, double* global, size_t count) const {
+    if (not flattened) {
+        for (size_t i = 0; i < 3 * count; i += 3) {
+            const VectorialValue& position = positionToGlobal(VectorialValue(local[i], local[i + 1], local[i + 2]));
+            global[i] = position.x();
+            global[i + 1] = position.y();
+            global[i + 2] = position.z();
+        }
+        return;
+    }
+    runInSlices(count, [this, local, global](size_t begin, size_t end) {
+        const double* in = local + 3 * begin;
+        double* out = global + 3 * begin;
+        const size_t sliceCount = end - begin;
+        // Cylindrical (r, theta, z) and spherical (r, theta, phi) to cartesian, degrees as in positionToGlobal()
+        if (coordType == CoordinateType::CYLINDRICAL) {
+            for (size_t i = 0; i < 3 * sliceCount; i += 3) {
+                const double r = in[i], theta = in[i + 1];
+                out[i] = r * cos(M_PI * theta / 180.0);
+                out[i + 1] = r * sin(M_PI * theta / 180.0);
+                out[i + 2] = in[i + 2];
+            }
+            in = out;
+        } else if (coordType == CoordinateType::SPHERICAL) {
+            for (size_t i = 0; i < 3 * sliceCount; i += 3) {
+                const double r = in[i], theta = in[i + 1], phi = in[i + 2];
+                out[i] = r * sin(M_PI * theta / 180.0) * cos(M_PI * phi / 180.0);
+                out[i + 1] = r * sin(M_PI * theta / 180.0) * sin(M_PI * phi / 180.0);
+                out[i + 2] = r * cos(M_PI * theta / 180.0);
+            }
+            in = out;
+        }
+        VectorialValue::combine(globalOrigin, globalEx, globalEy, globalEz, in, out, sliceCount);
+    });
+}
+
+void CoordinateSystem::vectorsToGlobal(const double* points, const double* local, double* global, size_t count) const {
+    if (not flattened or coordType == CoordinateType::SPHERICAL) {
+        for (size_t i = 0; i < 3 * count; i += 3) {
+            const VectorialValue& point = points == nullptr ? VectorialValue::O :
+                    VectorialValue(points[i], points[i + 1], points[i + 2]);
+            const VectorialValue& vect = vectorToGlobalAt(point, VectorialValue(local[i], local[i + 1], local[i + 2]));
+            global[i] = vect.x();
+            global[i + 1] = vect.y();
+            global[i + 2] = vect.z();
+        }
+        return;
+    }
+    if (coordType != CoordinateType::CYLINDRICAL) {
+        runInSlices(count, [this, local, global](size_t begin, size_t end) {
+            VectorialValue::combine(VectorialValue::O, globalEx, globalEy, globalEz, local + 3 * begin,
+                    global + 3 * begin, end - begin);
+        });
+        return;
+    }
+    if (points == nullptr) {
+        throw invalid_argument("Points are needed to transform vectors of a cylindrical coordinate system.");
+    }
+    runInSlices(count, [this, points, local, global](size_t begin, size_t end) {
+        for (size_t i = 3 * begin; i < 3 * end; i += 3) {
+            const VectorialValue& vect = vectorToGlobalAt(VectorialValue(points[i], points[i + 1], points[i + 2]),
+                    VectorialValue(local[i], local[i + 1], local[i + 2]));
+            global[i] = vect.x();
+            global[i + 1] = vect.y();
+            global[i + 2] = vect.z();
+        }
+    });
+}
+
 
 CartesianCoordinateSystem::CartesianCoordinateSystem(const Mesh& mesh,
         const VectorialValue& origin, const VectorialValue& ex, const VectorialValue& ey, const Reference<CoordinateSystem> rcs,
@@ -105,6 +238,9 @@ CartesianCoordinateSystem::CartesianCoordinateSystem(const Mesh& mesh,
 }
 
 VectorialValue CartesianCoordinateSystem::positionToGlobal(const VectorialValue& local) const{
+    if (flattened) {
+        return flattenedToGlobal(local.x(), local.y(), local.z());
+    }
     VectorialValue global = vectorToGlobal(local);
     if (rcs == CoordinateSystem::GLOBAL_COORDINATE_SYSTEM) {
         return this->getOrigin()+ global;
@@ -115,6 +251,9 @@ VectorialValue CartesianCoordinateSystem::positionToGlobal(const VectorialValue&
 }
 
 VectorialValue CartesianCoordinateSystem::vectorToGlobal(const VectorialValue& local) const {
+    if (flattened) {
+        return flattenedVectorToGlobal(local.x(), local.y(), local.z());
+    }
     double x = local.x() * ex.x() + local.y() * ey.x() + local.z() * ez.x();
     double y = local.x() * ex.y() + local.y() * ey.y() + local.z() * ez.y();
     double z = local.x() * ex.z() + local.y() * ey.z() + local.z() * ez.z();
@@ -150,6 +289,7 @@ unique_ptr<CoordinateSystem> CartesianCoordinateSystem::clone() const {
 }
 
 void CartesianCoordinateSystem::build(){
+    flattened = false;
 
     if (isVirtual){
         int nO  = this->nodesId[0];
@@ -198,6 +338,9 @@ void CylindricalCoordinateSystem::updateLocalBase(const VectorialValue& point) {
 VectorialValue CylindricalCoordinateSystem::positionToGlobal(const VectorialValue& local) const{
     double rcosth = local.x()*cos(M_PI*local.y()/180.0);
     double rsinth = local.x()*sin(M_PI*local.y()/180.0);
+    if (flattened) {
+        return flattenedToGlobal(rcosth, rsinth, local.z());
+    }
     double x = rcosth*ex.x() + rsinth*ey.x() + local.z()*ez.x();
     double y = rcosth*ex.y() + rsinth*ey.y() + local.z()*ez.y();
     double z = rcosth*ex.z() + rsinth*ey.z() + local.z()*ez.z();
@@ -224,6 +367,29 @@ VectorialValue CylindricalCoordinateSystem::vectorToGlobal(
     }
 }
 
+VectorialValue CylindricalCoordinateSystem::vectorToGlobalAt(const VectorialValue& point,
+        const VectorialValue& local) const {
+    // Local base at point: ur = cos * ex + sin * ey, utheta = -sin * ex + cos * ey
+    const VectorialValue& localOrigin = point - origin;
+    const double a = localOrigin.dot(ex);
+    const double b = localOrigin.dot(ey);
+    const double rho = sqrt(a * a + b * b);
+    const double cosTheta = rho > 0 ? a / rho : 1.0;
+    const double sinTheta = rho > 0 ? b / rho : 0.0;
+    const double u = local.x() * cosTheta - local.y() * sinTheta;
+    const double v = local.x() * sinTheta + local.y() * cosTheta;
+    if (flattened) {
+        return flattenedVectorToGlobal(u, v, local.z());
+    }
+    const VectorialValue& vect = u * ex + v * ey + local.z() * ez;
+    if (rcs == CoordinateSystem::GLOBAL_COORDINATE_SYSTEM) {
+        return vect;
+    } else {
+        shared_ptr<CoordinateSystem> coordSystem = mesh.findCoordinateSystem(rcs);
+        return coordSystem->vectorToGlobal(vect);
+    }
+}
+
 VectorialValue CylindricalCoordinateSystem::vectorToLocal(const VectorialValue& global) const {
     UNUSEDV(global);
     throw logic_error("Global To Local vector conversion not done for Cylindrical Coordinate System");
@@ -242,7 +408,7 @@ VectorialValue CylindricalCoordinateSystem::getLocalEulerAnglesIntrinsicZYX(cons
 SphericalCoordinateSystem::SphericalCoordinateSystem(const Mesh& mesh,
         const VectorialValue origin, const VectorialValue ex, const VectorialValue ey, const Reference<CoordinateSystem> rcs,
         int original_id) :
-        CoordinateSystem(mesh, CoordinateSystem::Type::ABSOLUTE, CoordinateSystem::CoordinateType::CYLINDRICAL, origin, ex, ey, rcs, original_id) {
+        CoordinateSystem(mesh, CoordinateSystem::Type::ABSOLUTE, CoordinateSystem::CoordinateType::SPHERICAL, origin, ex, ey, rcs, original_id) {
 }
 
 // TODO : LD What's this ? Should this method be renamed moveOrigin ?
@@ -258,6 +424,9 @@ VectorialValue SphericalCoordinateSystem::positionToGlobal(const VectorialValue&
     double lx = r * sin(M_PI*theta/180.0) * cos(M_PI*phi/180.0);
     double ly = r * sin(M_PI*theta/180.0) * sin(M_PI*phi/180.0);
     double lz = r * cos(M_PI*theta/180.0);
+    if (flattened) {
+        return flattenedToGlobal(lx, ly, lz);
+    }
 
     double x = lx*ex.x() + ly*ey.x() + lz*ez.x();
     double y = lx*ex.y() + ly*ey.y() + lz*ez.y();
@@ -307,6 +476,7 @@ OrientationCoordinateSystem::OrientationCoordinateSystem(const Mesh& mesh, const
 }
 
 void OrientationCoordinateSystem::build(){
+    flattened = false;
 
     if (isVirtual){
         const Node& nodeO = mesh.findNode(mesh.findNodePosition(this->getNodeO()));
@@ -372,6 +542,9 @@ VectorialValue OrientationCoordinateSystem::positionToGlobal(const VectorialValu
     if (isVirtual){
         throw logic_error("Coordinate System is still virtual.");
     }
+    if (flattened) {
+        return flattenedToGlobal(local.x(), local.y(), local.z());
+    }
     VectorialValue global = vectorToGlobal(local);
     if (rcs == CoordinateSystem::GLOBAL_COORDINATE_SYSTEM) {
         return origin + global;
@@ -385,6 +558,9 @@ VectorialValue OrientationCoordinateSystem::vectorToGlobal(const VectorialValue&
     if (isVirtual){
         throw logic_error("Coordinate System is still virtual.");
     }
+    if (flattened) {
+        return flattenedVectorToGlobal(local.x(), local.y(), local.z());
+    }
     double x = local.x() * ex.x() + local.y() * ey.x() + local.z() * ez.x();
     double y = local.x() * ex.y() + local.y() * ey.y() + local.z() * ez.y();
     double z = local.x() * ex.z() + local.y() * ey.z() + local.z() * ez.z();
@@ -66,9 +66,32 @@ protected:
     bool isVirtual = false;
     std::vector<int> nodesId;
     boost::numeric::ublas::matrix<double> inverseMatrix;
+    /**
+     * Transform to the global coordinate system with the reference coordinate systems resolved,
+     * set by flatten(): global = globalOrigin + (globalEx, globalEy, globalEz) * cartesian(local).
+     */
+    bool flattened = false;
+    VectorialValue globalOrigin;
+    VectorialValue globalEx;
+    VectorialValue globalEy;
+    VectorialValue globalEz;
+    /**
+     * Global position of a local position already converted to cartesian coordinates, using the flattened transform.
+     */
+    inline VectorialValue flattenedToGlobal(double x, double y, double z) const noexcept {
+        return globalOrigin + VectorialValue(x * globalEx.x() + y * globalEy.x() + z * globalEz.x(),
+                x * globalEx.y() + y * globalEy.y() + z * globalEz.y(),
+                x * globalEx.z() + y * globalEy.z() + z * globalEz.z());
+    }
+    inline VectorialValue flattenedVectorToGlobal(double x, double y, double z) const noexcept {
+        return VectorialValue(x * globalEx.x() + y * globalEy.x() + z * globalEz.x(),
+                x * globalEx.y() + y * globalEy.y() + z * globalEz.y(),
+                x * globalEx.z() + y * globalEy.z() + z * globalEz.z());
+    }
 
 public:
     static const std::string name;
+    static const size_t PARALLEL_TRANSFORM_MINIMUM_COUNT = 100000;
     static const std::map<Type, std::string> stringByType;
     static const std::map<CoordinateType, std::string> stringByCoordinateSystemType;
     inline VectorialValue getOrigin() const noexcept {return origin;};
@@ -101,6 +124,32 @@ public:
      *   account, so do NOT use this to convert coordinates.
      */
     virtual VectorialValue vectorToLocal(const VectorialValue&) const = 0;
+    /**
+     *  Translate a vector like vectorToGlobal(), with the local base evaluated at point
+     *   (expressed in the reference coordinate system) as updateLocalBase() would,
+     *   but without changing this coordinate system: safe to call from several threads.
+     */
+    virtual VectorialValue vectorToGlobalAt(const VectorialValue& point, const VectorialValue& local) const;
+    /**
+     *  Compose this coordinate system with its reference ones into a single transform to the
+     *   global coordinate system, once built. Called by Model::finish(): the transforms then no
+     *   longer look up the reference coordinate systems. Left undone if a reference coordinate
+     *   system is not cartesian.
+     */
+    void flatten();
+    inline bool isFlattened() const noexcept {
+        return flattened;
+    }
+    /**
+     *  positionToGlobal() of count packed (x,y,z) triplets, threaded on large arrays.
+     *   local and global may be the same array.
+     */
+    void positionsToGlobal(const double* local, double* global, size_t count) const;
+    /**
+     *  vectorToGlobalAt() of count packed (x,y,z) triplets, threaded on large arrays. points
+     *   are only read by the coordinate systems with a local base, they may be null otherwise.
+     */
+    void vectorsToGlobal(const double* points, const double* local, double* global, size_t count) const;
     /**
      *  Compute the Euler Angles (PSI,THETA,PHI) around the axes (OZ, OY, OX)
      *  of the reference coordinate system RCS. If no rcsPos is provided, the global
@@ -177,6 +226,7 @@ public:
      *   Point must be expressed in the reference cartesian coordinate system.
      */
     void updateLocalBase(const VectorialValue & point) override;
+    VectorialValue vectorToGlobalAt(const VectorialValue& point, const VectorialValue& local) const override;
     /**
      *  Translate a position expressed in this coordinate system (r, theta, z),
      *   to its global counterpart (x,y,z). theta is expressed in degrees.
@@ -284,35 +284,48 @@ ostream &operator<<(ostream &out, const DOFS& dofs) noexcept {
 }
 
 DOFMatrix::DOFMatrix(MatrixType matrixType) noexcept : matrixType(matrixType) {
+    values.fill(0.0);
+}
 
+const DOF& DOFMatrix::dofAt(dof_int position) noexcept {
+    static const DOF* dofByPosition[BLOCK_SIZE] = {&DOF::DX, &DOF::DY, &DOF::DZ, &DOF::RX, &DOF::RY, &DOF::RZ};
+    return *dofByPosition[position];
 }
 
 void DOFMatrix::addComponent(const DOF dof1, const DOF dof2, const double value) {
     if (matrixType == MatrixType::DIAGONAL and dof1 != dof2 and not is_zero(value)) {
         throw logic_error("Cannot assign non-zero value out of diagonal for a diagonal matrix");
     }
+    size_t index;
 	if (matrixType == MatrixType::SYMMETRIC and dof1 > dof2) {
-		componentByDofs[{dof2, dof1}] = value;
+		index = dof2.position * BLOCK_SIZE + dof1.position;
 	} else {
-		componentByDofs[{dof1, dof2}] = value;
+		index = dof1.position * BLOCK_SIZE + dof2.position;
 	}
+	values[index] = value;
+	assigned.set(index);
 }
 
 double DOFMatrix::findComponent(const DOF dof1, const DOF dof2) const noexcept {
     if (matrixType == MatrixType::DIAGONAL and dof1 != dof2) {
         return 0.0;
 	} else if (matrixType == MatrixType::SYMMETRIC and dof1 > dof2) {
-		auto it = componentByDofs.find({dof2, dof1});
-		if (it != componentByDofs.end()) {
-			return it->second;
-		}
+		return values[dof2.position * BLOCK_SIZE + dof1.position];
 	} else {
-		auto it = componentByDofs.find({dof1, dof2});
-		if (it != componentByDofs.end()) {
-			return it->second;
-		}
+		return values[dof1.position * BLOCK_SIZE + dof2.position];
 	}
-	return 0.0;
+}
+
+DOFMatrix::iterator DOFMatrix::begin() const noexcept {
+    return iterator(this, 0);
+}
+
+DOFMatrix::iterator DOFMatrix::end() const noexcept {
+    return iterator(this, assigned.size());
+}
+
+size_t DOFMatrix::size() const noexcept {
+    return assigned.count();
 }
 
 vector<double> DOFMatrix::asColumnsVector(bool addRotationsIfNotPresent) const noexcept {
@@ -349,41 +362,32 @@ vector<double> DOFMatrix::diagonal(bool addRotationsIfNotPresent) const noexcept
 }
 
 bool DOFMatrix::hasRotations() const noexcept {
-	bool hasRotations = false;
-	for (const auto& kv : componentByDofs) {
-		DOF dof1 = kv.first.first;
-		DOF dof2 = kv.first.second;
-		if (dof1.isRotation or dof2.isRotation) {
-			hasRotations = true;
-			break;
+	for (const auto& component : *this) {
+		if (component.dof1.isRotation or component.dof2.isRotation) {
+			return true;
 		}
 	}
-	return hasRotations;
+	return false;
 }
 
 bool DOFMatrix::hasTranslations() const noexcept {
-	bool hasTranslations = false;
-	for (const auto& kv : componentByDofs) {
-		DOF dof1 = kv.first.first;
-		DOF dof2 = kv.first.second;
-		if (dof1.isTranslation or dof2.isTranslation) {
-			hasTranslations = true;
-			break;
+	for (const auto& component : *this) {
+		if (component.dof1.isTranslation or component.dof2.isTranslation) {
+			return true;
 		}
 	}
-	return hasTranslations;
+	return false;
 }
 
 bool DOFMatrix::isDiagonal() const noexcept {
 	if (matrixType == MatrixType::DIAGONAL) {
         return true;
     }
-	for (const auto& kv : componentByDofs) {
-		if (kv.first.first != kv.first.second and !is_zero(kv.second)) {
+	for (const auto& component : *this) {
+		if (component.dof1 != component.dof2 and !is_zero(component.value)) {
 			return false;
 		}
 	}
-
 	return true;
 }
 
@@ -394,70 +398,54 @@ bool DOFMatrix::isSymmetric() const noexcept {
 	if (matrixType == MatrixType::DIAGONAL) {
         return true;
     }
-	for (const auto& kv : componentByDofs) {
-	    const auto& kv2 = componentByDofs.find({kv.first.second, kv.first.first});
-		if (kv2 == componentByDofs.end()) {
-            if (!is_zero(kv.second)) {
-                return false;
-            }
-		} else {
-		    if (!is_equal(kv.second, kv2->second)) {
-                return false;
-            }
+	// Unassigned components are zero
+	for (const auto& component : *this) {
+		if (!is_equal(component.value, values[component.dof2.position * BLOCK_SIZE + component.dof1.position])) {
+			return false;
 		}
 	}
 	return true;
 }
 
 bool DOFMatrix::isMaxDiagonal() const noexcept {
-	bool isMaxDiagonal = true;
-	for (const auto& kv : componentByDofs) {
-		if ((kv.first.first != kv.first.second and !is_zero(kv.second)) or !is_equal(kv.second, DBL_MAX)) {
-			isMaxDiagonal = false;
-			break;
+	for (const auto& component : *this) {
+		if ((component.dof1 != component.dof2 and !is_zero(component.value)) or !is_equal(component.value, DBL_MAX)) {
+			return false;
 		}
 	}
-	return isMaxDiagonal;
+	return true;
 }
 
 bool DOFMatrix::isEmpty() const noexcept {
-	return componentByDofs.empty();
+	return assigned.none();
 }
 
 bool DOFMatrix::isZero() const noexcept {
-    bool isZero = true;
-	for (const auto& kv : componentByDofs) {
-		if (not is_zero(kv.second)) {
-			isZero = false;
-			break;
+	for (const auto& component : *this) {
+		if (not is_zero(component.value)) {
+			return false;
 		}
 	}
-	return isZero;
+	return true;
 }
 
 void DOFMatrix::setAllZero() noexcept {
-    for (auto& entry : componentByDofs) {
-        entry.second = 0.0;
-    }
+    values.fill(0.0);
 }
 
 DOFMatrix DOFMatrix::transposed() const noexcept {
     DOFMatrix transposed(matrixType);
-    for (auto& entry : componentByDofs) {
-        transposed.addComponent(entry.first.second, entry.first.first, entry.second);
+    for (const auto& component : *this) {
+        transposed.addComponent(component.dof2, component.dof1, component.value);
     }
     return transposed;
 }
 
 bool DOFMatrix::isEqual(const DOFMatrix& other) const noexcept {
-    if (componentByDofs.size() != other.componentByDofs.size())
+    if (assigned != other.assigned)
         return false; // This should be relaxed: maybe other matrix has some zero values explicitely
-    for (auto& entry : componentByDofs) {
-        const auto& otherit = other.componentByDofs.find(entry.first);
-        if (otherit == other.componentByDofs.end() and not is_zero(entry.second)) {
-            return false;
-        }
-        if (not is_equal(entry.second, otherit->second)) {
+    for (const auto& component : *this) {
+        if (not is_equal(component.value, other.values[component.dof1.position * BLOCK_SIZE + component.dof2.position])) {
             return false;
         }
     }
@@ -15,6 +15,8 @@
 #include "Value.h"
 #include <boost/bimap.hpp>
 #include <unordered_map>
+#include <array>
+#include <bitset>
 #include <set>
 
 namespace vega {
@@ -159,16 +161,60 @@ std::ostream &operator<<(std::ostream &out, const DOFS& dofs) noexcept;
 std::ostream &operator<<(std::ostream &out, const DOFS::iterator& dofs_iter) noexcept;
 
 /**
- * Sparse matrix between two dofs (of the same node), or the same dof with itself.
+ * Matrix between the dofs of two nodes (or of the same node), stored as a dense 6x6 block.
+ * Only the assigned components are reported: the upper part for symmetric matrices, the
+ * diagonal for diagonal matrices.
  */
 class DOFMatrix final {
+private:
+		static const dof_int BLOCK_SIZE = 6;
+		/** Values by row and column DOF positions (row major) */
+		std::array<double, BLOCK_SIZE * BLOCK_SIZE> values;
+		std::bitset<BLOCK_SIZE * BLOCK_SIZE> assigned;
+		static const DOF& dofAt(dof_int position) noexcept;
 public:
-		std::unordered_map<std::pair<DOF, DOF>, double,
-				boost::hash<std::pair<int, int>>>componentByDofs;
 		const MatrixType matrixType;
+		/**
+		 * An assigned component, as found by iterating over the matrix in row major order.
+		 */
+		struct Component {
+			const DOF& dof1;
+			const DOF& dof2;
+			double value;
+		};
+		class iterator {
+		private:
+			const DOFMatrix* matrix;
+			size_t index;
+			void skipUnassigned() noexcept {
+				while (index < matrix->assigned.size() and not matrix->assigned[index]) {
+					++index;
+				}
+			}
+		public:
+			iterator(const DOFMatrix* matrix, size_t index) noexcept : matrix(matrix), index(index) {
+				skipUnassigned();
+			}
+			Component operator*() const noexcept {
+				return {dofAt(static_cast<dof_int>(index / BLOCK_SIZE)), dofAt(static_cast<dof_int>(index % BLOCK_SIZE)),
+					matrix->values[index]};
+			}
+			iterator& operator++() noexcept {
+				++index;
+				skipUnassigned();
+				return *this;
+			}
+			bool operator!=(const iterator& other) const noexcept {
+				return index != other.index;
+			}
+		};
 		DOFMatrix(MatrixType matrixType = MatrixType::FULL) noexcept;
 		void addComponent(const DOF dof1, const DOF dof2, const double value);
 		double findComponent(const DOF dof1, const DOF dof2) const noexcept;
+		iterator begin() const noexcept;
+		iterator end() const noexcept;
+		/** Number of assigned components */
+		size_t size() const noexcept;
 		bool hasTranslations() const noexcept;
 		bool hasRotations() const noexcept;
 		bool isDiagonal() const noexcept;
@@ -994,6 +994,8 @@ double ISectionBeam::getShearAreaFactorZ() const {
     return this->getAreaCrossSection() / web_area;
 }
 
+const DOFMatrix MatrixElement::EMPTY_BLOCK{MatrixType::FULL};
+
 MatrixElement::MatrixElement(Model& model, Type elementType, MatrixType matrixType, int original_id) :
 		CellElementSet(model, elementType, model.modelType, original_id), matrixType{matrixType} {
 }
@@ -1011,57 +1013,84 @@ void MatrixElement::addComponent(const int nodeid1, const DOF dof1, const int no
 		myDof1 = dof2;
 		myDof2 = dof1;
 	}
-	auto it = submatrixByNodes.find({nodePosition1, nodePosition2});
-	shared_ptr<DOFMatrix> subMatrix = nullptr;
-	if (it != submatrixByNodes.end()) {
-		subMatrix = it->second;
+	const auto& it = blockIndexByNodePair.find({nodePosition1, nodePosition2});
+	size_t blockIndex;
+	if (it != blockIndexByNodePair.end()) {
+		blockIndex = it->second;
 	} else {
 	    if (matrixType == MatrixType::SYMMETRIC and nodePosition1 != nodePosition2) {
             // a triangular symmetric matrix has the upper right block which is full (see K_TR_L)
-            subMatrix = make_shared<DOFMatrix>(MatrixType::FULL);
+            blocks.emplace_back(MatrixType::FULL);
 	    } else if (matrixType == MatrixType::SYMMETRIC and nodePosition1 == nodePosition2) {
-	        subMatrix = make_shared<DOFMatrix>(MatrixType::SYMMETRIC);
+	        blocks.emplace_back(MatrixType::SYMMETRIC);
 	    } else {
             throw logic_error("not yet implemented");
 	    }
-		this->submatrixByNodes[{nodePosition1, nodePosition2}] = subMatrix;
+	    blockIndex = blocks.size() - 1;
+	    blockNodePairs.push_back({nodePosition1, nodePosition2});
+		blockIndexByNodePair[{nodePosition1, nodePosition2}] = blockIndex;
+		compressed = false;
 	}
-    subMatrix->addComponent(myDof1, myDof2, value);
+    blocks[blockIndex].addComponent(myDof1, myDof2, value);
 }
 
 void MatrixElement::clear() noexcept {
-    submatrixByNodes.clear();
+    blocks.clear();
+    blockNodePairs.clear();
+    blockIndexByNodePair.clear();
+    compressed = false;
     CellContainer::clear();
 }
 
+void MatrixElement::compress() const {
+	if (compressed) {
+		return;
+	}
+	sortedNodePairs = blockNodePairs;
+	sort(sortedNodePairs.begin(), sortedNodePairs.end());
+	sortedNodePositions.clear();
+	sortedNodePositions.reserve(2 * sortedNodePairs.size());
+	for (const auto& nodePair : sortedNodePairs) {
+		sortedNodePositions.push_back(nodePair.first);
+		sortedNodePositions.push_back(nodePair.second);
+	}
+	sort(sortedNodePositions.begin(), sortedNodePositions.end());
+	sortedNodePositions.erase(unique(sortedNodePositions.begin(), sortedNodePositions.end()), sortedNodePositions.end());
+	coupledNodeCounts.assign(sortedNodePositions.size(), 0);
+	for (const auto& nodePair : sortedNodePairs) {
+		if (nodePair.first == nodePair.second) {
+			continue;
+		}
+		for (int nodePosition : {nodePair.first, nodePair.second}) {
+			const auto& it = lower_bound(sortedNodePositions.begin(), sortedNodePositions.end(), nodePosition);
+			coupledNodeCounts[static_cast<size_t>(it - sortedNodePositions.begin())]++;
+		}
+	}
+	compressed = true;
+}
 
-shared_ptr<const DOFMatrix> MatrixElement::findSubmatrix(const int nodePosition1, const int nodePosition2) const {
-	shared_ptr<DOFMatrix> result = make_shared<DOFMatrix>(matrixType);
-	auto it = submatrixByNodes.find({nodePosition1, nodePosition2});
-	if (it != submatrixByNodes.end()) {
-		std::copy(it->second->componentByDofs.begin(), it->second->componentByDofs.end(),
-				std::inserter(result->componentByDofs, result->componentByDofs.end()));
+const DOFMatrix& MatrixElement::findSubmatrix(const int nodePosition1, const int nodePosition2) const {
+	const auto& it = blockIndexByNodePair.find({nodePosition1, nodePosition2});
+	if (it == blockIndexByNodePair.end()) {
+		return EMPTY_BLOCK;
 	}
-	return result;
+	return blocks[it->second];
 }
 
 set<int> MatrixElement::nodePositions() const {
-	set<int> result;
-	for (const auto& kv : submatrixByNodes) {
-		result.insert(kv.first.first);
-		result.insert(kv.first.second);
-	}
-	return result;
+	compress();
+	return set<int>(sortedNodePositions.begin(), sortedNodePositions.end());
 }
 
 DOFS MatrixElement::getDOFSForNode(const int nodePosition) const {
 	DOFS dofs;
-	for (const auto& kv : submatrixByNodes) {
-		if (kv.first.first == nodePosition or kv.first.second) {
-			if (kv.second->hasRotations()) {
+	for (size_t blockIndex = 0; blockIndex < blocks.size(); blockIndex++) {
+		const auto& nodePair = blockNodePairs[blockIndex];
+		if (nodePair.first == nodePosition or nodePair.second == nodePosition) {
+			if (blocks[blockIndex].hasRotations()) {
 				dofs += DOFS::ROTATIONS;
 			}
-			if (kv.second->hasTranslations()) {
+			if (blocks[blockIndex].hasTranslations()) {
 				dofs += DOFS::TRANSLATIONS;
 			}
 		}
@@ -1069,26 +1098,18 @@ DOFS MatrixElement::getDOFSForNode(const int nodePosition) const {
 	return dofs;
 }
 
-set<pair<int, int>> MatrixElement::nodePairs() const {
-	set<pair<int, int>> result;
-	for (const auto& kv : submatrixByNodes) {
-		result.insert({kv.first.first, kv.first.second});
-	}
-	return result;
+const vector<pair<int, int>>& MatrixElement::nodePairs() const {
+	compress();
+	return sortedNodePairs;
 }
 
-std::set<std::pair<int, int>> MatrixElement::findInPairs(int nodePosition) const {
-	set<pair<int, int>> result;
-	for (const auto& kv : submatrixByNodes) {
-		if (kv.first.first != nodePosition and kv.first.second != nodePosition) {
-			continue;
-		}
-		if (kv.first.first == kv.first.second) {
-			continue;
-		}
-		result.insert({kv.first.first, kv.first.second});
+int MatrixElement::countCoupledNodes(int nodePosition) const {
+	compress();
+	const auto& it = lower_bound(sortedNodePositions.begin(), sortedNodePositions.end(), nodePosition);
+	if (it == sortedNodePositions.end() or *it != nodePosition) {
+		return 0;
 	}
-	return result;
+	return coupledNodeCounts[static_cast<size_t>(it - sortedNodePositions.begin())];
 }
 
 StiffnessMatrix::StiffnessMatrix(Model& model, MatrixType matrixType, int original_id) :
@@ -518,7 +518,23 @@ class NodalMass: public CellElementSet {
 /* Matrix for a group nodes.*/
 class MatrixElement : public CellElementSet {
 private:
-	std::map<std::pair<int, int>, std::shared_ptr<DOFMatrix>> submatrixByNodes;
+	/**
+	 * One 6x6 DOF block by node pair, with the lowest node position first (upper part of the
+	 * matrix, a symmetric matrix is stored once), in assembly order.
+	 */
+	std::vector<DOFMatrix> blocks;
+	std::vector<std::pair<int, int>> blockNodePairs;
+	std::unordered_map<std::pair<int, int>, size_t, boost::hash<std::pair<int, int>>> blockIndexByNodePair;
+	/**
+	 * Node pairs sorted by row and then column (compressed row order) and the nodes of the matrix
+	 * with the number of other nodes each one is coupled to. Rebuilt on first use after an assembly.
+	 */
+	mutable bool compressed = true;
+	mutable std::vector<std::pair<int, int>> sortedNodePairs;
+	mutable std::vector<int> sortedNodePositions;
+	mutable std::vector<int> coupledNodeCounts;
+	void compress() const;
+	static const DOFMatrix EMPTY_BLOCK;
 public:
 	MatrixElement(Model&, Type type, MatrixType matrixType, int original_id = NO_ORIGINAL_ID);
 	const MatrixType matrixType;
@@ -527,16 +543,25 @@ public:
 	 * Clear all nodes and submatrices of the Matrix.
 	 */
 	void clear() noexcept override final;
-	std::shared_ptr<const DOFMatrix> findSubmatrix(const int nodePosition1, const int nodePosition2) const;
+	/**
+	 * Block of a node pair, empty if the pair is not in the matrix.
+	 */
+	const DOFMatrix& findSubmatrix(const int nodePosition1, const int nodePosition2) const;
 	std::set<int> nodePositions() const override final;
-	std::set<std::pair<int, int>> nodePairs() const;
-	std::set<std::pair<int, int>> findInPairs(int nodePosition) const;
+	/**
+	 * Node pairs of the matrix, lowest node position first, sorted.
+	 */
+	const std::vector<std::pair<int, int>>& nodePairs() const;
+	/**
+	 * Number of other nodes the node is coupled to by the matrix.
+	 */
+	int countCoupledNodes(int nodePosition) const;
 	DOFS getDOFSForNode(const int nodePosition) const override final;
 	bool isMatrixElement() const override final {
 		return true;
 	}
     virtual bool effective() const override {
-        return not submatrixByNodes.empty();
+        return not blocks.empty();
     }
 	virtual bool validate() const override {
 		return true;
@@ -12,6 +12,7 @@
 #include "Model.h"
 //if with "or" and "and" under windows
 #include <ciso646>
+#include <algorithm>
 
 namespace vega {
 
@@ -87,7 +88,7 @@ ostream &operator<<(ostream &out, const LoadSet& loadset) {
 }
 
 size_t LoadSet::size() const {
-	return getLoadings().size();
+	return model.getResolvedLoadings(this->getReference()).size();
 }
 
 set<shared_ptr<Loading>, ptrLess<Loading> > LoadSet::getLoadings() const {
@@ -95,13 +96,13 @@ set<shared_ptr<Loading>, ptrLess<Loading> > LoadSet::getLoadings() const {
 }
 
 set<shared_ptr<Loading>, ptrLess<Loading> > LoadSet::getLoadingsByType(Loading::Type loadingType) const {
-	set<shared_ptr<Loading>, ptrLess<Loading> > result;
-	for (const auto& loading : getLoadings()) {
-		if (loading->type == loadingType) {
-			result.insert(loading);
-		}
-	}
-	return result;
+	// resolved loadings are sorted by reference, so each type is a contiguous bucket
+	const auto& loadings = model.getResolvedLoadings(this->getReference());
+	const auto& bucketBegin = partition_point(loadings.begin(), loadings.end(),
+			[loadingType](const shared_ptr<Loading>& loading) {return loading->type < loadingType;});
+	const auto& bucketEnd = partition_point(bucketBegin, loadings.end(),
+			[loadingType](const shared_ptr<Loading>& loading) {return loading->type == loadingType;});
+	return set<shared_ptr<Loading>, ptrLess<Loading> >(bucketBegin, bucketEnd);
 }
 
 bool LoadSet::validate() const {
@@ -115,7 +116,7 @@ bool LoadSet::validate() const {
 }
 
 bool LoadSet::hasFunctions() const {
-    for (const auto& loading : getLoadings()) {
+    for (const auto& loading : model.getResolvedLoadings(this->getReference())) {
 		if (loading->hasFunctions()) {
 			return true;
 		}
@@ -298,8 +299,7 @@ VectorialValue NodalForce::localToGlobal(int nodePosition, const VectorialValue&
 		throw logic_error(oss.str());
 	}
 	const Node& node = model.mesh.findNode(nodePosition);
-	coordSystem->updateLocalBase(VectorialValue(node.x, node.y, node.z));
-	return coordSystem->vectorToGlobal(vectorialValue);
+	return coordSystem->vectorToGlobalAt(VectorialValue(node.x, node.y, node.z), vectorialValue);
 }
 
 VectorialValue NodalForce::getForceInGlobalCS(int nodePosition) const {
@@ -508,6 +508,100 @@ bool StaticPressure::ineffective() const {
     return is_zero(magnitude);
 }
 
+BulkNodalForce::BulkNodalForce(Model& model, const std::shared_ptr<LoadSet> loadset, const int original_id) :
+		NodalForce(model, loadset, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, original_id) {
+}
+
+void BulkNodalForce::addEntry(int nodeId, const VectorialValue& force, const VectorialValue& moment,
+		int csPosition) {
+	if (force.iszero() and moment.iszero()) {
+		return;
+	}
+	const int nodePosition = model.mesh.findOrReserveNode(nodeId);
+	addNodePosition(nodePosition);
+	entryNodePositions.push_back(nodePosition);
+	entryCsPositions.push_back(csPosition);
+	entryValues.insert(entryValues.end(), {force.x(), force.y(), force.z(), moment.x(), moment.y(), moment.z()});
+	entriesByNodePosition.clear();
+}
+
+VectorialValue BulkNodalForce::sumInGlobalCS(int nodePosition, size_t offset) const {
+	if (entriesByNodePosition.size() != entryNodePositions.size()) {
+		entriesByNodePosition.resize(entryNodePositions.size());
+		for (size_t entry = 0; entry < entriesByNodePosition.size(); ++entry) {
+			entriesByNodePosition[entry] = entry;
+		}
+		stable_sort(entriesByNodePosition.begin(), entriesByNodePosition.end(), [this](size_t a, size_t b) {
+			return entryNodePositions[a] < entryNodePositions[b];
+		});
+	}
+	const auto& first = lower_bound(entriesByNodePosition.begin(), entriesByNodePosition.end(), nodePosition,
+			[this](size_t entry, int position) {return entryNodePositions[entry] < position;});
+	if (first == entriesByNodePosition.end() or entryNodePositions[*first] != nodePosition) {
+		throw logic_error("Requested node has not been assigned to this loading");
+	}
+	VectorialValue sum;
+	for (auto it = first; it != entriesByNodePosition.end() and entryNodePositions[*it] == nodePosition; ++it) {
+		const double* values = &entryValues[6 * *it + offset];
+		VectorialValue value(values[0], values[1], values[2]);
+		const int csPosition = entryCsPositions[*it];
+		if (csPosition != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID) {
+			const auto& coordSystem = model.mesh.getCoordinateSystemByPosition(csPosition);
+			if (coordSystem == nullptr) {
+				throw logic_error("Coordinate system at position " + to_string(csPosition)
+						+ " for nodal force not found.");
+			}
+			const Node& node = model.mesh.findNode(nodePosition);
+			value = coordSystem->vectorToGlobalAt(VectorialValue(node.x, node.y, node.z), value);
+		}
+		sum = (it == first) ? value : sum + value;
+	}
+	return sum;
+}
+
+VectorialValue BulkNodalForce::getForceInGlobalCS(int nodePosition) const {
+	return sumInGlobalCS(nodePosition, 0);
+}
+
+VectorialValue BulkNodalForce::getMomentInGlobalCS(int nodePosition) const {
+	return sumInGlobalCS(nodePosition, 3);
+}
+
+DOFS BulkNodalForce::getDOFSForNode(const int nodePosition) const {
+	DOFS dofs(DOFS::NO_DOFS);
+	if (not containsNodePositionExcludingGroups(nodePosition)) {
+		return dofs;
+	}
+	const VectorialValue& globalForce = getForceInGlobalCS(nodePosition);
+	const VectorialValue& globalTorque = getMomentInGlobalCS(nodePosition);
+	if (!is_zero(globalForce.x()))
+		dofs += DOF::DX;
+	if (!is_zero(globalForce.y()))
+		dofs += DOF::DY;
+	if (!is_zero(globalForce.z()))
+		dofs += DOF::DZ;
+	if (!is_zero(globalTorque.x()))
+		dofs += DOF::RX;
+	if (!is_zero(globalTorque.y()))
+		dofs += DOF::RY;
+	if (!is_zero(globalTorque.z()))
+		dofs += DOF::RZ;
+	return dofs;
+}
+
+unique_ptr<Loading> BulkNodalForce::clone() const {
+	return make_unique<BulkNodalForce>(*this);
+}
+
+void BulkNodalForce::scale(const double factor) {
+	// Each entry is two packed triplets: the force and the moment
+	VectorialValue::scaleTriplets(entryValues.data(), entryValues.size() / 3, factor);
+}
+
+bool BulkNodalForce::ineffective() const {
+	return all_of(entryValues.begin(), entryValues.end(), [](double value) {return is_zero(value);});
+}
+
 CellLoading::CellLoading(Model& model, const std::shared_ptr<LoadSet> loadset, Loading::Type type, int original_id,
 		const Reference<CoordinateSystem> csref) :
 		Loading(model, loadset, type, original_id, csref), CellContainer(model.mesh) {
@@ -563,32 +657,6 @@ bool CellLoading::appliedToGeometry() {
 	return !isForceOnPoutre;
 }
 
-void CellLoading::createSkin() {
-    const auto& faceIds = this->getApplicationFaceNodeIds();
-    if (not faceIds.empty()) {
-        const int cellPosition = model.mesh.generateSkinCell(faceIds, SpaceDimension::DIMENSION_2D);
-
-        // LD : try to solve https://github.com/Alneos/vega/issues/25 but it should be done only for loadings that can be grouped together (i.e. same pressure values, same directions etc)
-        this->clear(); //< To remove the volumic cell and then add the skin at its place
-        const auto& skin = make_shared<Skin>(model, model.modelType);
-        if (model.configuration.alwaysUseGroupsForCells) {
-            shared_ptr<CellGroup> cellGrp = model.mesh.createCellGroup(Cell::MedName(cellPosition), Group::NO_ORIGINAL_ID, "Single cell group over skin element");
-            this->add(*cellGrp);
-            cellGrp->addCellPosition(cellPosition);
-
-            // LD : Workaround for Aster problem : MODELISA6_96
-            //  les 1 mailles imprimées ci-dessus n'appartiennent pas au modèle et pourtant elles ont été affectées dans le mot-clé facteur : !
-            //   ! FORCE_FACE
-
-            skin->add(*cellGrp);
-        } else {
-            skin->addCellPosition(cellPosition);
-            this->addCellPosition(cellPosition);
-        }
-        model.add(skin);
-    }
-}
-
 ForceSurface::ForceSurface(Model& model, const std::shared_ptr<LoadSet> loadset, const VectorialValue& force,
 		const VectorialValue& moment, const int original_id) :
 		CellLoading(model, loadset, Loading::Type::FORCE_SURFACE, original_id,
@@ -603,6 +671,10 @@ VectorialValue ForceSurface::getMoment() const {
 	return moment;
 }
 
+vector<double> ForceSurface::groupingValues() const {
+	return {force.x(), force.y(), force.z(), moment.x(), moment.y(), moment.z()};
+}
+
 DOFS ForceSurface::getDOFSForNode(const int nodePosition) const {
 	DOFS dofs(DOFS::NO_DOFS);
 	const auto& nodes = nodePositions();
@@ -299,6 +299,36 @@ public:
     bool ineffective() const override;
 };
 
+/**
+ * Forces and moments applied on many nodes of a LoadSet, stored column-wise instead of one
+ * NodalForce per input card (see Nastran FORCE, MOMENT). Each entry holds a node position,
+ * a coordinate system position and its six components; the entries of a same node are summed.
+ */
+class BulkNodalForce: public NodalForce {
+	std::vector<int> entryNodePositions;
+	std::vector<int> entryCsPositions;
+	std::vector<double> entryValues; /**< fx, fy, fz, mx, my, mz of each entry */
+	mutable std::vector<size_t> entriesByNodePosition; /**< entry indexes sorted by node position, built on first lookup */
+	VectorialValue sumInGlobalCS(int nodePosition, size_t offset) const;
+public:
+	BulkNodalForce(Model&, const std::shared_ptr<LoadSet> loadset, const int original_id = NO_ORIGINAL_ID);
+	/**
+	 * Add the force and moment of a node, expressed in the coordinate system at csPosition.
+	 * Entries without any non zero component are ignored.
+	 */
+	void addEntry(int nodeId, const VectorialValue& force, const VectorialValue& moment,
+			int csPosition = CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID);
+	size_t entryCount() const noexcept {
+		return entryNodePositions.size();
+	}
+	VectorialValue getForceInGlobalCS(const int nodePosition) const override;
+	VectorialValue getMomentInGlobalCS(const int nodePosition) const override;
+	DOFS getDOFSForNode(int nodePosition) const override;
+	std::unique_ptr<Loading> clone() const override;
+	void scale(const double factor) override;
+	bool ineffective() const override;
+};
+
 /**
  * Represent loading applied on cells
  */
@@ -321,7 +351,14 @@ public:
 	 * geometrical element or to a Poutre.
 	 */
 	bool appliedToGeometry();
-	void createSkin();
+	/**
+	 * Values of the load applied on each cell (intensity, components...): cell loadings of the
+	 * same type, load set and coordinate system with equal values can be applied together on
+	 * all their cells. Empty if the loading can't be grouped.
+	 */
+	virtual std::vector<double> groupingValues() const {
+		return {};
+	}
 };
 
 /**
@@ -337,6 +374,7 @@ public:
 	VectorialValue getForce() const;
 	VectorialValue getMoment() const;
 	DOFS getDOFSForNode(int nodePosition) const override;
+	std::vector<double> groupingValues() const override;
 	std::unique_ptr<Loading> clone() const override;
 	void scale(const double factor) override;
 	bool ineffective() const override;
@@ -399,6 +437,9 @@ public:
 	double intensity; /**< positive in the direction of the normal (Aster convention) */
 	NormalPressionFace(Model&, const std::shared_ptr<LoadSet> loadset, double intensity, const int original_id = NO_ORIGINAL_ID);
 	DOFS getDOFSForNode(const int nodePosition) const override;
+	std::vector<double> groupingValues() const override {
+		return {intensity};
+	}
 	bool validate() const override;
 	SpaceDimension getLoadingDimension() const noexcept override {
 		return SpaceDimension::DIMENSION_2D;
@@ -20,8 +20,10 @@
 #include <boost/geometry/algorithms/comparable_distance.hpp>
 #include "Model.h"
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cfloat>
+#include <functional>
 #include <utility>
 #include <iostream>
 #include <iterator>
@@ -32,6 +34,7 @@
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -46,6 +49,126 @@ NodeData::NodeData(int id, const DOFS& dofs, double x, double y, double z, int c
     id(id), dofs(dofs), x(x), y(y), z(z), cpPos(cpPos), cdPos(cdPos), nodePart(nodePart) {
 }
 
+const int IdIndex::EMPTY_ID;
+const int IdIndex::NOT_FOUND;
+const long long IdIndex::MIN_DENSE_RANGE;
+const long long IdIndex::MAX_HOLES_PER_ID;
+
+size_t IdIndex::slotOf(int id) const noexcept {
+	// Fibonacci hashing, slots.size() is a power of two
+	const size_t mask = slots.size() - 1;
+	size_t slot = static_cast<size_t>(static_cast<unsigned int>(id) * 2654435769u) & mask;
+	while (slots[slot].first != id and slots[slot].first != EMPTY_ID) {
+		slot = (slot + 1) & mask;
+	}
+	return slot;
+}
+
+void IdIndex::insertInSlots(int id, int position) noexcept {
+	auto& slot = slots[slotOf(id)];
+	if (slot.first == EMPTY_ID) {
+		count++;
+	}
+	slot = {id, position};
+}
+
+void IdIndex::switchToHash() {
+	size_t capacity = 16;
+	while (capacity < 2 * (count + 1)) {
+		capacity *= 2;
+	}
+	slots.assign(capacity, {EMPTY_ID, NOT_FOUND});
+	count = 0;
+	for (size_t offset = 0; offset < positions.size(); offset++) {
+		if (positions[offset] != NOT_FOUND) {
+			insertInSlots(static_cast<int>(firstId + static_cast<long long>(offset)), positions[offset]);
+		}
+	}
+	vector<int>().swap(positions);
+	dense = false;
+}
+
+int IdIndex::find(int id) const noexcept {
+	if (dense) {
+		const long long offset = static_cast<long long>(id) - firstId;
+		if (offset < 0 or offset >= static_cast<long long>(positions.size())) {
+			return NOT_FOUND;
+		}
+		return positions[static_cast<size_t>(offset)];
+	}
+	return slots[slotOf(id)].second;
+}
+
+void IdIndex::set(int id, int position) {
+	sortedValid = false;
+	const int newMinimum = count == 0 ? id : min(minimum, id);
+	const int newMaximum = count == 0 ? id : max(maximum, id);
+	if (dense) {
+		const long long range = static_cast<long long>(newMaximum) - newMinimum + 1;
+		if (range > max(MIN_DENSE_RANGE, MAX_HOLES_PER_ID * static_cast<long long>(count + 1))) {
+			switchToHash();
+		} else {
+			if (positions.empty()) {
+				firstId = id;
+			}
+			long long offset = static_cast<long long>(id) - firstId;
+			if (offset < 0) {
+				// Leave some room below, so that decreasing ids don't shift the vector each time
+				const long long shift = min(-offset + static_cast<long long>(positions.size()) / 2,
+						static_cast<long long>(firstId) - INT_MIN);
+				positions.insert(positions.begin(), static_cast<size_t>(shift), NOT_FOUND);
+				firstId = static_cast<int>(firstId - shift);
+				offset = static_cast<long long>(id) - firstId;
+			} else if (offset >= static_cast<long long>(positions.size())) {
+				positions.resize(static_cast<size_t>(offset) + 1, NOT_FOUND);
+			}
+			int& slot = positions[static_cast<size_t>(offset)];
+			if (slot == NOT_FOUND) {
+				count++;
+			}
+			slot = position;
+		}
+	}
+	if (not dense) {
+		if (2 * (count + 1) > slots.size()) {
+			vector<pair<int, int>> previousSlots(slots.size() * 2, {EMPTY_ID, NOT_FOUND});
+			previousSlots.swap(slots);
+			count = 0;
+			for (const auto& slot : previousSlots) {
+				if (slot.first != EMPTY_ID) {
+					insertInSlots(slot.first, slot.second);
+				}
+			}
+		}
+		insertInSlots(id, position);
+	}
+	minimum = newMinimum;
+	maximum = newMaximum;
+}
+
+const vector<pair<int, int>>& IdIndex::sorted() const {
+	if (not sortedValid) {
+		sortedEntries.clear();
+		sortedEntries.reserve(count);
+		if (dense) {
+			for (size_t offset = 0; offset < positions.size(); offset++) {
+				if (positions[offset] != NOT_FOUND) {
+					sortedEntries.push_back({static_cast<int>(firstId + static_cast<long long>(offset)), positions[offset]});
+				}
+			}
+		} else {
+			for (const auto& slot : slots) {
+				if (slot.first != EMPTY_ID) {
+					sortedEntries.push_back(slot);
+				}
+			}
+			sort(sortedEntries.begin(), sortedEntries.end());
+		}
+		sortedValid = true;
+	}
+	return sortedEntries;
+}
+
 /**
  * Node Container class
  */
@@ -58,28 +181,28 @@ NodeStorage::NodeStorage(Mesh& mesh, LogLevel logLevel) :
 }
 
 NodeStorage::NodeIterator NodeStorage::begin() const {
-	return NodeStorage::NodeIterator(*this, nodepositionById.begin());
+	return NodeStorage::NodeIterator(*this, 0);
 }
 
 NodeStorage::NodeIterator NodeStorage::end() const {
-	return NodeStorage::NodeIterator(*this, nodepositionById.end());
+	return NodeStorage::NodeIterator(*this, nodepositionById.size());
 }
 
-NodeStorage::NodeIterator::NodeIterator(const NodeStorage& nodeStorage, mapid_iterator currentIdIterator) :
-		nodeStorage(nodeStorage), currentIdIterator(currentIdIterator) {
+NodeStorage::NodeIterator::NodeIterator(const NodeStorage& nodeStorage, size_t currentIdIndex) :
+		nodeStorage(nodeStorage), currentIdIndex(currentIdIndex) {
 }
 
 void NodeStorage::NodeIterator::increment() {
-	currentIdIterator++;
+	currentIdIndex++;
 }
 
 bool NodeStorage::NodeIterator::hasNext() const {
-	return currentIdIterator != nodeStorage.nodepositionById.end();
+	return currentIdIndex < nodeStorage.nodepositionById.size();
 }
 
 bool NodeStorage::NodeIterator::equal(NodeStorage::NodeIterator const& other) const {
 	//this.mesh == other.mesh
-	return this->currentIdIterator == other.currentIdIterator;
+	return this->currentIdIndex == other.currentIdIndex;
 }
 
 NodeStorage::NodeIterator& NodeStorage::NodeIterator::operator ++() {
@@ -92,19 +215,19 @@ NodeStorage::NodeIterator NodeStorage::NodeIterator::operator ++(int) {
 }
 
 bool NodeStorage::NodeIterator::operator ==(const NodeStorage::NodeIterator& rhs) const {
-	return this->currentIdIterator == rhs.currentIdIterator;
+	return this->currentIdIndex == rhs.currentIdIndex;
 }
 
 bool NodeStorage::NodeIterator::operator !=(const NodeStorage::NodeIterator& rhs) const {
-	return this->currentIdIterator != rhs.currentIdIterator;
+	return this->currentIdIndex != rhs.currentIdIndex;
 }
 
 Node NodeStorage::NodeIterator::operator *() {
-	return nodeStorage.mesh.findNode(this->currentIdIterator->second);
+	return nodeStorage.mesh.findNode(nodeStorage.nodepositionById.sorted()[this->currentIdIndex].second);
 }
 
 Node NodeStorage::NodeIterator::next() {
-	const Node& result(nodeStorage.mesh.findNode(this->currentIdIterator->second));
+	const Node& result(nodeStorage.mesh.findNode(nodeStorage.nodepositionById.sorted()[this->currentIdIndex].second));
 	this->increment();
 	return result;
 }
@@ -157,12 +280,21 @@ CellIterator CellStorage::cells_end(const CellType &type) const {
 vector<CellType> CellStorage::cellTypes() const {
     vector<CellType> keys;
     keys.reserve(nodepositionsByCelltype.size());
-    for (const auto kv : nodepositionsByCelltype) {
-        keys.push_back(kv.first);
+    for (const auto& kv : nodepositionsByCelltype) {
+        // Reserved types may still have no cell
+        if (not kv.second.empty()) {
+            keys.push_back(kv.first);
+        }
     }
 	return keys;
 }
 
+const vector<int>& CellStorage::connectivity(const CellType& type) const {
+    static const vector<int> NO_CONNECTIVITY;
+    const auto it = nodepositionsByCelltype.find(type);
+    return it == nodepositionsByCelltype.end() ? NO_CONNECTIVITY : it->second;
+}
+
 /******************************************************************************
  * Mesh class
  ******************************************************************************/
@@ -189,14 +321,13 @@ int Mesh::addNode(int id, double x, double y, double z, int cpPos, int cdPos, in
 			id = Node::auto_node_id--;
 		}
 	}
-	auto positionIterator = nodes.nodepositionById.find(id);
-	if (positionIterator == nodes.nodepositionById.end()) {
+	nodePosition = nodes.nodepositionById.find(id);
+	if (nodePosition == IdIndex::NOT_FOUND) {
 		nodePosition = static_cast<int>(nodes.nodeDatas.size());
 		NodeData nodeData(id, DOFS::NO_DOFS, x, y, z, cpPos, cdPos, nodePart);
 		nodes.nodeDatas.push_back(nodeData);
-		nodes.nodepositionById[id] = nodePosition;
+		nodes.nodepositionById.set(id, nodePosition);
 	} else {
-		nodePosition = positionIterator->second;
 		NodeData& nodeData = nodes.nodeDatas[nodePosition];
 		nodeData.x = x;
 		nodeData.y = y;
@@ -204,6 +335,7 @@ int Mesh::addNode(int id, double x, double y, double z, int cpPos, int cdPos, in
         nodeData.cpPos = cpPos;
         nodeData.cdPos = cdPos;
 	}
+	nodes.globalCoordinatesValid = false;
 
 	return nodePosition;
 }
@@ -218,6 +350,11 @@ Node Mesh::findNode(const int nodePosition) const {
 				"Node position " + to_string(nodePosition) + " not found.");
 	}
 	const NodeData &nodeData = nodes.nodeDatas[nodePosition];
+	if (nodes.globalCoordinatesValid) {
+      return Node(nodeData.id, nodeData.x, nodeData.y, nodeData.z, nodePosition, nodeData.dofs,
+          nodes.globalXs[nodePosition], nodes.globalYs[nodePosition], nodes.globalZs[nodePosition],
+          nodeData.cpPos, nodeData.cdPos, nodeData.nodePart);
+	}
 	if (nodeData.cpPos == CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID) {
       // Should always be an "unnamed return" to avoid useless copies
       return Node(nodeData.id, nodeData.x, nodeData.y, nodeData.z, nodePosition, nodeData.dofs,
@@ -241,6 +378,77 @@ Node Mesh::findNode(const int nodePosition) const {
 	}
 }
 
+void Mesh::computeGlobalCoordinates() const {
+	const size_t nodeCount = nodes.nodeDatas.size();
+	nodes.globalXs.resize(nodeCount);
+	nodes.globalYs.resize(nodeCount);
+	nodes.globalZs.resize(nodeCount);
+	// Nodes are usually sorted by CS: transform each run of nodes sharing a CS in one batch
+	vector<double> coordinates;
+	for (size_t begin = 0; begin < nodeCount;) {
+		const int cpPos = nodes.nodeDatas[begin].cpPos;
+		size_t end = begin + 1;
+		while (end < nodeCount and nodes.nodeDatas[end].cpPos == cpPos) {
+			end++;
+		}
+		shared_ptr<CoordinateSystem> coordSystem = nullptr;
+		if (cpPos != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID) {
+			coordSystem = this->getCoordinateSystemByPosition(cpPos);
+			if (not coordSystem) {
+				for (size_t i = begin; i < end; ++i) {
+					cerr << "ERROR: Coordinate System of position " << cpPos << " for Node " << nodes.nodeDatas[i].id
+							<< " not found. Global Coordinate System used instead." << endl;
+				}
+			}
+		}
+		if (coordSystem) {
+			coordinates.resize(3 * (end - begin));
+			for (size_t i = begin; i < end; ++i) {
+				const NodeData &nodeData = nodes.nodeDatas[i];
+				coordinates[3 * (i - begin)] = nodeData.x;
+				coordinates[3 * (i - begin) + 1] = nodeData.y;
+				coordinates[3 * (i - begin) + 2] = nodeData.z;
+			}
+			coordSystem->positionsToGlobal(coordinates.data(), coordinates.data(), end - begin);
+			for (size_t i = begin; i < end; ++i) {
+				nodes.globalXs[i] = coordinates[3 * (i - begin)];
+				nodes.globalYs[i] = coordinates[3 * (i - begin) + 1];
+				nodes.globalZs[i] = coordinates[3 * (i - begin) + 2];
+			}
+		} else {
+			for (size_t i = begin; i < end; ++i) {
+				const NodeData &nodeData = nodes.nodeDatas[i];
+				nodes.globalXs[i] = nodeData.x;
+				nodes.globalYs[i] = nodeData.y;
+				nodes.globalZs[i] = nodeData.z;
+			}
+		}
+		begin = end;
+	}
+	nodes.globalCoordinatesValid = true;
+}
+
+const vector<double>& Mesh::getGlobalXs() const {
+	if (not nodes.globalCoordinatesValid) {
+		computeGlobalCoordinates();
+	}
+	return nodes.globalXs;
+}
+
+const vector<double>& Mesh::getGlobalYs() const {
+	if (not nodes.globalCoordinatesValid) {
+		computeGlobalCoordinates();
+	}
+	return nodes.globalYs;
+}
+
+const vector<double>& Mesh::getGlobalZs() const {
+	if (not nodes.globalCoordinatesValid) {
+		computeGlobalCoordinates();
+	}
+	return nodes.globalZs;
+}
+
 int Mesh::findOrReserveNode(int nodeId, int cellPartId) noexcept {
 
     int mainNodePart = 0;
@@ -260,7 +468,6 @@ int Mesh::findOrReserveNode(int nodeId, int cellPartId) noexcept {
 
         nodePosition = addNode(nodeId, NodeStorage::RESERVED_POSITION, NodeStorage::RESERVED_POSITION,
                 NodeStorage::RESERVED_POSITION, CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID, CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID, mainNodePart);
-        nodes.nodepositionById[nodeId] = nodePosition;
         nodes.reservedButUnusedNodePositions.insert(nodePosition);
         if (this->logLevel >= LogLevel::TRACE) {
             cout << "Reserve node id:" << nodeId << " position:" << nodePosition << endl;
@@ -318,11 +525,8 @@ int Mesh::findNodePartId(const int nodePosition) const noexcept {
 }
 
 int Mesh::findNodePosition(const int nodeId) const noexcept {
-	auto positionIterator = this->nodes.nodepositionById.find(nodeId);
-	if (positionIterator == this->nodes.nodepositionById.end()) {
-		return Node::UNAVAILABLE_NODE;
-	}
-	return positionIterator->second;
+	const int nodePosition = this->nodes.nodepositionById.find(nodeId);
+	return nodePosition == IdIndex::NOT_FOUND ? Node::UNAVAILABLE_NODE : nodePosition;
 }
 
 void Mesh::allowDOFS(int nodePosition, const DOFS& allowed) noexcept {
@@ -362,7 +566,7 @@ int Mesh::addCell(int id, const CellType& cellType, const std::vector<int>& node
 					"Duplicate node in connectivity cellId:"
 							+ to_string(cellId));
 		}
-		if (cells.cellpositionById.find(cellId) != cells.cellpositionById.end()) {
+		if (cells.cellpositionById.find(cellId) != IdIndex::NOT_FOUND) {
 			throw logic_error(
 					"CellId: " + to_string(cellId) + " Already used.");
 		}
@@ -374,17 +578,18 @@ int Mesh::addCell(int id, const CellType& cellType, const std::vector<int>& node
         }
 	}
 
-	cells.cellpositionById[cellId] = cellPosition;
+	cells.cellpositionById.set(cellId, cellPosition);
+	if (cellType.dimension == SpaceDimension::DIMENSION_3D) {
+		volumeFaceIndexValid = false;
+	}
+	nodeCellIndexValid = false;
 	const size_t cellTypePosition = cellPositionsByType.find(cellType)->second.size();
 	cellPositionsByType.find(cellType)->second.push_back(cellPosition);
 	CellData cellData(cellId, cellType, virtualCell, elementId, cellTypePosition);
 
-	if (cells.nodepositionsByCelltype.find(cellType) == cells.nodepositionsByCelltype.end()) {
-		cells.nodepositionsByCelltype[cellType] = make_shared<deque<int>>(deque<int>());
-	}
-	const auto& nodePositionsPtr = cells.nodepositionsByCelltype[cellType];
+	vector<int>& connectivity = cells.nodepositionsByCelltype[cellType];
 	for (const auto& nodeId : nodeIds) {
-		nodePositionsPtr->push_back(findOrReserveNode(nodeId, elementId));
+		connectivity.push_back(findOrReserveNode(nodeId, elementId));
 	}
 
     switch (cellType.dimension.code) {
@@ -463,18 +668,19 @@ int Mesh::updateCell(int id, const CellType &cellType, const std::vector<int> &n
     // We build another CellData, with an other cellPosition, and hope
     // for the best
     const int cellPosition = static_cast<int>(cells.cellDatas.size());
-    cells.cellpositionById[id] = cellPosition;
+    cells.cellpositionById.set(id, cellPosition);
+    if (cellType.dimension == SpaceDimension::DIMENSION_3D) {
+        volumeFaceIndexValid = false;
+    }
+    nodeCellIndexValid = false;
 
     const int cellTypePosition = static_cast<int>(cellPositionsByType.find(cellType)->second.size());
     cellPositionsByType.find(cellType)->second.push_back(cellPosition);
     CellData cellData(id, cellType, virtualCell, elementId, cellTypePosition);
 
-    if (cells.nodepositionsByCelltype.find(cellType) == cells.nodepositionsByCelltype.end()) {
-        cells.nodepositionsByCelltype[cellType] = make_shared<deque<int>>(deque<int>());
-    }
-    const auto& nodePositionsPtr = cells.nodepositionsByCelltype[cellType];
+    vector<int>& connectivity = cells.nodepositionsByCelltype[cellType];
 	for (const auto& nodeId : nodeIds) {
-		nodePositionsPtr->push_back(findOrReserveNode(nodeId));
+		connectivity.push_back(findOrReserveNode(nodeId));
 	}
     if (cpos != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID) {
         this->getOrCreateCellGroupForCS(cpos)->addCellId(id);
@@ -495,6 +701,27 @@ int Mesh::updateCell(int id, const CellType &cellType, const std::vector<int> &n
 }
 
 
+CellView Mesh::viewCell(int cellPosition) const {
+	if (cellPosition == Cell::UNAVAILABLE_CELL) {
+		throw logic_error("Unavailable cell requested.");
+	}
+	const auto& cellData = cells.cellDatas[cellPosition];
+	const CellType* cellType = CellType::findByCode(cellData.typeCode);
+	const auto& globalNodePositions = cells.nodepositionsByCelltype.find(*cellType)->second;
+	const int* begin = globalNodePositions.data() + cellData.cellTypePosition * cellType->numNodes;
+	double offset = 0.0;
+	if (cellType->dimension.code == SpaceDimension::Code::DIMENSION2D_CODE) {
+		// updateCell() does not store additional data
+		const auto it = cells.additional2DdataByCelltype.find(*cellType);
+		if (it != cells.additional2DdataByCelltype.end() and cellData.cellTypePosition < it->second.size()) {
+			offset = it->second[cellData.cellTypePosition].offset;
+		}
+	}
+	return CellView(cellData.id, cellPosition, *cellType, cellData.isvirtual, cellData.elementId,
+			cellData.cellTypePosition, cellData.csPos,
+			boost::make_iterator_range(begin, begin + cellType->numNodes), offset);
+}
+
 Cell Mesh::findCell(int cellPosition) const {
 	if (cellPosition == Cell::UNAVAILABLE_CELL) {
 		throw logic_error("Unavailable cell requested.");
@@ -504,8 +731,7 @@ Cell Mesh::findCell(int cellPosition) const {
 	const unsigned int numNodes = cellType->numNodes;
 	vector<int> nodeIds;
 	nodeIds.resize(numNodes);
-	auto it = cells.nodepositionsByCelltype.find(*cellType);
-	const auto& globalNodePositions = *(it->second);
+	const auto& globalNodePositions = cells.nodepositionsByCelltype.find(*cellType)->second;
 	const size_t start = cellData.cellTypePosition * numNodes;
 	vector<int> nodePositions(globalNodePositions.begin() + start,
 			globalNodePositions.begin() + start + numNodes);
@@ -547,6 +773,10 @@ Cell Mesh::findCell(int cellPosition) const {
 }
 
 int Mesh::generateSkinCell(const vector<int>& faceIds, const SpaceDimension& dimension) {
+    const auto& skinCellIt = skinCellPositionByFace.find(faceIds);
+    if (skinCellIt != skinCellPositionByFace.end()) {
+        return skinCellIt->second;
+    }
     CellType* cellTypeFound = nullptr;
     for (const auto& typeAndCodePair : CellType::typeByCode) {
         CellType * typeToTest = typeAndCodePair.second;
@@ -560,27 +790,178 @@ int Mesh::generateSkinCell(const vector<int>& faceIds, const SpaceDimension& dim
                 "CellType not found connections:"
                         + to_string(faceIds.size()));
     }
-    return addCell(Cell::AUTO_ID, *cellTypeFound, faceIds, true);
+    const int cellPosition = addCell(Cell::AUTO_ID, *cellTypeFound, faceIds, true);
+    skinCellPositionByFace[faceIds] = cellPosition;
+    return cellPosition;
+}
+
+Mesh::FaceKey Mesh::faceKey(const int* nodePositions, size_t nodeCount, const vector<int>* faceNodeNums) {
+	// Faces are triangles or quadrangles, their corner nodes come first
+	const size_t cornerCount = (nodeCount == 3 or nodeCount == 6 or nodeCount == 7) ? 3 : 4;
+	FaceKey key{{Node::UNAVAILABLE_NODE, Node::UNAVAILABLE_NODE, Node::UNAVAILABLE_NODE, Node::UNAVAILABLE_NODE}};
+	for (size_t i = 0; i < cornerCount and i < nodeCount; i++) {
+		key[i] = faceNodeNums == nullptr ? nodePositions[i] : nodePositions[(*faceNodeNums)[i] - 1];
+	}
+	sort(key.begin(), key.begin() + static_cast<long>(min(cornerCount, nodeCount)));
+	return key;
+}
+
+void Mesh::buildVolumeFaceIndex() const {
+	using FaceEntry = pair<FaceKey, pair<int, int>>;
+	volumeFaceIndex.clear();
+	for (const auto& cellEntry : this->cellPositionsByType) {
+		const CellType& cellType = cellEntry.first;
+		const vector<int>& cellPositions = cellEntry.second;
+		if (cellType.dimension != SpaceDimension::DIMENSION_3D or cellPositions.empty())
+			continue;
+		const auto& it = Cell::FACE_BY_CELLTYPE.find(cellType.code);
+		if (it == Cell::FACE_BY_CELLTYPE.end())
+			throw logic_error("Missing FACE_BY_CELLTYPE configuration for cell type :" + cellType.description);
+		const vector<vector<int>>& faces = it->second;
+		const int* connectivity = cells.connectivity(cellType).data();
+		const size_t numNodes = cellType.numNodes;
+
+		// Faces of the cells [begin, end) of this type, in cell order
+		auto collectFaces = [&](size_t begin, size_t end, vector<FaceEntry>& entries) {
+			entries.reserve((end - begin) * faces.size());
+			for (size_t i = begin; i < end; i++) {
+				const int* nodePositions = connectivity + i * numNodes;
+				for (size_t faceNum = 0; faceNum < faces.size(); faceNum++) {
+					entries.emplace_back(faceKey(nodePositions, faces[faceNum].size(), &faces[faceNum]),
+							make_pair(cellPositions[i], static_cast<int>(faceNum + 1)));
+				}
+			}
+		};
+		const size_t cellCount = cellPositions.size();
+		const size_t threads = cellCount < PARALLEL_FACE_INDEX_MINIMUM_CELLS ? 1 :
+				max(1u, thread::hardware_concurrency());
+		vector<vector<FaceEntry>> chunks(threads);
+		if (threads == 1) {
+			collectFaces(0, cellCount, chunks[0]);
+		} else {
+			vector<thread> workers;
+			for (size_t t = 0; t < threads; t++) {
+				workers.emplace_back(collectFaces, cellCount * t / threads, cellCount * (t + 1) / threads, ref(chunks[t]));
+			}
+			for (auto& worker : workers) {
+				worker.join();
+			}
+		}
+		volumeFaceIndex.reserve(volumeFaceIndex.size() + cellCount * faces.size());
+		for (const auto& chunk : chunks) {
+			for (const auto& entry : chunk) {
+				// emplace keeps the first cell found for a shared face
+				volumeFaceIndex.emplace(entry.first, entry.second);
+			}
+		}
+	}
+	volumeFaceIndexValid = true;
+}
+
+void Mesh::buildNodeCellIndex() const {
+	const size_t nodeCount = nodes.nodeDatas.size();
+	const size_t cellCount = cells.cellDatas.size();
+	const size_t threads = cellCount < PARALLEL_NODE_CELL_INDEX_MINIMUM_CELLS ? 1 :
+			max(1u, thread::hardware_concurrency());
+	// Runs pass(cellType, cellPositions, connectivity, begin, end) over slices of the cells of each type
+	auto forEachSlice = [&](const function<void(const CellType&, const vector<int>&, const int*, size_t, size_t)>& pass) {
+		for (const auto& cellEntry : this->cellPositionsByType) {
+			const CellType& cellType = cellEntry.first;
+			const vector<int>& cellPositions = cellEntry.second;
+			if (cellType.numNodes == 0 or cellPositions.empty())
+				continue;
+			const int* connectivity = cells.connectivity(cellType).data();
+			const size_t typeCellCount = cellPositions.size();
+			if (threads == 1) {
+				pass(cellType, cellPositions, connectivity, 0, typeCellCount);
+				continue;
+			}
+			vector<thread> workers;
+			for (size_t t = 0; t < threads; t++) {
+				workers.emplace_back(pass, cref(cellType), cref(cellPositions), connectivity,
+						typeCellCount * t / threads, typeCellCount * (t + 1) / threads);
+			}
+			for (auto& worker : workers) {
+				worker.join();
+			}
+		}
+	};
+	// A cell replaced by updateCell() stays in the connectivity, but its id points to the new one
+	auto isCurrent = [this](int cellPosition) {
+		return cells.cellpositionById.find(cells.cellDatas[cellPosition].id) == cellPosition;
+	};
+	// Count the cells of each node, then place them at atomic cursors and sort each row
+	unique_ptr<atomic<size_t>[]> counters(new atomic<size_t>[nodeCount + 1]);
+	for (size_t i = 0; i <= nodeCount; i++) {
+		counters[i] = 0;
+	}
+	forEachSlice([&](const CellType& cellType, const vector<int>& cellPositions, const int* connectivity, size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			if (not isCurrent(cellPositions[i]))
+				continue;
+			for (size_t n = 0; n < cellType.numNodes; n++) {
+				counters[static_cast<size_t>(connectivity[i * cellType.numNodes + n]) + 1]++;
+			}
+		}
+	});
+	nodeCellOffsets.assign(nodeCount + 1, 0);
+	for (size_t i = 1; i <= nodeCount; i++) {
+		nodeCellOffsets[i] = nodeCellOffsets[i - 1] + counters[i];
+		counters[i] = nodeCellOffsets[i - 1];
+	}
+	nodeCellPositions.assign(nodeCellOffsets[nodeCount], int{Cell::UNAVAILABLE_CELL});
+	forEachSlice([&](const CellType& cellType, const vector<int>& cellPositions, const int* connectivity, size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			if (not isCurrent(cellPositions[i]))
+				continue;
+			for (size_t n = 0; n < cellType.numNodes; n++) {
+				nodeCellPositions[counters[static_cast<size_t>(connectivity[i * cellType.numNodes + n]) + 1]++] = cellPositions[i];
+			}
+		}
+	});
+	for (size_t node = 0; node < nodeCount; node++) {
+		sort(nodeCellPositions.begin() + static_cast<ptrdiff_t>(nodeCellOffsets[node]),
+				nodeCellPositions.begin() + static_cast<ptrdiff_t>(nodeCellOffsets[node + 1]));
+	}
+	nodeCellIndexValid = true;
+}
+
+boost::iterator_range<const int*> Mesh::findNodeCellPositions(int nodePosition) const {
+	if (not nodeCellIndexValid) {
+		buildNodeCellIndex();
+	}
+	const size_t node = static_cast<size_t>(nodePosition);
+	if (nodePosition < 0 or node + 1 >= nodeCellOffsets.size()) {
+		return boost::make_iterator_range(nodeCellPositions.data(), nodeCellPositions.data());
+	}
+	return boost::make_iterator_range(nodeCellPositions.data() + nodeCellOffsets[node],
+			nodeCellPositions.data() + nodeCellOffsets[node + 1]);
+}
+
+pair<int, int> Mesh::findVolumeFace(const vector<int>& faceNodePositions) const {
+	if (not volumeFaceIndexValid) {
+		buildVolumeFaceIndex();
+	}
+	int cellPosition = Cell::UNAVAILABLE_CELL;
+	int faceNum = 0;
+	const auto& it = volumeFaceIndex.find(faceKey(faceNodePositions.data(), faceNodePositions.size()));
+	if (it != volumeFaceIndex.end()) {
+		const CellType* cellType = CellType::findByCode(cells.cellDatas[it->second.first].typeCode);
+		// same corners but a linear face against a quadratic one is not a match
+		if (Cell::FACE_BY_CELLTYPE.find(cellType->code)->second[it->second.second - 1].size() == faceNodePositions.size()) {
+			cellPosition = it->second.first;
+			faceNum = it->second.second;
+		}
+	}
+	return {cellPosition, faceNum};
 }
 
 pair<Cell, int> Mesh::volcellAndFaceNum_from_skincell(const Cell& skinCell) const {
-    const set<int> surfOrderedNodeIds(skinCell.nodeIds.begin(), skinCell.nodeIds.end());
-    for (const auto& cellEntry : this->cellPositionsByType) {
-        if (cellEntry.first.dimension != SpaceDimension::DIMENSION_3D)
-            continue;
-        for (const int cellPosition : cellEntry.second) {
-            const Cell& volCell = this->findCell(cellPosition);
-            for (const auto& faceEntry : volCell.nodeIdsByFaceNum()) {
-                const vector<int>& faceNodeIds = faceEntry.second;
-                if (faceNodeIds.size() != surfOrderedNodeIds.size())
-                    continue;
-                const set<int> faceOrderedNodeIds(faceNodeIds.begin(), faceNodeIds.end());
-                if (faceOrderedNodeIds == surfOrderedNodeIds) //< Must be ordered for set comparison
-                    return {volCell, faceEntry.first};
-            }
-        }
-    }
-    throw logic_error("Cannot find volume cell corresponding to surface cell id : " + to_string(skinCell.id));
+	const auto& volumeFace = findVolumeFace(skinCell.nodePositions);
+	if (volumeFace.first == Cell::UNAVAILABLE_CELL) {
+		throw logic_error("Cannot find volume cell corresponding to surface cell id : " + to_string(skinCell.id));
+	}
+	return {this->findCell(volumeFace.first), volumeFace.second};
 }
 
 shared_ptr<CellGroup> Mesh::getOrCreateCellGroupForCS(int cspos){
@@ -608,6 +989,7 @@ void Mesh::add(const CoordinateSystem& coordinateSystem) {
       cout << "Adding " << coordinateSystem << endl;
   }
   coordinateSystemStorage.add(coordinateSystem);
+  nodes.globalCoordinatesValid = false;
 }
 
 shared_ptr<CoordinateSystem> Mesh::findCoordinateSystem(const Reference<CoordinateSystem> csref) const {
@@ -661,6 +1043,12 @@ size_t Mesh::countCells() const noexcept {
 }
 
 void Mesh::finish() noexcept {
+	try {
+		computeGlobalCoordinates();
+	} catch (exception&) {
+		// Leave the cache empty: findNode() will report the faulty coordinate system when used.
+		nodes.globalCoordinatesValid = false;
+	}
 	finished = true;
 
 }
@@ -836,18 +1224,20 @@ size_t Mesh::countCells(const CellType& type) const noexcept {
 	return static_cast<int>(positions.size());
 }
 
+void Mesh::reserveCells(const CellType& type, size_t cellCount) {
+	vector<int>& positions = cellPositionsByType[type];
+	positions.reserve(positions.size() + cellCount);
+	vector<int>& connectivity = cells.nodepositionsByCelltype[type];
+	connectivity.reserve(connectivity.size() + cellCount * type.numNodes);
+}
+
 bool Mesh::hasCell(int cellId) const noexcept {
-	auto positionIterator =
-			cells.cellpositionById.find(cellId);
-	return positionIterator != cells.cellpositionById.end();
+	return cells.cellpositionById.find(cellId) != IdIndex::NOT_FOUND;
 }
 
 int Mesh::findCellPosition(int cellId) const noexcept {
-	auto it = this->cells.cellpositionById.find(cellId);
-	if (it == this->cells.cellpositionById.end()) {
-		return Cell::UNAVAILABLE_CELL;
-	}
-	return it->second;
+	const int cellPosition = this->cells.cellpositionById.find(cellId);
+	return cellPosition == IdIndex::NOT_FOUND ? Cell::UNAVAILABLE_CELL : cellPosition;
 }
 
 bool Mesh::validate() const {
@@ -855,48 +1245,109 @@ bool Mesh::validate() const {
 }
 
 MeshStatistics Mesh::calcStats() {
-    if (stats != nullptr) {
-        return *stats;
-    }
-    stats = make_unique<MeshStatistics>();
-    double minSquareDistance = DBL_MAX;
-    double minSquareDistanceNonZero = DBL_MAX;
-    double maxSquareDistance = 0;
-    double sumSquareDistance = 0;
-    size_t countSquareDistance = 0;
-    for (const CellType& cellType : cells.cellTypes()) {
+    if (stats == nullptr) {
+        stats = make_unique<MeshStatistics>(calcStats(cells.cellTypes()));
+    }
+    return *stats;
+}
+
+MeshStatistics Mesh::calcStats(const vector<CellType>& cellTypes) const {
+    // Partial reduction of squared lengths, merged in a fixed order
+    struct SquareLengths {
+        double min = DBL_MAX;
+        double minNonzero = DBL_MAX;
+        double max = 0;
+        double sumNonzero = 0;
+        size_t count = 0;
+        size_t zeroCount = 0;
+        void add(double squareLength) noexcept {
+            count++;
+            min = std::min(min, squareLength);
+            max = std::max(max, squareLength);
+            if (is_zero(squareLength)) {
+                zeroCount++;
+            } else {
+                minNonzero = std::min(minNonzero, squareLength);
+                sumNonzero += squareLength;
+            }
+        }
+        void merge(const SquareLengths& other) noexcept {
+            count += other.count;
+            zeroCount += other.zeroCount;
+            min = std::min(min, other.min);
+            minNonzero = std::min(minNonzero, other.minNonzero);
+            max = std::max(max, other.max);
+            sumNonzero += other.sumNonzero;
+        }
+    };
+    const vector<double>& xs = getGlobalXs();
+    const vector<double>& ys = getGlobalYs();
+    const vector<double>& zs = getGlobalZs();
+    SquareLengths total;
+    for (const CellType& cellType : cellTypes) {
         if (cellType.numNodes < 2)
             continue;
-        vector<double> squareDistances;
-        squareDistances.reserve(cellType.numNodes * (cellType.numNodes - 1) / 2);
-        for (auto cellit = cells.cells_begin(cellType); cellit != cells.cells_end(cellType); cellit++) {
-            const Cell& cell = *cellit;
-            for (unsigned i = 0; i < cellType.numNodes - 1; i++) {
-                for (unsigned j = i; j < cellType.numNodes; j++) {
-                    const Node& n1 = findNode(cell.nodePositions[i]);
-                    const Node& n2 = findNode(cell.nodePositions[j]);
-                    squareDistances.push_back(boost::geometry::comparable_distance(n1, n2));
-                    //squareDistances.push_back(n1.square_distance(n2));
+        const auto& cellPositionsIt = cellPositionsByType.find(cellType);
+        if (cellPositionsIt == cellPositionsByType.end() or cellPositionsIt->second.empty())
+            continue;
+        const size_t numNodes = cellType.numNodes;
+        vector<pair<int, int>> edges;
+        const auto& edgesIt = Cell::EDGES_BY_CELLTYPE.find(cellType.code);
+        if (edgesIt != Cell::EDGES_BY_CELLTYPE.end()) {
+            edges = edgesIt->second;
+        } else {
+            for (int i = 0; i < static_cast<int>(numNodes) - 1; i++) {
+                for (int j = i + 1; j < static_cast<int>(numNodes); j++) {
+                    edges.push_back({i, j});
                 }
             }
         }
-        const auto mm = minmax_element(squareDistances.begin(), squareDistances.end());
-        if (minSquareDistance > 0)
-            minSquareDistance = min(minSquareDistance, *(mm.first));
-        maxSquareDistance = max(maxSquareDistance, *(mm.second));
-        squareDistances.erase(remove_if(squareDistances.begin(), squareDistances.end(), [](double x){return is_zero(x);}), squareDistances.end());
-        const auto mmnz = min_element(squareDistances.begin(), squareDistances.end());
-        double sum = accumulate( squareDistances.begin(), squareDistances.end(), 0.0);
-        minSquareDistanceNonZero = min(minSquareDistanceNonZero, *mmnz);
-        sumSquareDistance += sum;
-        countSquareDistance += squareDistances.size();
-        squareDistances.clear();
-    }
-    stats->minLength = sqrt(minSquareDistance);
-    stats->minNonzeroLength = sqrt(minSquareDistanceNonZero);
-    stats->maxLength = sqrt(maxSquareDistance);
-    stats->quadraticMeanLength = sqrt(sumSquareDistance / static_cast<double>(countSquareDistance));
-    return *stats;
+        const int* connectivity = cells.connectivity(cellType).data();
+        auto reduce = [&](size_t begin, size_t end, SquareLengths& result) {
+            for (size_t i = begin; i < end; i++) {
+                const int* nodePositions = connectivity + i * numNodes;
+                for (const auto& edge : edges) {
+                    const size_t n1 = static_cast<size_t>(nodePositions[edge.first]);
+                    const size_t n2 = static_cast<size_t>(nodePositions[edge.second]);
+                    const double dx = xs[n2] - xs[n1];
+                    const double dy = ys[n2] - ys[n1];
+                    const double dz = zs[n2] - zs[n1];
+                    result.add(dx * dx + dy * dy + dz * dz);
+                }
+            }
+        };
+        const size_t cellCount = cellPositionsIt->second.size();
+        const size_t threads = cellCount < PARALLEL_STATISTICS_MINIMUM_CELLS ? 1 :
+                max(1u, thread::hardware_concurrency());
+        vector<SquareLengths> partials(threads);
+        if (threads == 1) {
+            reduce(0, cellCount, partials[0]);
+        } else {
+            vector<thread> workers;
+            for (size_t t = 0; t < threads; t++) {
+                workers.emplace_back(reduce, cellCount * t / threads, cellCount * (t + 1) / threads, ref(partials[t]));
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+        for (const auto& partial : partials) {
+            total.merge(partial);
+        }
+    }
+    MeshStatistics result;
+    result.edgeCount = total.count;
+    result.zeroLengthEdgeCount = total.zeroCount;
+    if (total.count > 0) {
+        result.minLength = sqrt(total.min);
+        result.maxLength = sqrt(total.max);
+    }
+    const size_t nonzeroCount = total.count - total.zeroCount;
+    if (nonzeroCount > 0) {
+        result.minNonzeroLength = sqrt(total.minNonzero);
+        result.quadraticMeanLength = sqrt(total.sumNonzero / static_cast<double>(nonzeroCount));
+    }
+    return result;
 }
 
 } /* namespace vega */
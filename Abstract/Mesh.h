@@ -12,9 +12,12 @@
 #define MESH_H_
 
 #include <array>
+#include <climits>
 #include <string>
 #include <stdexcept>
+#include <unordered_map>
 #include <boost/range.hpp>
+#include <boost/functional/hash.hpp>
 #include "BoundaryCondition.h"
 #include "MeshComponents.h"
 #include "ConfigurationParameters.h"
@@ -27,6 +30,49 @@ namespace vega {
 
 class Mesh;
 
+/**
+ * Index from the input ids (node or cell numbers) to the Vega positions.
+ * While the ids are dense they are kept in a vector indexed by id - minId(), once they become
+ * too sparse they are moved to an open-addressing hash table. Ids are never removed.
+ */
+class IdIndex final {
+private:
+	static const int EMPTY_ID = INT_MIN; /**< Marks a free hash slot, never a valid id **/
+	static const long long MIN_DENSE_RANGE = 1024;
+	static const long long MAX_HOLES_PER_ID = 3; /**< Sparser ranges go to the hash table **/
+	bool dense = true;
+	size_t count = 0;
+	int minimum = 0;
+	int maximum = 0;
+	int firstId = 0; /**< Id of positions[0] in dense mode **/
+	std::vector<int> positions; /**< Dense mode: position by id - firstId, NOT_FOUND for holes **/
+	std::vector<std::pair<int, int>> slots; /**< Hash mode: (id, position), EMPTY_ID when free **/
+	mutable std::vector<std::pair<int, int>> sortedEntries;
+	mutable bool sortedValid = true;
+	size_t slotOf(int id) const noexcept;
+	void insertInSlots(int id, int position) noexcept;
+	void switchToHash();
+public:
+	static const int NOT_FOUND = INT_MIN;
+	/**
+	 * @return the position of the id, NOT_FOUND if it is not indexed.
+	 */
+	int find(int id) const noexcept;
+	/**
+	 * Index an id, replacing its previous position if any.
+	 */
+	void set(int id, int position);
+	inline size_t size() const noexcept {return count;};
+	inline bool isDense() const noexcept {return dense;};
+	inline int minId() const noexcept {return count == 0 ? NOT_FOUND : minimum;};
+	inline int maxId() const noexcept {return count == 0 ? NOT_FOUND : maximum;};
+	/**
+	 * The (id, position) pairs in increasing id order. Rebuilt on demand after a modification:
+	 * the reference is invalidated by the next set().
+	 */
+	const std::vector<std::pair<int, int>>& sorted() const;
+};
+
 class NodeData final {
 public:
     NodeData(int id, const DOFS& dofs, double x, double y, double z, int cpPos, int cdPos, int nodePart);
@@ -46,8 +92,15 @@ private:
 	friend NodeGroup;
 	const LogLevel logLevel;
 	std::vector<NodeData> nodeDatas;
-	using mapid_iterator = std::map<int, int>::const_iterator;
-	std::map<int, int> nodepositionById;
+	IdIndex nodepositionById;
+	/**
+	 * Global coordinates by node position, stored as separate arrays (x, y, z).
+	 * Filled by Mesh::computeGlobalCoordinates(), reset when a node or a coordinate system changes.
+	 */
+	mutable std::vector<double> globalXs;
+	mutable std::vector<double> globalYs;
+	mutable std::vector<double> globalZs;
+	mutable bool globalCoordinatesValid = false;
 	static const double RESERVED_POSITION;
 	static int lastNodePart;
 public:
@@ -61,9 +114,9 @@ public:
         friend NodeStorage;
         void increment();
         bool equal(NodeIterator const& other) const;
-        NodeIterator(const NodeStorage& nodeStorage, mapid_iterator currentIdIterator);
+        NodeIterator(const NodeStorage& nodeStorage, size_t currentIdIndex);
         const NodeStorage& nodeStorage;
-        mapid_iterator currentIdIterator;
+        size_t currentIdIndex; /**< Index in nodepositionById.sorted() **/
     public:
         //java style iteration
         bool hasNext() const;
@@ -82,10 +135,10 @@ public:
 	    return nodeDatas;
 	}
 	int getMinNodeId() const {
-	    return nodepositionById.begin()->first;
+	    return nodepositionById.minId();
 	}
 	int getMaxNodeId() const {
-	    return nodepositionById.rbegin()->first;
+	    return nodepositionById.maxId();
 	}
 	bool validate() const;
 };
@@ -113,8 +166,12 @@ private:
 	std::map<CellType, std::vector<DimensionData1D>> additional1DdataByCelltype;
 	std::map<CellType, std::vector<DimensionData2D>> additional2DdataByCelltype;
 	std::map<CellType, std::vector<DimensionData3D>> additional3DdataByCelltype;
-	std::map<int, int> cellpositionById;
-	std::map<CellType, std::shared_ptr<std::deque<int>>> nodepositionsByCelltype;
+	IdIndex cellpositionById;
+	/**
+	 * Connectivity by cell type: the node positions of all the cells of a type, stored
+	 * contiguously. The cell of cell type position i starts at i * type.numNodes.
+	 */
+	std::map<CellType, std::vector<int>> nodepositionsByCelltype;
 	/*
 	 * Reserve a cell position given an id
 	 */
@@ -125,16 +182,27 @@ public:
 	CellIterator cells_begin(const CellType &type) const;
 	CellIterator cells_end(const CellType &type) const;
 	std::vector<CellType> cellTypes() const;
+	/**
+	 * Node positions of all the cells of a type, in cell type position order (the order of
+	 * Mesh::cellPositionsByType), numNodes positions per cell. Empty if no cell of this type exists.
+	 */
+	const std::vector<int>& connectivity(const CellType& type) const;
 
 	bool validate() const;
 };
 
+/**
+ * Lengths of the cell edges (all node pairs for cell types without known edges). An edge shared
+ * by several cells is counted once per cell. The mean only accounts for nonzero lengths.
+ */
 class MeshStatistics final {
 public:
-    double minLength;
-    double minNonzeroLength;
-    double maxLength;
-    double quadraticMeanLength;
+    double minLength = 0;
+    double minNonzeroLength = 0;
+    double maxLength = 0;
+    double quadraticMeanLength = 0;
+    size_t edgeCount = 0;
+    size_t zeroLengthEdgeCount = 0; /**< Edges between coincident nodes */
 };
 
 class Mesh final {
@@ -159,6 +227,45 @@ private:
 	std::shared_ptr<CellGroup> getOrCreateCellGroupForCS(const int cspos);
 
 	std::unique_ptr<MeshStatistics> stats = nullptr;
+
+	/**
+	 * Sorted corner node positions of a face, Node::UNAVAILABLE_NODE last for a triangle.
+	 */
+	using FaceKey = std::array<int, 4>;
+	struct FaceKeyHash {
+		size_t operator()(const FaceKey& key) const noexcept {
+			return boost::hash_range(key.begin(), key.end());
+		}
+	};
+	/**
+	 * Faces of the 3D cells: (volume cell position, face number) by corner nodes, first cell
+	 * in cellPositionsByType order for a face shared by two cells. Built on first use,
+	 * invalidated when a 3D cell is added.
+	 */
+	mutable std::unordered_map<FaceKey, std::pair<int, int>, FaceKeyHash> volumeFaceIndex;
+	mutable bool volumeFaceIndexValid = false;
+	static const size_t PARALLEL_FACE_INDEX_MINIMUM_CELLS = 100000;
+	static const size_t PARALLEL_STATISTICS_MINIMUM_CELLS = 100000;
+	/**
+	 * Inverse connectivity in compressed rows: the positions of the cells using the node at
+	 * position n are nodeCellPositions[nodeCellOffsets[n]..nodeCellOffsets[n+1]], sorted.
+	 * Built on first use, invalidated when a cell is added or updated.
+	 */
+	mutable std::vector<size_t> nodeCellOffsets;
+	mutable std::vector<int> nodeCellPositions;
+	mutable bool nodeCellIndexValid = false;
+	static const size_t PARALLEL_NODE_CELL_INDEX_MINIMUM_CELLS = 100000;
+	void buildNodeCellIndex() const;
+	/**
+	 * Key of a face with nodeCount nodes, corners first. Nodes are read from nodePositions
+	 * at the (1 based) indexes faceNodeNums if given, else in order.
+	 */
+	static FaceKey faceKey(const int* nodePositions, size_t nodeCount, const std::vector<int>* faceNodeNums = nullptr);
+	void buildVolumeFaceIndex() const;
+	/**
+	 * Cells created by generateSkinCell(), by face node ids (in face order)
+	 */
+	std::unordered_map<std::vector<int>, int, boost::hash<std::vector<int>>> skinCellPositionByFace;
 public:
 	std::map<CellType, std::vector<int>> cellPositionsByType;
 	std::map<int, std::string> cellGroupNameByCspos; /**< mapping position->group name **/
@@ -224,6 +331,13 @@ public:
 	 * throws invalid_argument if node not found
 	 */
 	Node findNode(const int nodePosition) const;
+	/**
+	 * Global coordinates of all nodes, indexed by node position. Computed on first use
+	 * (and by finish()), invalidated by addNode() and by adding a coordinate system.
+	 */
+	const std::vector<double>& getGlobalXs() const;
+	const std::vector<double>& getGlobalYs() const;
+	const std::vector<double>& getGlobalZs() const;
 
   /**
 	 * given an internal node position returns the Id from the model
@@ -249,6 +363,10 @@ public:
 
 	size_t countCells() const noexcept;
 	size_t countCells(const CellType &type) const noexcept;
+	/**
+	 * Reserve room for cellCount more cells of a type, typically after counting the cards of an input file.
+	 */
+	void reserveCells(const CellType &type, size_t cellCount);
 	/** Add a cell to the mesh.
 	 *  The vector nodesIds regroups the nodes use to build the cell. Nodes Ids are expressed as "input node number"
 	 *  and will be added to the model if not already defined.
@@ -273,10 +391,37 @@ public:
     int findCellPosition(int cellId) const noexcept;
     inline int findCellId(int cellPosition) const noexcept {
         return cells.cellDatas[cellPosition].id;
+    };
+    /**
+     * Type code of a cell and its position among the cells of this type: enough to address
+     * per-type arrays (connectivity, families) without building a CellView.
+     */
+    inline std::pair<CellType::Code, size_t> findCellTypePosition(int cellPosition) const noexcept {
+        const CellData& cellData = cells.cellDatas[cellPosition];
+        return {cellData.typeCode, cellData.cellTypePosition};
     };
 	Cell findCell(int cellPosition) const;
+	/**
+	 * Find a cell from its Vega position, without copying its connectivity.
+	 * Prefer it to findCell() when only the type, ids or node positions are needed.
+	 */
+	CellView viewCell(int cellPosition) const;
+	/**
+	 * Create a virtual cell over a face, given its node ids. A face already generated
+	 * with the same nodes in the same order gives back the same cell.
+	 */
 	int generateSkinCell(const std::vector<int>& faceIds, const SpaceDimension& dimension);
     std::pair<Cell, int> volcellAndFaceNum_from_skincell(const Cell& skinCell) const;
+	/**
+	 * Find the 3D cell having a face on these node positions (corners first, in any order).
+	 * Returns the volume cell position and the face number (1 based, as in nodeIdsByFaceNum()),
+	 * or {Cell::UNAVAILABLE_CELL, 0} if no volume cell has this face.
+	 */
+	std::pair<int, int> findVolumeFace(const std::vector<int>& faceNodePositions) const;
+	/**
+	 * Positions of the cells using a node (cells replaced by updateCell() excluded), sorted.
+	 */
+	boost::iterator_range<const int*> findNodeCellPositions(int nodePosition) const;
 	bool hasCell(int cellId) const noexcept;
 
 	/**
@@ -287,8 +432,20 @@ public:
 	    cells.cellDatas[cellPosition].elementId = elementId;
     }
 
+	/**
+	 * Statistics of all the cells, computed once.
+	 */
 	MeshStatistics calcStats();
+	/**
+	 * Statistics of the cells of some types, from the global coordinates of their nodes.
+	 */
+	MeshStatistics calcStats(const std::vector<CellType>& cellTypes) const;
 
+	/**
+	 * Resolve the location of every node to the global coordinate system, once for all
+	 * readers of findNode() and of the getGlobal*() arrays.
+	 */
+	void computeGlobalCoordinates() const;
 	void finish() noexcept;
 	bool validate() const;
 	Mesh(const Mesh& that) = delete;
@@ -421,6 +421,37 @@ const unordered_map<CellType::Code, vector<int>, EnumClassHash > Cell::CORNERNOD
     {CellType::HEXA20.code, {0, 1, 2, 3, 4, 5, 6, 7}},
 };
 
+// http://www.code-aster.org/outils/med/html/connectivites.html
+const unordered_map<CellType::Code, vector<pair<int, int>>, EnumClassHash > Cell::EDGES_BY_CELLTYPE = [](){
+    const vector<pair<int, int>> seg = {{0, 1}};
+    const vector<pair<int, int>> tri = {{0, 1}, {1, 2}, {2, 0}};
+    const vector<pair<int, int>> quad = {{0, 1}, {1, 2}, {2, 3}, {3, 0}};
+    const vector<pair<int, int>> tetra = {{0, 1}, {1, 2}, {2, 0}, {0, 3}, {1, 3}, {2, 3}};
+    const vector<pair<int, int>> pyra = {{0, 1}, {1, 2}, {2, 3}, {3, 0}, {0, 4}, {1, 4}, {2, 4}, {3, 4}};
+    const vector<pair<int, int>> penta = {{0, 1}, {1, 2}, {2, 0}, {3, 4}, {4, 5}, {5, 3}, {0, 3}, {1, 4}, {2, 5}};
+    const vector<pair<int, int>> hexa = {{0, 1}, {1, 2}, {2, 3}, {3, 0}, {4, 5}, {5, 6}, {6, 7}, {7, 4},
+        {0, 4}, {1, 5}, {2, 6}, {3, 7}};
+    return unordered_map<CellType::Code, vector<pair<int, int>>, EnumClassHash > {
+        {CellType::SEG2.code, seg},
+        {CellType::SEG3.code, seg},
+        {CellType::TRI3.code, tri},
+        {CellType::TRI6.code, tri},
+        {CellType::TRI7.code, tri},
+        {CellType::QUAD4.code, quad},
+        {CellType::QUAD8.code, quad},
+        {CellType::QUAD9.code, quad},
+        {CellType::TETRA4.code, tetra},
+        {CellType::TETRA10.code, tetra},
+        {CellType::PYRA5.code, pyra},
+        {CellType::PYRA13.code, pyra},
+        {CellType::PENTA6.code, penta},
+        {CellType::PENTA15.code, penta},
+        {CellType::HEXA8.code, hexa},
+        {CellType::HEXA20.code, hexa},
+        {CellType::HEXA27.code, hexa},
+    };
+}();
+
 Cell::Cell(int id, const CellType &type, const std::vector<int> &nodeIds, int position,
 		const std::vector<int> &nodePositions, bool isvirtual,
 		int cspos, int element_id, size_t cellTypePosition,
@@ -431,6 +462,13 @@ Cell::Cell(int id, const CellType &type, const std::vector<int> &nodeIds, int po
                 offset(offset) {
 }
 
+CellView::CellView(int id, int position, const CellType& type, bool isvirtual, int elementId,
+		size_t cellTypePosition, int cspos,
+		boost::iterator_range<const int*> nodePositions, double offset) noexcept :
+		id(id), position(position), type(type), isvirtual(isvirtual), elementId(elementId),
+				cellTypePosition(cellTypePosition), cspos(cspos), nodePositions(nodePositions), offset(offset) {
+}
+
 int Cell::findNodeIdPosition(int node_id2) const {
 	//|| cellType == CellType::TETRA10
 	size_t node2connectivityPos = 0;
@@ -617,6 +655,16 @@ Cell CellIterator::next() {
 	return result;
 }
 
+CellView CellIterator::nextView() {
+	CellView result = view();
+	increment(1);
+	return result;
+}
+
+CellView CellIterator::view() const {
+	return cellStorage->mesh.viewCell(cellStorage->mesh.cellPositionsByType.find(cellType)->second[position]);
+}
+
 void CellIterator::increment(size_t i) {
 	position += i;
 	//cout << "currentPos " << position << "end " << endPosition << endl;
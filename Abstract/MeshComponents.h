@@ -28,6 +28,7 @@
 #include "Dof.h"
 #include <boost/functional/hash.hpp>
 #include <boost/geometry/geometries/geometries.hpp>
+#include <boost/range/iterator_range.hpp>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -309,6 +310,20 @@ public:
 //        }
         return nodePosition == Node::UNAVAILABLE_NODE ? "UNAVAIL" : "N" + std::to_string(nodePosition + 1);
     }
+    /**
+     * Write MedName(nodePosition) to out, without building a string.
+     */
+    inline static void writeMedName(std::ostream& out, const int nodePosition) {
+        if (nodePosition == Node::UNAVAILABLE_NODE) {
+            out << "UNAVAIL";
+            return;
+        }
+        char buffer[24];
+        char* const end = buffer + sizeof(buffer);
+        char* begin = formatDecimal(nodePosition + 1LL, end);
+        *--begin = 'N';
+        out.write(begin, end - begin);
+    }
     double square_distance(const Node& other) const noexcept;
     double distance(const Node& other) const noexcept;
 
@@ -339,6 +354,10 @@ private:
      * Corner node ids
      */
     static const std::unordered_map<CellType::Code, std::vector<int>, EnumClassHash > CORNERNODEIDS_BY_CELLTYPE;
+    /**
+     * Edges between corner nodes, as pairs of node indexes in the cell
+     */
+    static const std::unordered_map<CellType::Code, std::vector<std::pair<int, int>>, EnumClassHash > EDGES_BY_CELLTYPE;
     static std::unordered_map<CellType::Code, std::vector<std::vector<int>>, EnumClassHash > init_faceByCelltype() noexcept;
     static int auto_cell_id;
     Cell(int id, const CellType &type, const std::vector<int> &nodeIds, int position, const std::vector<int> &nodePositions, bool isvirtual,
@@ -391,6 +410,16 @@ public:
     inline static const std::string MedName(const int position) noexcept {
         return "M" + std::to_string(position + 1);
     }
+    /**
+     * Write MedName(position) to out, without building a string.
+     */
+    inline static void writeMedName(std::ostream& out, const int position) {
+        char buffer[24];
+        char* const end = buffer + sizeof(buffer);
+        char* begin = formatDecimal(position + 1LL, end);
+        *--begin = 'M';
+        out.write(begin, end - begin);
+    }
 
     inline bool operator<(const Cell& other) const noexcept {
         return this->position < other.position;
@@ -403,6 +432,35 @@ public:
     }
 };
 
+/**
+ * Lightweight, non-owning view on a cell of a CellStorage. Unlike Cell, building it does not
+ * allocate: node positions are read in place from the connectivity of the cell type.
+ * Only valid until the next cell is added to or updated in the mesh.
+ */
+class CellView final {
+    friend Mesh;
+    CellView(int id, int position, const CellType& type, bool isvirtual, int elementId,
+            size_t cellTypePosition, int cspos,
+            boost::iterator_range<const int*> nodePositions, double offset) noexcept;
+public:
+    int id;
+    int position;
+    const CellType& type;
+    bool isvirtual;
+    int elementId;
+    size_t cellTypePosition;
+    int cspos; /**< Id of local Coordinate System **/
+    /** Node positions of the cell, in the connectivity order of its type **/
+    boost::iterator_range<const int*> nodePositions;
+    double offset; /**< Offset of 2D cells, 0 otherwise **/
+    inline bool hasOrientation() const noexcept {
+        return cspos != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID;
+    }
+    inline unsigned int nodeCount() const noexcept {
+        return static_cast<unsigned int>(nodePositions.size());
+    }
+};
+
 class CellIterator final: public std::iterator<std::input_iterator_tag, const Cell> {
     friend CellStorage;
     const CellStorage* cellStorage;
@@ -421,6 +479,13 @@ public:
     virtual ~CellIterator() = default;
     bool hasNext() const noexcept;
     Cell next();
+    /**
+     * Java style iteration without building a Cell: only the data stored in the mesh is
+     * exposed, see CellView.
+     */
+    CellView nextView();
+    /** Current cell as a CellView **/
+    CellView view() const;
     CellIterator& operator++();
     CellIterator operator++(int); // argument must be int and must be ignored
     bool operator==(const CellIterator& rhs) const noexcept;
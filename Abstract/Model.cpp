@@ -14,6 +14,9 @@
 #include <string>
 #include <fstream>
 #include <ciso646>
+#include <tuple>
+#include <unordered_map>
+#include <algorithm>
 
 using namespace std;
 
@@ -197,6 +200,7 @@ void Model::remove(const Reference<Constraint> constraintReference) {
 }
 
 void Model::remove(const Reference<Constraint> refC, const Reference<ConstraintSet> refCSet) {
+    constraintMembership.clear();
 
     const auto & cR = constraintReferences_by_constraintSet_ids[refCSet.id];
     for (const auto& it2 : cR) {
@@ -377,6 +381,7 @@ shared_ptr<Target> Model::find(const Reference<Target> reference) const {
 
 void Model::addLoadingIntoLoadSet(const Reference<Loading>& loadingReference,
         const Reference<LoadSet>& loadSetReference) {
+    loadingMembership.clear();
     if (loadSetReference.has_id())
         loadingReferences_by_loadSet_ids[loadSetReference.id].insert(loadingReference);
     if (loadSetReference.has_original_id())
@@ -392,6 +397,7 @@ void Model::addLoadingIntoLoadSet(const Reference<Loading>& loadingReference,
 
 void Model::addObjectiveIntoObjectiveSet(const Reference<Objective>& objectiveReference,
         const Reference<ObjectiveSet>& objectiveSetReference) {
+    objectiveMembership.clear();
     if (objectiveReference.has_id())
         objectiveReferences_by_objectiveSet_ids[objectiveSetReference.id].insert(objectiveReference);
     if (objectiveReference.has_original_id())
@@ -429,38 +435,72 @@ shared_ptr<ObjectiveSet> Model::getOrCreateObjectiveSet(int objectiveset_id, Obj
     return objectiveSetPtr;
 }
 
-set<shared_ptr<Loading>, ptrLess<Loading>> Model::getLoadingsByLoadSet(
-        const Reference<LoadSet>& loadSetReference) const {
-    set<shared_ptr<Loading>, ptrLess<Loading>> result;
-    auto itm = loadingReferences_by_loadSet_ids.find(loadSetReference.id);
-    if (itm != loadingReferences_by_loadSet_ids.end()) {
-        for (const auto& itm2 : itm->second) {
-            const auto& loading = find(itm2);
-            if (loading == nullptr) {
-                throw logic_error("Missing loading declared in loadingSet : " + to_str(itm2));
-            }
-            result.insert(loading);
-        }
+template<class S, class T, class ById, class ByOriginalId>
+size_t Model::resolveMembership(MembershipIndex<S, T>& index, const Reference<S>& setReference,
+        const ById& byIds, const ByOriginalId& byOriginalIds) const {
+    const auto& key = make_tuple(setReference.id, setReference.type, setReference.original_id);
+    const auto& rowIt = index.rowBySet.find(key);
+    if (rowIt != index.rowBySet.end()) {
+        return rowIt->second;
     }
-    auto itm2 = loadingReferences_by_loadSet_original_ids_by_loadSet_type.find(
-            loadSetReference.type);
-    if (itm2 != loadingReferences_by_loadSet_original_ids_by_loadSet_type.end()) {
-        auto itm3 = itm2->second.find(loadSetReference.original_id);
+    vector<Reference<T>> references;
+    const auto& itm = byIds.find(setReference.id);
+    if (itm != byIds.end()) {
+        references.insert(references.end(), itm->second.begin(), itm->second.end());
+    }
+    const auto& itm2 = byOriginalIds.find(setReference.type);
+    if (itm2 != byOriginalIds.end()) {
+        const auto& itm3 = itm2->second.find(setReference.original_id);
         if (itm3 != itm2->second.end()) {
-            for (const auto& itm4 : itm3->second) {
-                shared_ptr<Loading> loading = find(itm4);
-            if (loading == nullptr) {
-                throw logic_error("Missing loading declared in loadingSet : " + to_str(itm4));
-            }
-                result.insert(loading);
-            }
+            references.insert(references.end(), itm3->second.begin(), itm3->second.end());
+        }
+    }
+    // A membership is usually recorded both by set id and by set original id
+    sort(references.begin(), references.end());
+    references.erase(unique(references.begin(), references.end()), references.end());
+    vector<shared_ptr<T>> members;
+    members.reserve(references.size());
+    bool complete = true;
+    for (const auto& reference : references) {
+        const auto& member = find(reference);
+        if (member == nullptr) {
+            // Loadings throw on incomplete rows, constraints and objectives are only reported
+            cerr << "Missing " << reference << " declared in " << setReference << endl;
+            complete = false;
+        } else {
+            members.push_back(member);
         }
     }
-    return result;
+    // Same ordering and unicity as the ptrLess sets handed out by the getters
+    sort(members.begin(), members.end(), ptrLess<T>());
+    members.erase(unique(members.begin(), members.end(), [](const shared_ptr<T>& a, const shared_ptr<T>& b) {
+        return not ptrLess<T>()(a, b) and not ptrLess<T>()(b, a);
+    }), members.end());
+    const size_t row = index.rows.size();
+    index.rows.push_back(move(members));
+    index.rowIsComplete.push_back(complete);
+    index.rowBySet[key] = row;
+    return row;
+}
+
+const vector<shared_ptr<Loading>>& Model::getResolvedLoadings(const Reference<LoadSet>& loadSetReference) const {
+    const size_t row = resolveMembership(loadingMembership, loadSetReference,
+            loadingReferences_by_loadSet_ids, loadingReferences_by_loadSet_original_ids_by_loadSet_type);
+    if (not loadingMembership.rowIsComplete[row]) {
+        throw logic_error("Missing loading declared in loadingSet : " + to_str(loadSetReference));
+    }
+    return loadingMembership.rows[row];
+}
+
+set<shared_ptr<Loading>, ptrLess<Loading>> Model::getLoadingsByLoadSet(
+        const Reference<LoadSet>& loadSetReference) const {
+    const auto& loadings = getResolvedLoadings(loadSetReference);
+    return set<shared_ptr<Loading>, ptrLess<Loading>>(loadings.begin(), loadings.end());
 }
 
 void Model::addConstraintIntoConstraintSet(const Reference<Constraint>& constraintReference,
         const Reference<ConstraintSet>& constraintSetReference) {
+    constraintMembership.clear();
     if (constraintSetReference.has_id())
         constraintReferences_by_constraintSet_ids[constraintSetReference.id].insert(
                 constraintReference);
@@ -472,70 +512,60 @@ void Model::addConstraintIntoConstraintSet(const Reference<Constraint>& constrai
         add(commonConstraintSet); // commonConstraintSet is added to the model if needed
 }
 
+const vector<shared_ptr<Constraint>>& Model::getResolvedConstraints(
+        const Reference<ConstraintSet>& constraintSetReference) const {
+    const size_t row = resolveMembership(constraintMembership, constraintSetReference,
+            constraintReferences_by_constraintSet_ids,
+            constraintReferences_by_constraintSet_original_ids_by_constraintSet_type);
+    return constraintMembership.rows[row];
+}
+
 set<shared_ptr<Constraint>, ptrLess<Constraint>> Model::getConstraintsByConstraintSet(
         const Reference<ConstraintSet>& constraintSetReference) const {
-    set<shared_ptr<Constraint>, ptrLess<Constraint>> result;
-    auto itm = constraintReferences_by_constraintSet_ids.find(constraintSetReference.id);
-    if (itm != constraintReferences_by_constraintSet_ids.end()) {
-        for (const auto& itm2 : itm->second) {
-            result.insert(find(itm2));
-        }
-    }
-    auto itm2 = constraintReferences_by_constraintSet_original_ids_by_constraintSet_type.find(
-            constraintSetReference.type);
-    if (itm2 != constraintReferences_by_constraintSet_original_ids_by_constraintSet_type.end()) {
-        auto itm3 = itm2->second.find(constraintSetReference.original_id);
-        if (itm3 != itm2->second.end()) {
-            for (const auto& itm4 : itm3->second) {
-                result.insert(find(itm4));
-            }
-        }
-    }
-    return result;
+    const auto& constraints = getResolvedConstraints(constraintSetReference);
+    return set<shared_ptr<Constraint>, ptrLess<Constraint>>(constraints.begin(), constraints.end());
 }
 
 set<shared_ptr<ConstraintSet>, ptrLess<ConstraintSet>> Model::getConstraintSetsByConstraint(
         const Reference<Constraint>& constraintReference) const {
-    set<shared_ptr<ConstraintSet>, ptrLess<ConstraintSet>> result;
-    for (const auto& it : constraintSets) {
-        const auto& constraints = getConstraintsByConstraintSet(it->getReference());
-        bool found = false;
-        for (const auto& constraint : constraints) {
-            if (constraint == nullptr) {
-                throw logic_error("Missing constraint declared in constraintSet : " + to_str(*it));
+    if (not constraintMembership.reverseBuilt) {
+        for (const auto& constraintSet : constraintSets) {
+            const size_t row = resolveMembership(constraintMembership, constraintSet->getReference(),
+                    constraintReferences_by_constraintSet_ids,
+                    constraintReferences_by_constraintSet_original_ids_by_constraintSet_type);
+            if (not constraintMembership.rowIsComplete[row]) {
+                throw logic_error("Missing constraint declared in constraintSet : " + to_str(*constraintSet));
             }
-            if (constraint->getReference() == constraintReference) {
-                found = true;
-                break;
+            for (const auto& constraint : constraintMembership.rows[row]) {
+                constraintMembership.setsByMemberId[constraint->getId()].push_back(constraintSet);
             }
         }
-        if (found) {
-            result.insert(it);
-        }
+        constraintMembership.reverseBuilt = true;
+    }
+    set<shared_ptr<ConstraintSet>, ptrLess<ConstraintSet>> result;
+    const auto& constraint = find(constraintReference);
+    if (constraint == nullptr) {
+        return result;
+    }
+    const auto& it = constraintMembership.setsByMemberId.find(constraint->getId());
+    if (it != constraintMembership.setsByMemberId.end()) {
+        result.insert(it->second.begin(), it->second.end());
     }
     return result;
 }
 
+const vector<shared_ptr<Objective>>& Model::getResolvedObjectives(
+        const Reference<ObjectiveSet>& objectiveSetReference) const {
+    const size_t row = resolveMembership(objectiveMembership, objectiveSetReference,
+            objectiveReferences_by_objectiveSet_ids,
+            objectiveReferences_by_objectiveSet_original_ids_by_objectiveSet_type);
+    return objectiveMembership.rows[row];
+}
+
 set<shared_ptr<Objective>, ptrLess<Objective>> Model::getObjectivesByObjectiveSet(
         const Reference<ObjectiveSet>& objectiveSetReference) const {
-    set<shared_ptr<Objective>, ptrLess<Objective>> result;
-    auto itm = objectiveReferences_by_objectiveSet_ids.find(objectiveSetReference.id);
-    if (itm != objectiveReferences_by_objectiveSet_ids.end()) {
-        for (const auto& itm2 : itm->second) {
-            result.insert(find(itm2));
-        }
-    }
-    auto itm2 = objectiveReferences_by_objectiveSet_original_ids_by_objectiveSet_type.find(
-            objectiveSetReference.type);
-    if (itm2 != objectiveReferences_by_objectiveSet_original_ids_by_objectiveSet_type.end()) {
-        auto itm3 = itm2->second.find(objectiveSetReference.original_id);
-        if (itm3 != itm2->second.end()) {
-            for (const auto& itm4 : itm3->second) {
-                result.insert(find(itm4));
-            }
-        }
-    }
-    return result;
+    const auto& objectives = getResolvedObjectives(objectiveSetReference);
+    return set<shared_ptr<Objective>, ptrLess<Objective>>(objectives.begin(), objectives.end());
 }
 
 vector<shared_ptr<ConstraintSet>> Model::getActiveConstraintSets() const {
@@ -864,13 +894,96 @@ bool Model::canBeReused(const shared_ptr<Analysis>& analysis) const noexcept {
 }
 
 void Model::generateSkin() {
-
+    const size_t cellCountBefore = mesh.countCells();
+    size_t faceCount = 0;
+    size_t groupCount = 0;
+
+    // Loadings applied together: first loading of each load set, type, coordinate system and
+    // values, with the skin cells of all the loadings merged into it. A loading applied again
+    // on a face already in the group starts another group, so that both loads add up.
+    map<tuple<const LoadSet*, Loading::Type, Reference<CoordinateSystem>, vector<double>>, vector<size_t>> groupIndexesByValues;
+    vector<pair<shared_ptr<CellLoading>, vector<int>>> groupedLoadings;
+    set<pair<size_t, int>> groupedCellPositions; /**< (group index, skin cell position) */
+    vector<shared_ptr<Loading>> mergedLoadings;
     for (const auto& loading : loadings) {
         if (not loading->isCellLoading()) {
             continue;
         }
         const auto& cellLoading = static_pointer_cast<CellLoading>(loading);
-        cellLoading->createSkin();
+        const auto& faceIds = cellLoading->getApplicationFaceNodeIds();
+        if (faceIds.empty()) {
+            continue;
+        }
+        faceCount++;
+        const int cellPosition = mesh.generateSkinCell(faceIds, SpaceDimension::DIMENSION_2D);
+        cellLoading->clear(); //< To remove the volumic cell and then add the skin at its place
+
+        // LD : try to solve https://github.com/Alneos/vega/issues/25 : only loadings with the same values are grouped
+        size_t groupIndex = groupedLoadings.size();
+        const auto& values = cellLoading->groupingValues();
+        if (not values.empty()) {
+            const auto& key = make_tuple(cellLoading->loadset.get(), cellLoading->type, cellLoading->csref, values);
+            auto& groupIndexes = groupIndexesByValues[key];
+            for (const size_t candidateIndex : groupIndexes) {
+                if (groupedCellPositions.find({candidateIndex, cellPosition}) == groupedCellPositions.end()) {
+                    groupIndex = candidateIndex;
+                    break;
+                }
+            }
+            if (groupIndex == groupedLoadings.size()) {
+                groupIndexes.push_back(groupIndex);
+            }
+        }
+        if (groupIndex == groupedLoadings.size()) {
+            groupedLoadings.push_back({cellLoading, {}});
+        } else {
+            mergedLoadings.push_back(cellLoading);
+        }
+        groupedLoadings[groupIndex].second.push_back(cellPosition);
+        groupedCellPositions.insert({groupIndex, cellPosition});
+    }
+
+    // A single skin for all the loadings
+    if (not groupedLoadings.empty()) {
+        const auto& skin = make_shared<Skin>(*this, modelType);
+        for (const auto& groupedLoading : groupedLoadings) {
+            const auto& cellLoading = groupedLoading.first;
+            const vector<int>& cellPositions = groupedLoading.second;
+            if (configuration.alwaysUseGroupsForCells) {
+                // LD : Workaround for Aster problem : MODELISA6_96
+                //  les 1 mailles imprimées ci-dessus n'appartiennent pas au modèle et pourtant elles ont été affectées dans le mot-clé facteur : !
+                //   ! FORCE_FACE
+                shared_ptr<CellGroup> cellGrp;
+                if (cellPositions.size() == 1) {
+                    const string& groupName = Cell::MedName(cellPositions.front());
+                    cellGrp = static_pointer_cast<CellGroup>(mesh.findGroup(groupName));
+                    if (cellGrp == nullptr) {
+                        cellGrp = mesh.createCellGroup(groupName, Group::NO_ORIGINAL_ID, "Single cell group over skin element");
+                    }
+                } else {
+                    cellGrp = mesh.createCellGroup("SK" + to_string(cellLoading->getId()), Group::NO_ORIGINAL_ID, "Skin elements of loading " + to_string(cellLoading->bestId()));
+                }
+                groupCount++;
+                cellGrp->addCellPositions(cellPositions);
+                cellLoading->add(*cellGrp);
+                skin->add(*cellGrp);
+            } else {
+                cellLoading->addCellPositions(cellPositions);
+                skin->addCellPositions(cellPositions);
+            }
+        }
+        add(skin);
+    }
+    for (const auto& loading : mergedLoadings) {
+        remove(Reference<Loading>(*loading));
+    }
+    if (configuration.logLevel >= LogLevel::DEBUG) {
+        // Previously: one skin cell, one Skin and one group (if alwaysUseGroupsForCells) per loaded face
+        const size_t cellCount = mesh.countCells() - cellCountBefore;
+        cout << "generateSkin: " << faceCount << " loaded faces, " << cellCount << " skin cells ("
+                << faceCount - cellCount << " saved), " << mergedLoadings.size() << " loadings merged, "
+                << (faceCount == 0 ? 0 : faceCount - 1) << " skin sets and "
+                << (configuration.alwaysUseGroupsForCells ? faceCount - groupCount : 0) << " groups saved" << endl;
     }
 
     for (const auto& target : targets) {
@@ -1149,6 +1262,26 @@ void Model::removeAssertionsMissingDOFS()
     vector<shared_ptr<Objective> > objectivesToRemove;
     for (const auto& analysis : analyses) {
         for(const auto& assertion : analysis->getAssertions()) {
+            if (assertion->type == Objective::Type::BULK_NODAL_DISPLACEMENT_ASSERTION) {
+                // Only the entries are removed, one by one. Entries of a node are usually consecutive.
+                const auto& bulkAssertion = static_pointer_cast<BulkNodalDisplacementAssertion>(assertion);
+                vector<bool> erased(bulkAssertion->entryCount(), false);
+                int lastNodePosition = Node::UNAVAILABLE_NODE;
+                DOFS availableDOFS;
+                for (size_t entry = 0; entry < bulkAssertion->entryCount(); entry++) {
+                    const int nodePosition = bulkAssertion->getNodePosition(entry);
+                    if (nodePosition != lastNodePosition) {
+                        availableDOFS = mesh.findNode(nodePosition).dofs + analysis->findBoundaryDOFS(nodePosition);
+                        lastNodePosition = nodePosition;
+                    }
+                    erased[entry] = not availableDOFS.contains(bulkAssertion->getDOF(entry));
+                }
+                bulkAssertion->eraseEntries(erased);
+                if (bulkAssertion->entryCount() == 0) {
+                    objectivesToRemove.push_back(assertion);
+                }
+                continue;
+            }
             for(int nodePosition: assertion->nodePositions()) {
                 const DOFS& assertionDOFS = assertion->getDOFSForNode(nodePosition);
                 if (not assertionDOFS.empty()) {
@@ -1188,6 +1321,44 @@ void Model::replaceDirectMatrices()
     map<int, DOFS> addedDofsByNode;
     map<int, DOFS> requiredDofsByNode;
     map<int, DOFS> ownedDofsByNode;
+    // Dofs owned by the effective elements around the matrix nodes: cells found through the
+    // node to cell index before any discrete is added, then one pass over the element cells
+    unordered_map<int, DOFS> ownedDofsByCell;
+    for (const auto& elementSetM : elementSets) {
+        if (elementSetM->isMatrixElement()) {
+            for (int nodePosition : static_pointer_cast<MatrixElement>(elementSetM)->nodePositions()) {
+                for (int cellPosition : mesh.findNodeCellPositions(nodePosition)) {
+                    ownedDofsByCell[cellPosition] = DOFS::NO_DOFS;
+                }
+            }
+        }
+    }
+    if (not ownedDofsByCell.empty()) {
+        for (const auto& elementSet : elementSets) {
+            if (not elementSet->effective()) {
+                continue;
+            }
+            const DOFS& elementDofs = (elementSet->isBeam() or elementSet->isShell()) ? DOFS::ALL_DOFS : DOFS::TRANSLATIONS;
+            for (const int cellPosition : elementSet->cellPositions()) {
+                const auto& it = ownedDofsByCell.find(cellPosition);
+                if (it != ownedDofsByCell.end()) {
+                    it->second += elementDofs;
+                }
+            }
+        }
+    }
+    // Owned dofs of each matrix node, updated by the discretes created for the previous matrices
+    map<int, DOFS> elementDofsByNode;
+    for (const auto& elementSetM : elementSets) {
+        if (elementSetM->isMatrixElement()) {
+            for (int nodePosition : static_pointer_cast<MatrixElement>(elementSetM)->nodePositions()) {
+                DOFS& owned = elementDofsByNode[nodePosition];
+                for (int cellPosition : mesh.findNodeCellPositions(nodePosition)) {
+                    owned += ownedDofsByCell[cellPosition];
+                }
+            }
+        }
+    }
     for (const auto& elementSetM : elementSets) {
         if (!elementSetM->isMatrixElement()) {
             continue;
@@ -1195,43 +1366,23 @@ void Model::replaceDirectMatrices()
         const auto& matrix = static_pointer_cast<MatrixElement>(elementSetM);
         for (int nodePosition : matrix->nodePositions()) {
             requiredDofsByNode[nodePosition] = DOFS();
-            const int nodeId = mesh.findNodeId(nodePosition);
-            DOFS owned;
-            for (const auto elementSetI : elementSets) {
-                if (not elementSetI->effective()) {
-                    continue;
-                }
-                for (const int cellPosition : elementSetI->cellPositions()) {
-                    const Cell& cell = mesh.findCell(cellPosition);
-                    for (int cellNodeId : cell.nodeIds) {
-                        if (cellNodeId == nodeId) {
-                            if (elementSetI->isBeam() or elementSetI->isShell()) {
-                                owned += DOFS::ALL_DOFS;
-                            } else {
-                                owned += DOFS::TRANSLATIONS;
-                            }
-                            break;
-                        }
-                    }
-                }
-            }
-            ownedDofsByNode[nodePosition] = owned;
+            ownedDofsByNode[nodePosition] = elementDofsByNode[nodePosition];
         }
         for (const auto& pair : matrix->nodePairs()) {
             if (pair.first == pair.second) {
-                if (not matrix->findInPairs(pair.first).empty()) {
+                if (matrix->countCoupledNodes(pair.first) > 0) {
                     continue; // will be handled by a segment cell with another node
                 }
                 // single node
                 int nodePosition = pair.first;
                 const int nodeId = mesh.findNodeId(nodePosition);
                 DOFS requiredDofs = requiredDofsByNode.find(nodePosition)->second;
-                const auto& submatrix = matrix->findSubmatrix(nodePosition, nodePosition);
-                const auto& discrete = make_shared<DiscretePoint>(*this, submatrix->matrixType);
-                for (const auto& kv : submatrix->componentByDofs) {
-                    double value = kv.second;
-                    const vega::DOF& dof1 = kv.first.first;
-                    const vega::DOF& dof2 = kv.first.second;
+                const DOFMatrix& submatrix = matrix->findSubmatrix(nodePosition, nodePosition);
+                const auto& discrete = make_shared<DiscretePoint>(*this, submatrix.matrixType);
+                for (const auto& component : submatrix) {
+                    double value = component.value;
+                    const vega::DOF& dof1 = component.dof1;
+                    const vega::DOF& dof2 = component.dof2;
                     if (!is_equal(value, 0)) {
                         switch (matrix->type) {
                         case ElementSet::Type::STIFFNESS_MATRIX:
@@ -1273,6 +1424,9 @@ void Model::replaceDirectMatrices()
                             << to_string(nodeId) << endl;
                 }
                 this->add(discrete);
+                if (discrete->effective()) {
+                    elementDofsByNode[nodePosition] += DOFS::TRANSLATIONS;
+                }
             } else {
                 // node couple
                 int rowNodePosition = pair.first;
@@ -1306,6 +1460,7 @@ void Model::replaceDirectMatrices()
                     addedDofsByNode[colNodePosition] = DOFS::TRANSLATIONS;
                     mesh.allowDOFS(colNodePosition, DOFS::TRANSLATIONS);
                 }
+                const int segmentCount = matrix->countCoupledNodes(pair.first);
                 for (int row_index = 0; row_index < 2; ++row_index) {
                     for (int col_index = 0; col_index < 2; ++col_index) {
                         int rowNodePosition2;
@@ -1320,13 +1475,13 @@ void Model::replaceDirectMatrices()
                         } else {
                             colNodePosition2 = colNodePosition;
                         }
-                        shared_ptr<const DOFMatrix> submatrix = matrix->findSubmatrix(rowNodePosition2,
+                        const DOFMatrix& submatrix = matrix->findSubmatrix(rowNodePosition2,
                                 colNodePosition2);
-                        for (const auto& kv : submatrix->componentByDofs) {
+                        for (const auto& component : submatrix) {
                             // We are disassembling the matrix, so we must divide the value by the segments
-                            double value = kv.second / static_cast<int>(matrix->findInPairs(pair.first).size());
-                            const DOF& rowDof = kv.first.first;
-                            const DOF& colDof = kv.first.second;
+                            double value = component.value / segmentCount;
+                            const DOF& rowDof = component.dof1;
+                            const DOF& colDof = component.dof2;
                             if (!is_equal(value, 0)) {
                                 switch (matrix->type) {
                                 case ElementSet::Type::STIFFNESS_MATRIX:
@@ -1355,10 +1510,23 @@ void Model::replaceDirectMatrices()
                             << to_string(rowNodeId) << " and : " << to_string(colNodeId) << endl;
                 }
                 this->add(discrete);
+                if (discrete->effective()) {
+                    elementDofsByNode[rowNodePosition] += DOFS::TRANSLATIONS;
+                    elementDofsByNode[colNodePosition] += DOFS::TRANSLATIONS;
+                }
             }
         }
         elementSetsToRemove.push_back(elementSetM);
     }
+    // Any loaded dof is required on the nodes of the matrices
+    DOFS loadedDofs;
+    if (not addedDofsByNode.empty()) {
+        for (const auto loading : loadings) {
+            for (int nodePosition2 : loading->nodePositions()) {
+                loadedDofs += loading->getDOFSForNode(nodePosition2);
+            }
+        }
+    }
     for (const auto& kv : addedDofsByNode) {
         int nodePosition = kv.first;
         const DOFS& added = kv.second;
@@ -1378,11 +1546,7 @@ void Model::replaceDirectMatrices()
             owned = it2->second;
         }
 
-        for (const auto loading : loadings) {
-            for (int nodePosition2 : loading->nodePositions()) {
-                required += loading->getDOFSForNode(nodePosition2);
-            }
-        }
+        required += loadedDofs;
         for (const auto constraint : constraints) {
             const auto& constraintNodes = constraint->nodePositions();
             if (constraintNodes.find(nodePosition) == constraintNodes.end()) {
@@ -1608,9 +1772,8 @@ void Model::splitDirectMatrices(const unsigned int sizeMax){
 
             // We copy the values
             const auto& nM = static_pointer_cast<MatrixElement>(newElementSet);
-            const auto& dM = matrix->findSubmatrix(np.first, np.second);
-            for (const auto dof: dM->componentByDofs){
-                nM->addComponent(nodeIdOfElement[np.first], dof.first.first, nodeIdOfElement[np.second], dof.first.second, dof.second);
+            for (const auto& component : matrix->findSubmatrix(np.first, np.second)){
+                nM->addComponent(nodeIdOfElement[np.first], component.dof1, nodeIdOfElement[np.second], component.dof2, component.value);
             }
 
         }
@@ -2197,121 +2360,171 @@ void Model::splitElementsByCellOffsets() {
     }
 }
 
+Profiler::Counts Model::profilerCounts() const noexcept {
+    Profiler::Counts counts;
+    counts.nodes = static_cast<long>(mesh.countNodes());
+    counts.cells = static_cast<long>(mesh.countCells());
+    counts.objects = static_cast<long>(analyses.size() + objectives.size() + values.size() + loadings.size()
+            + loadSets.size() + constraints.size() + constraintSets.size() + elementSets.size()
+            + objectiveSets.size() + materials.size() + targets.size());
+    return counts;
+}
+
 void Model::finish() {
     if (finished) {
         return;
     }
+    if (profiler == nullptr and configuration.logLevel >= LogLevel::DEBUG) {
+        profiler = make_shared<Profiler>(true);
+    }
+    const auto& counter = [this]() {return profilerCounts();};
 
-    /* Build the coordinate systems from their definition points */
+    /* Build the coordinate systems from their definition points, then compose them with their references */
     for (const auto& coordinateSystemEntry : mesh.coordinateSystemStorage.coordinateSystemByRef) {
         coordinateSystemEntry.second->build();
     }
+    for (const auto& coordinateSystemEntry : mesh.coordinateSystemStorage.coordinateSystemByRef) {
+        coordinateSystemEntry.second->flatten();
+    }
 
-    for (const auto& elementSet : elementSets) {
-        for (int nodePosition : elementSet->nodePositions()) {
-            mesh.allowDOFS(nodePosition,elementSet->getDOFSForNode(nodePosition));
+    {
+        Profiler::Scope pass(profiler, "allowDOFS", counter);
+        for (const auto& elementSet : elementSets) {
+            for (int nodePosition : elementSet->nodePositions()) {
+                mesh.allowDOFS(nodePosition,elementSet->getDOFSForNode(nodePosition));
+            }
         }
     }
 
     if (this->configuration.autoDetectAnalysis and analyses.empty()) {
+        Profiler::Scope pass(profiler, "addAutoAnalysis", counter);
         addAutoAnalysis();
     }
 
     if (this->configuration.createSkin) {
+        Profiler::Scope pass(profiler, "generateSkin", counter);
         generateSkin();
     }
 
-    for (const auto& analysis : analyses) {
-        for (const auto& boundaryCondition : analysis->getBoundaryConditions()) {
-            for(int nodePosition: boundaryCondition->nodePositions()) {
-                analysis->addBoundaryDOFS(nodePosition,
-                        boundaryCondition->getDOFSForNode(nodePosition));
+    {
+        Profiler::Scope pass(profiler, "addBoundaryDOFS", counter);
+        for (const auto& analysis : analyses) {
+            for (const auto& boundaryCondition : analysis->getBoundaryConditions()) {
+                for(int nodePosition: boundaryCondition->nodePositions()) {
+                    analysis->addBoundaryDOFS(nodePosition,
+                            boundaryCondition->getDOFSForNode(nodePosition));
+                }
             }
         }
     }
 
-    removeAssertionsMissingDOFS();
+    {
+        Profiler::Scope pass(profiler, "removeAssertionsMissingDOFS", counter);
+        removeAssertionsMissingDOFS();
+    }
 
     if (this->configuration.makeBoundaryCells) {
+        Profiler::Scope pass(profiler, "makeBoundaryCells", counter);
         makeBoundarySegments();
         makeBoundarySurfaces();
     }
 
     if (this->configuration.emulateLocalDisplacement) {
+        Profiler::Scope pass(profiler, "emulateLocalDisplacementConstraint", counter);
         emulateLocalDisplacementConstraint();
     }
 
-    for (const auto& constraint : constraints.filter(Constraint::Type::QUASI_RIGID)) {
-        const auto& rigid = static_pointer_cast<QuasiRigidConstraint>(constraint);
-        if (this->configuration.convertCompletelyRigidsIntoMPCs or not rigid->isCompletelyRigid())
-            rigid->emulateWithMPCs();
+    {
+        Profiler::Scope pass(profiler, "emulateQuasiRigidWithMPCs", counter);
+        for (const auto& constraint : constraints.filter(Constraint::Type::QUASI_RIGID)) {
+            const auto& rigid = static_pointer_cast<QuasiRigidConstraint>(constraint);
+            if (this->configuration.convertCompletelyRigidsIntoMPCs or not rigid->isCompletelyRigid())
+                rigid->emulateWithMPCs();
+        }
     }
 
     if (this->configuration.displayMasterSlaveConstraint) {
+        Profiler::Scope pass(profiler, "generateBeamsToDisplayMasterSlaveConstraint", counter);
         generateBeamsToDisplayMasterSlaveConstraint();
     }
 
     if (this->configuration.emulateAdditionalMass) {
+        Profiler::Scope pass(profiler, "emulateAdditionalMass", counter);
         emulateAdditionalMass();
     }
 
     if (this->configuration.replaceCombinedLoadSets) {
+        Profiler::Scope pass(profiler, "replaceCombinedLoadSets", counter);
         replaceCombinedLoadSets();
     }
 
     if (this->configuration.replaceDirectMatrices) {
+        Profiler::Scope pass(profiler, "replaceDirectMatrices", counter);
         replaceDirectMatrices();
     }
 
     if (this->configuration.replaceRigidSegments) {
+        Profiler::Scope pass(profiler, "replaceRigidSegments", counter);
         replaceRigidSegments();
     }
 
     if (this->configuration.removeRedundantSpcs) {
+        Profiler::Scope pass(profiler, "removeRedundantSpcs", counter);
         removeRedundantSpcs();
     }
 
     if (this->configuration.removeConstrainedImposed) {
+        Profiler::Scope pass(profiler, "removeConstrainedImposed", counter);
         removeConstrainedImposed();
     }
 
     if (this->configuration.removeIneffectives) {
+        Profiler::Scope pass(profiler, "removeIneffectives", counter);
         removeIneffectives();
     }
 
     if (this->configuration.virtualDiscrets) {
+        Profiler::Scope pass(profiler, "generateDiscrets", counter);
         generateDiscrets();
     }
 
     if (this->configuration.convert0DDiscretsInto1D) {
+        Profiler::Scope pass(profiler, "convert0DDiscretsInto1D", counter);
         convert0DDiscretsInto1D();
     }
 
     if (this->configuration.splitDirectMatrices){
+        Profiler::Scope pass(profiler, "splitDirectMatrices", counter);
         splitDirectMatrices(this->configuration.sizeDirectMatrices);
     }
 
     if (this->configuration.makeCellsFromDirectMatrices){
+        Profiler::Scope pass(profiler, "makeCellsFromDirectMatrices", counter);
         makeCellsFromDirectMatrices();
     }
 
     if (this->configuration.makeCellsFromLMPC){
+        Profiler::Scope pass(profiler, "makeCellsFromLMPC", counter);
         makeCellsFromLMPC();
     }
 
     if (this->configuration.makeCellsFromRBE){
+        Profiler::Scope pass(profiler, "makeCellsFromRBE", counter);
         makeCellsFromRBE();
     }
 
     if (this->configuration.makeCellsFromSurfaceSlide){
+        Profiler::Scope pass(profiler, "makeCellsFromSurfaceSlide", counter);
         makeCellsFromSurfaceSlide();
     }
 
     if (this->configuration.splitElementsByDOFS){
+        Profiler::Scope pass(profiler, "splitElementsByDOFS", counter);
         splitElementsByDOFS();
     }
 
     if (this->configuration.addVirtualMaterial) {
+        Profiler::Scope pass(profiler, "assignVirtualMaterial", counter);
         assignVirtualMaterial();
     }
 
@@ -2319,22 +2532,39 @@ void Model::finish() {
         //splitElementsByCellOffsets();
     }
 
-    assignElementsToCells();
-    generateMaterialAssignments();
+    {
+        Profiler::Scope pass(profiler, "assignElementsToCells", counter);
+        assignElementsToCells();
+    }
+    {
+        Profiler::Scope pass(profiler, "generateMaterialAssignments", counter);
+        generateMaterialAssignments();
+    }
 
     if (this->configuration.changeParametricForceLineToAbsolute) {
+        Profiler::Scope pass(profiler, "changeParametricForceLineToAbsolute", counter);
         changeParametricForceLineToAbsolute();
     }
 
-    createSetGroups();
+    {
+        Profiler::Scope pass(profiler, "createSetGroups", counter);
+        createSetGroups();
+    }
 
     if (this->configuration.removeIneffectives) {
+        Profiler::Scope pass(profiler, "removeUnassignedMaterials", counter);
         removeUnassignedMaterials();
     }
 
-    addDefaultAnalysis();
+    {
+        Profiler::Scope pass(profiler, "addDefaultAnalysis", counter);
+        addDefaultAnalysis();
+    }
 
-    this->mesh.finish();
+    {
+        Profiler::Scope pass(profiler, "finishMesh", counter);
+        this->mesh.finish();
+    }
     finished = true;
 }
 
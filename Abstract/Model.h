@@ -23,7 +23,15 @@
 #include "Objective.h"
 #include "Reference.h"
 #include "Target.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <iterator>
 #include <string>
+#include <tuple>
+#include <deque>
+#include <unordered_map>
+#include <vector>
 
 namespace vega {
 
@@ -177,6 +185,11 @@ public:
     Mesh mesh; /**< Handles geometrical information */
     const ModelConfiguration configuration;
     vega::ConfigurationParameters::TranslationMode translationMode;
+    /**
+     * Measures the passes of finish(). Created by finish() at DEBUG verbosity if the caller
+     * did not provide one.
+     */
+    std::shared_ptr<Profiler> profiler = nullptr;
     const std::shared_ptr<LoadSet> commonLoadSet;
     const std::shared_ptr<ConstraintSet> commonConstraintSet;
     const std::shared_ptr<ObjectiveSet> commonObjectiveSet;
@@ -200,33 +213,112 @@ private:
     std::map< int, std::set<Reference<Objective>>>
     objectiveReferences_by_objectiveSet_ids;
 
+    /**
+     * Resolved membership of the objects T into the sets S, computed from the reference maps above.
+     * Each resolved set is a row holding its members sorted by reference, hence grouped by type.
+     * The reverse rows give, by member Vega id, the sets of the model containing it.
+     * Any add or remove of a set, a member or a membership clears the whole index.
+     */
+    template<class S, class T> class MembershipIndex final {
+    public:
+        std::map<std::tuple<int, typename S::Type, int>, size_t> rowBySet; /**< (id, type, original_id) -> row */
+        std::deque<std::vector<std::shared_ptr<T>>> rows; /**< deque: resolving a row keeps the others in place */
+        std::vector<bool> rowIsComplete; /**< false if a member reference could not be resolved */
+        std::unordered_map<int, std::vector<std::shared_ptr<S>>> setsByMemberId;
+        bool reverseBuilt = false;
+        void clear() noexcept {
+            rowBySet.clear();
+            rows.clear();
+            rowIsComplete.clear();
+            setsByMemberId.clear();
+            reverseBuilt = false;
+        }
+    };
+    mutable MembershipIndex<ConstraintSet, Constraint> constraintMembership;
+    mutable MembershipIndex<LoadSet, Loading> loadingMembership;
+    mutable MembershipIndex<ObjectiveSet, Objective> objectiveMembership;
+    /**
+     * Resolve (once) the members of a set from its entries in the byIds and byOriginalIds maps.
+     */
+    template<class S, class T, class ById, class ByOriginalId>
+    size_t resolveMembership(MembershipIndex<S, T>& index, const Reference<S>& setReference,
+            const ById& byIds, const ByOriginalId& byOriginalIds) const;
+    template<class T> void invalidateMemberships(const T*) noexcept {}
+    void invalidateMemberships(const Constraint*) noexcept { constraintMembership.clear(); }
+    void invalidateMemberships(const ConstraintSet*) noexcept { constraintMembership.clear(); }
+    void invalidateMemberships(const Loading*) noexcept { loadingMembership.clear(); }
+    void invalidateMemberships(const LoadSet*) noexcept { loadingMembership.clear(); }
+    void invalidateMemberships(const Objective*) noexcept { objectiveMembership.clear(); }
+    void invalidateMemberships(const ObjectiveSet*) noexcept { objectiveMembership.clear(); }
+
+    /**
+     * Objects of a kind, iterated in Vega id order. They are stored in a vector sorted by id
+     * and in one such vector by type, with hashed lookups by id and by original id.
+     */
     template<class T> class Container final {
     private:
-        std::map<int, std::shared_ptr<T>> by_id;
-        std::unordered_map< typename T::Type, std::map<int, std::shared_ptr<T>>,
+        std::vector<std::shared_ptr<T>> objects; /**< sorted by Vega id */
+        std::unordered_map<typename T::Type, std::vector<std::shared_ptr<T>>, EnumClassHash> objectsByType; /**< sorted by Vega id */
+        std::unordered_map<int, std::shared_ptr<T>> by_id;
+        std::unordered_map< typename T::Type, std::unordered_map<int, std::shared_ptr<T>>,
         EnumClassHash> by_original_ids_by_type;
+        std::unordered_map<int, std::vector<std::shared_ptr<T>>> by_original_id; /**< one object by type, in order of addition */
+        size_t reorderings = 0; /**< incremented when objects move inside the sorted vectors */
         Model& model;
+        void insert(const std::shared_ptr<T>& ptr);
+        void indexOriginalId(const std::shared_ptr<T>& ptr);
+        static void insertSorted(std::vector<std::shared_ptr<T>>& sorted, const std::shared_ptr<T>& ptr, size_t& reorderings);
+        static void eraseSorted(std::vector<std::shared_ptr<T>>& sorted, int id, size_t& reorderings);
     public:
         Container(Model& model): model(model) {}
         Container(const Container& that) = delete; /**< Containers should never be copied */
-        class iterator;
-        friend class iterator;
-        class iterator : public std::iterator< std::input_iterator_tag,T,ptrdiff_t> {
-            typename std::map<int,std::shared_ptr<T>>::const_iterator it;
-            const std::map<int,std::shared_ptr<T>>* mp;
+        /**
+         * Iterator over a sorted vector of the container. Objects added during the iteration
+         * with a greater id are visited, erased ones are skipped, as with a std::map.
+         */
+        class iterator : public std::iterator<std::input_iterator_tag, std::shared_ptr<T>, ptrdiff_t,
+                const std::shared_ptr<T>*, const std::shared_ptr<T>> {
+            const std::vector<std::shared_ptr<T>>* sorted;
+            const size_t* reorderings;
+            mutable size_t index;
+            mutable size_t seenReorderings;
+            int currentId;
+            /** Find the current object back by its id if the vector has been reordered */
+            void resync() const {
+                if (seenReorderings != *reorderings) {
+                    seenReorderings = *reorderings;
+                    index = static_cast<size_t>(std::lower_bound(sorted->begin(), sorted->end(), currentId,
+                            [](const std::shared_ptr<T>& t, int id) {return t->getId() < id;}) - sorted->begin());
+                }
+            }
+            bool atEnd() const {
+                resync();
+                return index >= sorted->size();
+            }
         public:
-            iterator(const std::map<int,std::shared_ptr<T>>& mp, const typename std::map<int,std::shared_ptr<T>>::const_iterator& it) : it(it), mp(&mp) {}
+            iterator(const std::vector<std::shared_ptr<T>>& sorted, const size_t& reorderings, size_t index) :
+                    sorted(&sorted), reorderings(&reorderings), index(index), seenReorderings(reorderings),
+                    currentId(index < sorted.size() ? sorted[index]->getId() : INT_MAX) {}
                 bool operator==(const iterator& x) const {
-                    return it == x.it;
+                    if (atEnd() or x.atEnd()) {
+                        return atEnd() and x.atEnd();
+                    }
+                    return sorted == x.sorted and index == x.index;
                 }
                 bool operator!=(const iterator& x) const {
                     return !(*this == x);
                 }
+                /** A copy, so that it stays valid when the container is modified inside the loop */
                 const std::shared_ptr<T> operator*() const {
-                    return it->second;
+                    resync();
+                    return (*sorted)[index];
                 }
                 iterator& operator++() {
-                    ++it;
+                    resync();
+                    if (index < sorted->size() and (*sorted)[index]->getId() == currentId) {
+                        ++index;
+                    }
+                    currentId = index < sorted->size() ? (*sorted)[index]->getId() : INT_MAX;
                     return *this;
                 }
                 iterator operator++(int) {
@@ -235,19 +327,36 @@ private:
                     return tmp;
                 }
         }; /* iterator class */
-        iterator begin() const {return iterator(by_id, by_id.begin());}
-        iterator end() const {return iterator(by_id, by_id.end());}
-        std::shared_ptr<T> first() const {return *begin();};
-        std::shared_ptr<T> last() const {return by_id.rbegin()->second;};
-        size_t size() const {return by_id.size();}
-        bool empty() const {return by_id.empty();}
+        friend class iterator;
+        /**
+         * Objects of a type, a view on the container: no object is copied.
+         */
+        class Range final {
+            const std::vector<std::shared_ptr<T>>& sorted;
+            const size_t& reorderings;
+        public:
+            Range(const std::vector<std::shared_ptr<T>>& sorted, const size_t& reorderings) :
+                    sorted(sorted), reorderings(reorderings) {}
+            iterator begin() const {return iterator(sorted, reorderings, 0);}
+            iterator end() const {return iterator(sorted, reorderings, SIZE_MAX);}
+            size_t size() const noexcept {return sorted.size();}
+            bool empty() const noexcept {return sorted.empty();}
+            const std::shared_ptr<T> operator[](size_t i) const {return sorted[i];}
+            operator std::vector<std::shared_ptr<T>>() const {return sorted;}
+        };
+        iterator begin() const {return iterator(objects, reorderings, 0);}
+        iterator end() const {return iterator(objects, reorderings, SIZE_MAX);}
+        std::shared_ptr<T> first() const {return objects.front();};
+        std::shared_ptr<T> last() const {return objects.back();};
+        size_t size() const {return objects.size();}
+        bool empty() const {return objects.empty();}
         void add(std::shared_ptr<T> T_ptr);
         void erase(const Reference<T> ref);
         std::shared_ptr<T> find(const Reference<T>&) const;
-        std::shared_ptr<T> find(int) const; /**< Find an object by its Original Id **/
+        std::shared_ptr<T> find(int) const; /**< Find an object by its Original Id, the first one added if several types share it **/
         std::shared_ptr<T> get(int) const; /**< Return an object by its Vega Id **/
         bool contains(const typename T::Type type) const; /**< Ask if objects of a given type exist inside */
-        std::vector<std::shared_ptr<T>> filter(const typename T::Type type) const; /**< Choose objects based on their type */
+        Range filter(const typename T::Type type) const; /**< Choose objects based on their type */
         //const std::vector<std::shared_ptr<T>> filter(const std::unordered_set<const typename T::Type> types) const; /**< Choose objects based on their types */
         bool validate(); /**< Says if model parts are coherent (no unresolved references, etc.) AND SOMETIMES IT TRIES TO FIX THEM :( */
         bool checkWritten() const; /**< Says if all container objects have been written in output (or not) */
@@ -352,6 +461,12 @@ public:
      */
     std::set<std::shared_ptr<Loading>, ptrLess<Loading>> getLoadingsByLoadSet(const Reference<LoadSet>&) const;
 
+    /**
+     * Loadings of a given LoadSet, sorted by reference (thus grouped by type).
+     * The returned vector is cached and stays valid until the next add or remove.
+     */
+    const std::vector<std::shared_ptr<Loading>>& getResolvedLoadings(const Reference<LoadSet>&) const;
+
     /**
      * Create a material
      */
@@ -384,6 +499,13 @@ public:
      */
     std::set<std::shared_ptr<Constraint>, ptrLess<Constraint>> getConstraintsByConstraintSet(const Reference<ConstraintSet>&) const;
 
+    /**
+     * Constraints of a given ConstraintSet, sorted by reference (thus grouped by type).
+     * The returned vector is cached and stays valid until the next add or remove.
+     * Unresolved references are reported on the error output and left out.
+     */
+    const std::vector<std::shared_ptr<Constraint>>& getResolvedConstraints(const Reference<ConstraintSet>&) const;
+
     /**
      * Retrieve all the ConstraintSet containing a corresponding Constraint.
      */
@@ -404,6 +526,13 @@ public:
      */
     std::set<std::shared_ptr<Objective>, ptrLess<Objective>> getObjectivesByObjectiveSet(const Reference<ObjectiveSet>&) const;
 
+    /**
+     * Objectives of a given ObjectiveSet, sorted by reference (thus grouped by type).
+     * The returned vector is cached and stays valid until the next add or remove.
+     * Unresolved references are reported on the error output and left out.
+     */
+    const std::vector<std::shared_ptr<Objective>>& getResolvedObjectives(const Reference<ObjectiveSet>&) const;
+
     /**
      * Retrieve all the ConstraintSet of the model that are common to all analysis
      */
@@ -446,6 +575,7 @@ public:
      */
     bool validate();
     bool checkWritten() const; /**< Says if model parts have been completely translated */
+    Profiler::Counts profilerCounts() const noexcept; /**< Current model sizes, for the profiler */
 
 };
 
@@ -454,21 +584,84 @@ public:
  */
 
 template<class T>
-void Model::Container<T>::erase(const Reference<T> ref) {
-    by_id.erase(ref.id);
-    if (ref.has_original_id())
-        by_original_ids_by_type[ref.type].erase(ref.original_id);
+void Model::Container<T>::insertSorted(std::vector<std::shared_ptr<T>>& sorted, const std::shared_ptr<T>& ptr,
+        size_t& reorderings) {
+    // Objects are usually added in id order
+    if (sorted.empty() or sorted.back()->getId() < ptr->getId()) {
+        sorted.push_back(ptr);
+        return;
+    }
+    const auto& it = std::lower_bound(sorted.begin(), sorted.end(), ptr->getId(),
+            [](const std::shared_ptr<T>& t, int id) {return t->getId() < id;});
+    sorted.insert(it, ptr);
+    ++reorderings;
 }
 
 template<class T>
-std::vector<std::shared_ptr<T>> Model::Container<T>::filter(const typename T::Type type) const {
-    std::vector<std::shared_ptr<T>> result;
-    for (const auto& id_obj_pair: by_id) {
-        if (id_obj_pair.second->type == type) {
-            result.push_back(id_obj_pair.second);
+void Model::Container<T>::eraseSorted(std::vector<std::shared_ptr<T>>& sorted, int id, size_t& reorderings) {
+    const auto& it = std::lower_bound(sorted.begin(), sorted.end(), id,
+            [](const std::shared_ptr<T>& t, int id2) {return t->getId() < id2;});
+    if (it != sorted.end() and (*it)->getId() == id) {
+        sorted.erase(it);
+        ++reorderings;
+    }
+}
+
+template<class T>
+void Model::Container<T>::insert(const std::shared_ptr<T>& ptr) {
+    const auto& it = by_id.find(ptr->getId());
+    if (it != by_id.end()) {
+        eraseSorted(objects, ptr->getId(), reorderings);
+        eraseSorted(objectsByType[it->second->type], ptr->getId(), reorderings);
+        it->second = ptr;
+    } else {
+        by_id[ptr->getId()] = ptr;
+    }
+    insertSorted(objects, ptr, reorderings);
+    insertSorted(objectsByType[ptr->type], ptr, reorderings);
+}
+
+template<class T>
+void Model::Container<T>::indexOriginalId(const std::shared_ptr<T>& ptr) {
+    by_original_ids_by_type[ptr->type][ptr->getOriginalId()] = ptr;
+    auto& sameOriginalId = by_original_id[ptr->getOriginalId()];
+    for (auto& t : sameOriginalId) {
+        if (t->type == ptr->type) {
+            t = ptr;
+            return;
         }
     }
-    return result;
+    sameOriginalId.push_back(ptr);
+}
+
+template<class T>
+void Model::Container<T>::erase(const Reference<T> ref) {
+    model.invalidateMemberships(static_cast<const T*>(nullptr));
+    const auto& it = by_id.find(ref.id);
+    if (it != by_id.end()) {
+        eraseSorted(objects, ref.id, reorderings);
+        eraseSorted(objectsByType[it->second->type], ref.id, reorderings);
+        by_id.erase(it);
+    }
+    if (ref.has_original_id()) {
+        by_original_ids_by_type[ref.type].erase(ref.original_id);
+        const auto& it2 = by_original_id.find(ref.original_id);
+        if (it2 != by_original_id.end()) {
+            auto& sameOriginalId = it2->second;
+            sameOriginalId.erase(std::remove_if(sameOriginalId.begin(), sameOriginalId.end(),
+                    [&ref](const std::shared_ptr<T>& t) {return t->type == ref.type;}), sameOriginalId.end());
+            if (sameOriginalId.empty()) {
+                by_original_id.erase(it2);
+            }
+        }
+    }
+}
+
+template<class T>
+typename Model::Container<T>::Range Model::Container<T>::filter(const typename T::Type type) const {
+    static const std::vector<std::shared_ptr<T>> noObjects;
+    const auto& it = objectsByType.find(type);
+    return Range(it == objectsByType.end() ? noObjects : it->second, reorderings);
 }
 
 /*template<class T>
@@ -484,12 +677,8 @@ std::vector<std::shared_ptr<T>> Model::Container<T>::filter(const std::unordered
 
 template<class T>
 bool Model::Container<T>::contains(const typename T::Type type) const {
-    for (const auto& id_obj_pair: by_id) {
-        if (id_obj_pair.second->type == type) {
-            return true;
-        }
-    }
-    return false;
+    const auto& it = objectsByType.find(type);
+    return it != objectsByType.end() and not it->second.empty();
 }
 
 template<class T>
@@ -564,10 +753,10 @@ inline void Model::Container<NamedValue>::add(std::shared_ptr<NamedValue> ptr) {
         }
     }
     if (!ptr->isPlaceHolder()) {
-        by_id[ptr->getId()] = ptr;
+        insert(ptr);
     }
     if (ptr->isOriginal()) {
-        by_original_ids_by_type[ptr->type][ptr->getOriginalId()] = ptr;
+        indexOriginalId(ptr);
     }
 }
 
@@ -578,9 +767,10 @@ void Model::Container<T>::add(std::shared_ptr<T> ptr) {
         oss << *ptr << " is already in the model";
         throw std::runtime_error(oss.str());
     }
-    by_id[ptr->getId()] = ptr;
+    model.invalidateMemberships(static_cast<const T*>(nullptr));
+    insert(ptr);
     if (ptr->isOriginal())
-        by_original_ids_by_type[ptr->type][ptr->getOriginalId()] = ptr;
+        indexOriginalId(ptr);
 }
 
 template<class T>
@@ -608,14 +798,11 @@ std::shared_ptr<T> Model::Container<T>::find(const Reference<T>& reference) cons
 
 template<class T>
 std::shared_ptr<T> Model::Container<T>::find(int original_id) const {
-    std::shared_ptr<T> t;
-    for (const auto& it : by_original_ids_by_type) {
-        const auto& it2 = it.second.find(original_id);
-        if (it2 != it.second.end()) {
-            t = it2->second;
-        }
+    const auto& it = by_original_id.find(original_id);
+    if (it == by_original_id.end()) {
+        return nullptr;
     }
-    return t;
+    return it->second.front();
 }
 
 template<class T>
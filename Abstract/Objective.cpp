@@ -23,6 +23,7 @@
 
 #include "Objective.h"
 #include "Model.h"
+#include <unordered_map>
 
 using namespace std;
 
@@ -39,6 +40,7 @@ const string Objective::name = "Objective";
 
 const map<Objective::Type, string> Objective::stringByType = {
         { Objective::Type::NODAL_DISPLACEMENT_ASSERTION, "NODAL_DISPLACEMENT_ASSERTION" },
+        { Objective::Type::BULK_NODAL_DISPLACEMENT_ASSERTION, "BULK_NODAL_DISPLACEMENT_ASSERTION" },
         { Objective::Type::NODAL_COMPLEX_DISPLACEMENT_ASSERTION, "NODAL_COMPLEX_DISPLACEMENT_ASSERTION" },
         { Objective::Type::NODAL_CELL_VONMISES_ASSERTION, "NODAL_CELL_VONMISES_ASSERTION" },
         { Objective::Type::FREQUENCY_ASSERTION, "FREQUENCY_ASSERTION" },
@@ -92,6 +94,9 @@ set<shared_ptr<Objective>, ptrLess<Objective> > ObjectiveSet::getObjectivesByTyp
 }
 
 size_t ObjectiveSet::size() const {
+    if (objectiveSetReferences.empty()) {
+        return model.getResolvedObjectives(this->getReference()).size();
+    }
     return getObjectives().size();
 }
 
@@ -148,6 +153,80 @@ ostream &operator<<(ostream &out, const NodalDisplacementAssertion& objective) {
     return out;
 }
 
+BulkNodalDisplacementAssertion::BulkNodalDisplacementAssertion(Model& model, const std::shared_ptr<ObjectiveSet> objectiveset,
+        double tolerance, int original_id) :
+        Assertion(model, objectiveset, Objective::Type::BULK_NODAL_DISPLACEMENT_ASSERTION, tolerance, original_id) {
+}
+
+void BulkNodalDisplacementAssertion::addEntry(int nodeId, DOF dof, double value, double tolerance, double instant) {
+    entryNodePositions.push_back(model.mesh.findOrReserveNode(nodeId));
+    entryDofPositions.push_back(dof.position);
+    entryValues.push_back(value);
+    entryTolerances.push_back(tolerance);
+    entryInstants.push_back(instant);
+}
+
+void BulkNodalDisplacementAssertion::eraseEntries(const vector<bool>& erased) {
+    size_t kept = 0;
+    for (size_t entry = 0; entry < entryNodePositions.size(); entry++) {
+        if (erased[entry]) {
+            continue;
+        }
+        entryNodePositions[kept] = entryNodePositions[entry];
+        entryDofPositions[kept] = entryDofPositions[entry];
+        entryValues[kept] = entryValues[entry];
+        entryTolerances[kept] = entryTolerances[entry];
+        entryInstants[kept] = entryInstants[entry];
+        kept++;
+    }
+    entryNodePositions.resize(kept);
+    entryDofPositions.resize(kept);
+    entryValues.resize(kept);
+    entryTolerances.resize(kept);
+    entryInstants.resize(kept);
+}
+
+void BulkNodalDisplacementAssertion::sampleNodes(size_t nodeCount) {
+    vector<int> orderedNodePositions;
+    unordered_map<int, size_t> rankByNodePosition;
+    for (int nodePosition : entryNodePositions) {
+        if (rankByNodePosition.emplace(nodePosition, orderedNodePositions.size()).second) {
+            orderedNodePositions.push_back(nodePosition);
+        }
+    }
+    if (orderedNodePositions.size() <= nodeCount) {
+        return;
+    }
+    vector<bool> sampledRanks(orderedNodePositions.size(), false);
+    for (size_t sample = 0; sample < nodeCount; sample++) {
+        sampledRanks[sample * orderedNodePositions.size() / nodeCount] = true;
+    }
+    vector<bool> erased(entryNodePositions.size());
+    for (size_t entry = 0; entry < entryNodePositions.size(); entry++) {
+        erased[entry] = not sampledRanks[rankByNodePosition[entryNodePositions[entry]]];
+    }
+    eraseEntries(erased);
+}
+
+DOFS BulkNodalDisplacementAssertion::getDOFSForNode(const int nodePosition) const {
+    DOFS dofs;
+    for (size_t entry = 0; entry < entryNodePositions.size(); entry++) {
+        if (entryNodePositions[entry] == nodePosition) {
+            dofs += DOF::findByPosition(entryDofPositions[entry]);
+        }
+    }
+    return dofs;
+}
+
+set<int> BulkNodalDisplacementAssertion::nodePositions() const {
+    return set<int>(entryNodePositions.begin(), entryNodePositions.end());
+}
+
+ostream &operator<<(ostream &out, const BulkNodalDisplacementAssertion& objective) {
+    out << to_str(objective) << "Entries " << objective.entryCount();
+    return out;
+}
+
 NodalComplexDisplacementAssertion::NodalComplexDisplacementAssertion(Model& model,
         const std::shared_ptr<ObjectiveSet> objectiveset,
         double tolerance, int nodeId, DOF dof, complex<double> value, double frequency,
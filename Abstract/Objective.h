@@ -28,6 +28,7 @@
 #include <memory>
 #include <set>
 #include <complex>
+#include <vector>
 #include "Value.h"
 #include "Object.h"
 #include "Reference.h"
@@ -45,6 +46,7 @@ private:
 public:
     enum class Type {
         NODAL_DISPLACEMENT_ASSERTION,
+        BULK_NODAL_DISPLACEMENT_ASSERTION,
         NODAL_COMPLEX_DISPLACEMENT_ASSERTION,
         NODAL_CELL_VONMISES_ASSERTION,
         FREQUENCY_ASSERTION,
@@ -146,6 +148,51 @@ public:
     friend std::ostream& operator<<(std::ostream&, const NodalDisplacementAssertion&);
 };
 
+/**
+ * Displacement assertions over many nodes, stored column-wise instead of one
+ * NodalDisplacementAssertion by node and DOF (see the result readers). Each entry holds a node
+ * position, a DOF, the expected value, its tolerance and its instant (-1 if none).
+ */
+class BulkNodalDisplacementAssertion: public Assertion {
+    std::vector<int> entryNodePositions;
+    std::vector<dof_int> entryDofPositions;
+    std::vector<double> entryValues;
+    std::vector<double> entryTolerances;
+    std::vector<double> entryInstants;
+public:
+    BulkNodalDisplacementAssertion(Model&, const std::shared_ptr<ObjectiveSet>, double tolerance, int original_id = NO_ORIGINAL_ID);
+    void addEntry(int nodeId, DOF dof, double value, double tolerance, double instant);
+    size_t entryCount() const noexcept {
+        return entryNodePositions.size();
+    }
+    int getNodePosition(size_t entry) const noexcept {
+        return entryNodePositions[entry];
+    }
+    DOF getDOF(size_t entry) const {
+        return DOF::findByPosition(entryDofPositions[entry]);
+    }
+    double getValue(size_t entry) const noexcept {
+        return entryValues[entry];
+    }
+    double getTolerance(size_t entry) const noexcept {
+        return entryTolerances[entry];
+    }
+    double getInstant(size_t entry) const noexcept {
+        return entryInstants[entry];
+    }
+    /**
+     * Remove the entries flagged in erased (which has one flag by entry).
+     */
+    void eraseEntries(const std::vector<bool>& erased);
+    /**
+     * Keep only the entries of nodeCount nodes, evenly chosen in the order the nodes were added.
+     */
+    void sampleNodes(size_t nodeCount);
+    DOFS getDOFSForNode(const int nodePosition) const override final;
+    std::set<int> nodePositions() const override final;
+    friend std::ostream& operator<<(std::ostream&, const BulkNodalDisplacementAssertion&);
+};
+
 class NodalComplexDisplacementAssertion: public NodalAssertion {
 public:
     const std::complex<double> value;
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * Reference.cpp
+ */
+
+#include "Reference.h"
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace vega {
+using namespace std;
+
+/**
+ * Input files registered by the tokenizers. A line is found back from the stream offset
+ * saved every LINES_BY_CHECKPOINT lines: the file is scanned once, on the first line read.
+ */
+class InputFileRegistry final {
+public:
+    static const int LINES_BY_CHECKPOINT = 1024;
+    struct InputFile {
+        string name;
+        bool scanned;
+        vector<streamoff> checkpoints;
+    };
+    mutex lock;
+    vector<InputFile> files;
+    unordered_map<string, int> indexByName;
+    static InputFileRegistry& instance() {
+        static InputFileRegistry registry;
+        return registry;
+    }
+};
+
+int InputContext::registerFile(const string& fileName) {
+    auto& registry = InputFileRegistry::instance();
+    lock_guard<mutex> guard(registry.lock);
+    const auto& it = registry.indexByName.find(fileName);
+    if (it != registry.indexByName.end()) {
+        return it->second;
+    }
+    const int fileIndex = static_cast<int>(registry.files.size());
+    registry.files.push_back({fileName, false, {}});
+    registry.indexByName[fileName] = fileIndex;
+    return fileIndex;
+}
+
+string InputContext::fileName() const {
+    if (fileIndex < 0) {
+        return "";
+    }
+    auto& registry = InputFileRegistry::instance();
+    lock_guard<mutex> guard(registry.lock);
+    return registry.files[static_cast<size_t>(fileIndex)].name;
+}
+
+string InputContext::line() const {
+    if (fileIndex < 0 or lineNumber < 1) {
+        return "";
+    }
+    auto& registry = InputFileRegistry::instance();
+    lock_guard<mutex> guard(registry.lock);
+    auto& file = registry.files[static_cast<size_t>(fileIndex)];
+    ifstream in(file.name, ios::binary);
+    if (not in) {
+        return "";
+    }
+    string text;
+    if (not file.scanned) {
+        file.checkpoints.push_back(0);
+        int scannedLines = 0;
+        while (getline(in, text)) {
+            if (++scannedLines % InputFileRegistry::LINES_BY_CHECKPOINT == 0) {
+                file.checkpoints.push_back(in.tellg());
+            }
+        }
+        file.scanned = true;
+        in.clear();
+    }
+    const size_t checkpoint = static_cast<size_t>((lineNumber - 1) / InputFileRegistry::LINES_BY_CHECKPOINT);
+    if (checkpoint >= file.checkpoints.size()) {
+        return "";
+    }
+    in.seekg(file.checkpoints[checkpoint]);
+    for (int i = static_cast<int>(checkpoint) * InputFileRegistry::LINES_BY_CHECKPOINT; i < lineNumber; i++) {
+        if (not getline(in, text)) {
+            return "";
+        }
+    }
+    return text;
+}
+
+} /* namespace vega */
@@ -30,19 +30,33 @@
 #include <fstream>
 #include <ostream>
 #include <algorithm>
+#include <string>
 
 namespace vega {
 
-class InputContext {
+/**
+ * Where an object has been found in the input: a compact handle on an input file registered
+ * once and a line number. The text of the line is read back from the file only when needed
+ * (usually for a message).
+ */
+class InputContext final {
 public:
-    InputContext(int lineNumber, std::string fileName, std::string line) : lineNumber{lineNumber}, fileName{fileName}, line{line} {
+    InputContext(int lineNumber, int fileIndex) noexcept : lineNumber{lineNumber}, fileIndex{fileIndex} {
     };
     InputContext() = default;
     InputContext(const InputContext&) = default;
     InputContext& operator=(const InputContext&) = default;
     int lineNumber = -1;
-    std::string fileName = "";
-    std::string line = "";
+    int fileIndex = -1;
+    /**
+     * Register an input file (once for every name). Return its index.
+     */
+    static int registerFile(const std::string& fileName);
+    std::string fileName() const;
+    /**
+     * Read the line back from the input file. Empty if the file cannot be read anymore.
+     */
+    std::string line() const;
 };
 
 /**
@@ -145,7 +159,7 @@ std::string to_str(const Reference<T>& reference) {
 
     oss << "Reference[" << type << "; " << id;
     if (reference.inputContext.lineNumber >= 1) {
-        auto contextLine = reference.inputContext.line;
+        auto contextLine = reference.inputContext.line();
         std::replace( contextLine.begin(), contextLine.end(), '\n', '|');
         std::replace( contextLine.begin(), contextLine.end(), '\r', '|');
         oss << ";input " << reference.inputContext.lineNumber << " " << contextLine;
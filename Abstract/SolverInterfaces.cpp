@@ -128,7 +128,15 @@ WritingException::~WritingException() throw () {
 }
 
 Tokenizer::Tokenizer(istream& stream, vega::LogLevel logLevel,  string fileName, vega::ConfigurationParameters::TranslationMode translationMode) :
-    instrream(stream), logLevel(logLevel), fileName(fileName), translationMode(translationMode), lineNumber(0), currentKeyword(""){
+    instrream(&stream), logLevel(logLevel), fileName(fileName), translationMode(translationMode), lineNumber(0), fileIndex(InputContext::registerFile(fileName)), currentKeyword(""){
+}
+
+Tokenizer::Tokenizer(vega::LogLevel logLevel, string fileName, vega::ConfigurationParameters::TranslationMode translationMode) :
+    instrream(nullptr), logLevel(logLevel), fileName(fileName), translationMode(translationMode), lineNumber(0), fileIndex(InputContext::registerFile(fileName)), currentKeyword(""){
+}
+
+void Tokenizer::keepInputContext(bool keep) {
+    fileIndex = keep ? InputContext::registerFile(fileName) : -1;
 }
 
 void Tokenizer::handleParsingError(const string& message) {
@@ -52,11 +52,17 @@ protected:
 	Tokenizer(std::istream& stream, vega::LogLevel logLevel = vega::LogLevel::INFO,
 			const std::string fileName = "UNKNOWN",
 			const vega::ConfigurationParameters::TranslationMode translationMode = vega::ConfigurationParameters::TranslationMode::BEST_EFFORT);
-	std::istream& instrream;
+	/**
+	 * Tokenizer reading from memory (i.e. a mapped file) instead of a stream.
+	 */
+	Tokenizer(vega::LogLevel logLevel, const std::string fileName,
+			const vega::ConfigurationParameters::TranslationMode translationMode);
+	std::istream* instrream; /**< nullptr when reading from memory **/
 	vega::LogLevel logLevel;
 	std::string fileName;    /**< Current fileName: only used for printout and error managment. **/
 	vega::ConfigurationParameters::TranslationMode translationMode;
 	int lineNumber;
+	int fileIndex; /**< Index of fileName in the registered input files, -1 when the input context is not kept **/
 	std::string currentKeyword; /**< Current Keyword: only used for printout and error managment. **/
 
 public:
@@ -67,7 +73,11 @@ public:
 	inline int getLineNumber() const noexcept {return lineNumber;};
 	inline std::string getCurrentKeyword() const noexcept {return currentKeyword;};
 	virtual std::string currentRawDataLine() const = 0;
-	inline InputContext getInputContext() const noexcept {return {lineNumber, fileName, currentRawDataLine()};}
+	inline InputContext getInputContext() const noexcept {return fileIndex < 0 ? InputContext{} : InputContext{lineNumber, fileIndex};}
+	/**
+	 * Keep (the default) or drop the input file and line given to the objects read.
+	 */
+	void keepInputContext(bool keep);
 	void setCurrentKeyword(std::string cK) noexcept {currentKeyword=cK;};
 
     /**
@@ -98,6 +108,7 @@ public:
 	virtual ~Parser() = default;
 
 	ConfigurationParameters::TranslationMode translationMode = ConfigurationParameters::TranslationMode::BEST_EFFORT;
+	bool keepInputContext = true; /**< Give the objects read their input file and line **/
 	/**
 	 * Read a model from a specific file format.
 	 *
@@ -16,8 +16,14 @@
 #include <boost/numeric/ublas/io.hpp>
 #include <boost/numeric/ublas/lu.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <iostream>
 #include <cmath>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
 
 namespace ublas = boost::numeric::ublas;
 
@@ -159,6 +165,139 @@ void stacktrace() {
 }
 #endif
 
+MappedFile::MappedFile(const string& fileName) {
+    namespace bip = boost::interprocess;
+    if (boost::filesystem::file_size(fileName) == 0) {
+        return;
+    }
+    bip::file_mapping mapping(fileName.c_str(), bip::read_only);
+    region = make_unique<bip::mapped_region>(mapping, bip::read_only);
+    // the mapping can be closed once the region exists, the region keeps the pages alive
+    data = static_cast<const char*>(region->get_address());
+    length = region->get_size();
+}
+
+MappedFile::~MappedFile() = default;
+
+BufferedOutputFile::BufferedOutputFile() :
+        ostream(nullptr), block(new char[BLOCK_SIZE]) {
+    fileBuffer.pubsetbuf(block.get(), BLOCK_SIZE);
+    rdbuf(&fileBuffer);
+}
+
+BufferedOutputFile::BufferedOutputFile(const string& fileName, ios_base::openmode mode) :
+        BufferedOutputFile() {
+    open(fileName, mode);
+}
+
+BufferedOutputFile::~BufferedOutputFile() {
+    fileBuffer.close();
+}
+
+void BufferedOutputFile::open(const string& fileName, ios_base::openmode mode) {
+    if (fileBuffer.open(fileName, mode | ios_base::out) == nullptr) {
+        setstate(ios_base::failbit);
+    } else {
+        clear();
+    }
+}
+
+void BufferedOutputFile::close() {
+    if (fileBuffer.close() == nullptr) {
+        setstate(ios_base::failbit);
+    }
+}
+
+Profiler::Profiler(bool verbose) : verbose(verbose) {
+}
+
+void Profiler::start(const string& name, const Counts& counts) {
+    Phase phase;
+    phase.name = name;
+    phase.depth = static_cast<int>(openPhases.size());
+    phase.seconds = 0.0;
+    phase.peakRssBefore = peakResidentSetSize();
+    phase.peakRssAfter = phase.peakRssBefore;
+    phase.before = counts;
+    phase.after = counts;
+    openPhases.push_back(phases.size());
+    phases.push_back(phase);
+    startTimes.push_back(chrono::steady_clock::now());
+}
+
+void Profiler::stop(const Counts& counts) {
+    if (openPhases.empty()) {
+        throw logic_error("Profiler: no phase to stop.");
+    }
+    Phase& phase = phases[openPhases.back()];
+    phase.seconds = chrono::duration<double>(chrono::steady_clock::now() - startTimes.back()).count();
+    phase.peakRssAfter = peakResidentSetSize();
+    phase.after = counts;
+    openPhases.pop_back();
+    startTimes.pop_back();
+    if (verbose) {
+        cout << string(2 * phase.depth, ' ') << "Phase " << phase.name << ": " << phase.seconds << " s"
+                << ", peak RSS +" << (phase.peakRssAfter - phase.peakRssBefore) << " kB"
+                << ", nodes " << showpos << (phase.after.nodes - phase.before.nodes)
+                << ", cells " << (phase.after.cells - phase.before.cells)
+                << ", objects " << (phase.after.objects - phase.before.objects) << noshowpos << endl;
+    }
+}
+
+void Profiler::writeJson(ostream& out) const {
+    out << "{\n  \"phases\": [";
+    for (size_t i = 0; i < phases.size(); i++) {
+        const Phase& phase = phases[i];
+        string name;
+        for (const char c : phase.name) {
+            if (c == '"' or c == '\\') {
+                name += '\\';
+            }
+            name += c;
+        }
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << name << "\", \"depth\": " << phase.depth
+                << ", \"seconds\": " << phase.seconds
+                << ", \"peakRssKb\": " << phase.peakRssAfter
+                << ", \"peakRssDeltaKb\": " << (phase.peakRssAfter - phase.peakRssBefore)
+                << ", \"nodes\": " << phase.after.nodes
+                << ", \"nodesDelta\": " << (phase.after.nodes - phase.before.nodes)
+                << ", \"cells\": " << phase.after.cells
+                << ", \"cellsDelta\": " << (phase.after.cells - phase.before.cells)
+                << ", \"objects\": " << phase.after.objects
+                << ", \"objectsDelta\": " << (phase.after.objects - phase.before.objects) << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+long Profiler::peakResidentSetSize() noexcept {
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024; // bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+Profiler::Scope::Scope(const shared_ptr<Profiler>& profiler, const string& name,
+        const function<Counts()>& counter) : profiler(profiler), counter(counter) {
+    if (profiler) {
+        profiler->start(name, counter());
+    }
+}
+
+Profiler::Scope::~Scope() {
+    if (profiler) {
+        profiler->stop(counter());
+    }
+}
+
 void handler(int sig) {
     // print out all the frames to stderr
     std::cerr << "Error: signal " << sig << std::endl;
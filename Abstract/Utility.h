@@ -30,6 +30,10 @@
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/variant.hpp>
 #include "build_properties.h"
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <memory>
 #if Backtrace_FOUND
 #include <signal.h>
 #elif LIBUNWIND_FOUND
@@ -37,6 +41,12 @@
 #include <libunwind.h>
 #endif
 
+namespace boost {
+namespace interprocess {
+class mapped_region;
+}
+}
+
 // https://stackoverflow.com/a/54293978
 #define CHECK_ENUM_CLASS_EQUAL(L, R) BOOST_CHECK_EQUAL(static_cast<int>(L), static_cast<int>(R))
 
@@ -93,6 +103,147 @@ struct EnumClassHash
 };
 
 
+/**
+ * Read-only memory mapping of a whole file, used by the readers that scan their input
+ * without copying it line by line. An empty file is not mapped: begin() == end().
+ */
+class MappedFile final {
+    std::unique_ptr<boost::interprocess::mapped_region> region;
+    const char* data = nullptr;
+    size_t length = 0;
+public:
+    explicit MappedFile(const std::string& fileName);
+    MappedFile(const MappedFile& that) = delete;
+    MappedFile& operator=(const MappedFile& that) = delete;
+    ~MappedFile();
+    const char* begin() const noexcept {return data;};
+    const char* end() const noexcept {return data + length;};
+    size_t size() const noexcept {return length;};
+};
+
+/**
+ * Output file for the writers: text is accumulated in a large in-memory block which is
+ * written to disk only when full or when the file is closed. Flushing the stream
+ * (std::endl, std::flush) does not force a write, so writers can keep using std::endl.
+ */
+class BufferedOutputFile final : public std::ostream {
+    class FileBuffer final : public std::filebuf {
+    protected:
+        int sync() override {return 0;};
+    };
+    std::unique_ptr<char[]> block;
+    FileBuffer fileBuffer;
+public:
+    static const size_t BLOCK_SIZE = 1 << 20;
+    BufferedOutputFile();
+    explicit BufferedOutputFile(const std::string& fileName, std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc);
+    BufferedOutputFile(const BufferedOutputFile& that) = delete;
+    ~BufferedOutputFile() override;
+    void open(const std::string& fileName, std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc);
+    bool is_open() const {return fileBuffer.is_open();};
+    /**
+     * Write the pending text and close the file. Sets the failbit if the text can't be written.
+     */
+    void close();
+};
+
+/**
+ * Write the decimal representation of value, ending just before end, and return its first
+ * character. Avoids the std::ostream number formatting and temporary strings in tight loops:
+ * the buffer must hold at least 20 characters.
+ */
+inline char* formatDecimal(long long value, char* end) noexcept {
+    unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+    char* begin = end;
+    do {
+        *--begin = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) {
+        *--begin = '-';
+    }
+    return begin;
+}
+
+/**
+ * Write value into buffer as a std::ostream with this precision and the default float field
+ * would ("%.*g"), and return the number of characters. Zeros, the most frequent values of
+ * the matrices written by the solvers, skip the formatting. The buffer must hold 32 characters.
+ */
+inline size_t formatGeneral(double value, int precision, char* buffer) noexcept {
+    if (std::fpclassify(value) == FP_ZERO and not std::signbit(value)) {
+        buffer[0] = '0';
+        return 1;
+    }
+    return static_cast<size_t>(snprintf(buffer, 32, "%.*g", precision, value));
+}
+
+/**
+ * Measures the phases of a translation (parsing, model passes, writing...): wall time,
+ * growth of the peak resident memory and of the model sizes. Phases can be nested.
+ */
+class Profiler final {
+public:
+    /**
+     * Model sizes, sampled at the beginning and at the end of each phase.
+     */
+    class Counts final {
+    public:
+        Counts(long nodes = 0, long cells = 0, long objects = 0) noexcept :
+                nodes(nodes), cells(cells), objects(objects) {};
+        long nodes;
+        long cells;
+        long objects; /**< Analyses, loadings, constraints, elements, materials... **/
+    };
+    class Phase final {
+    public:
+        std::string name;
+        int depth; /**< 0 for a top level phase, 1 for a phase inside it, etc. **/
+        double seconds;
+        long peakRssBefore; /**< Peak resident set size at the beginning of the phase, in kB **/
+        long peakRssAfter;
+        Counts before;
+        Counts after;
+    };
+    /**
+     * Profiles a phase from its construction to its destruction, even if an exception is thrown.
+     * Does nothing without a profiler.
+     */
+    class Scope final {
+        const std::shared_ptr<Profiler> profiler;
+        const std::function<Counts()> counter;
+    public:
+        Scope(const std::shared_ptr<Profiler>& profiler, const std::string& name,
+                const std::function<Counts()>& counter);
+        Scope(const Scope& that) = delete;
+        ~Scope();
+    };
+private:
+    const bool verbose;
+    std::vector<Phase> phases;
+    std::vector<size_t> openPhases; /**< Indexes in phases of the phases not stopped yet **/
+    std::vector<std::chrono::steady_clock::time_point> startTimes;
+public:
+    /**
+     * @param verbose: print each phase on the standard output when it ends.
+     */
+    explicit Profiler(bool verbose);
+    void start(const std::string& name, const Counts& counts = Counts());
+    /**
+     * Stop the last started phase.
+     */
+    void stop(const Counts& counts = Counts());
+    /**
+     * Phases in the order they were started.
+     */
+    const std::vector<Phase>& getPhases() const noexcept {return phases;};
+    void writeJson(std::ostream& out) const;
+    /**
+     * Peak resident set size of the process in kB, 0 when the platform does not provide it.
+     */
+    static long peakResidentSetSize() noexcept;
+};
+
 /**
  * https://stackoverflow.com/questions/16605967/set-precision-of-stdto-string-when-converting-floating-point-values
  */
@@ -28,9 +28,6 @@ using namespace std;
 
 namespace vega {
 
-Value::Value(Value::Type type) : type(type) {
-}
-
 const map<Value::Type, string> Value::stringByType = {
     { Value::Type::KEYWORD, "KEYWORD" },
     { Value::Type::BAND_RANGE, "BAND_RANGE" },
@@ -165,32 +162,13 @@ DynaPhase::DynaPhase(const Model& model, double value, int original_id) :
         ConstantValue(model, Value::Type::DYNA_PHASE, value, original_id) {
 }
 
-VectorialValue::VectorialValue(double x, double y, double z) :
-		Value(Value::Type::VECTOR), value(ublas::vector<double>(3)) {
-	value[0] = x;
-	value[1] = y;
-	value[2] = z;
-}
-
-VectorialValue::VectorialValue(ublas::vector<double>& value) :
-		Value(Value::Type::VECTOR), value(value) {
-}
-
 VectorialValue::VectorialValue(initializer_list<double> init_list):
-				Value(Value::Type::VECTOR), value(ublas::vector<double>(3)) {
-	copy_n(init_list.begin(),min(static_cast<int>(init_list.size()),3), value.begin());
-}
-
-VectorialValue::VectorialValue() :
-		Value(Value::Type::VECTOR), value(ublas::vector<double>(3)) {
-}
-
-double VectorialValue::norm() const {
-	return ublas::norm_2(value);
+				Value(Value::Type::VECTOR), components{{0, 0, 0}} {
+	copy_n(init_list.begin(),min(static_cast<int>(init_list.size()),3), components.begin());
 }
 
 bool VectorialValue::iszero() const {
-	return is_zero(value[0]) && is_zero(value[1]) && is_zero(value[2]);
+	return is_zero(components[0]) && is_zero(components[1]) && is_zero(components[2]);
 }
 
 VectorialValue VectorialValue::orthonormalized(const VectorialValue& u) const {
@@ -201,29 +179,35 @@ VectorialValue VectorialValue::orthonormalized(const VectorialValue& u) const {
 }
 
 VectorialValue VectorialValue::normalized() const {
-	//double norm = sqrt(pow(x(), 2) + pow(y(), 2) + pow(z(), 2));
-	double norm = ublas::norm_2(value);
+	double norm = this->norm();
     return VectorialValue(x() / norm, y() / norm, z() / norm);
 }
 
-VectorialValue VectorialValue::scaled(double factor) const {
-	return VectorialValue(x() * factor, y() * factor, z() * factor);
-}
-
 void vega::VectorialValue::scale(double factor) {
-	value[0] *= factor;
-	value[1] *= factor;
-	value[2] *= factor;
-}
-
-// Dot product with another VectorialValue
-double VectorialValue::dot(const VectorialValue &v) const {
-	return x() * v.x() + y() * v.y() + z() * v.z();
+	components[0] *= factor;
+	components[1] *= factor;
+	components[2] *= factor;
+}
+
+void VectorialValue::combine(const VectorialValue& origin, const VectorialValue& e1, const VectorialValue& e2,
+		const VectorialValue& e3, const double* in, double* out, size_t count) noexcept {
+	// Plain loop over the triplets, with the base in locals: the compiler can vectorize it
+	const double o0 = origin.x(), o1 = origin.y(), o2 = origin.z();
+	const double a0 = e1.x(), a1 = e1.y(), a2 = e1.z();
+	const double b0 = e2.x(), b1 = e2.y(), b2 = e2.z();
+	const double c0 = e3.x(), c1 = e3.y(), c2 = e3.z();
+	for (size_t i = 0; i < 3 * count; i += 3) {
+		const double u = in[i], v = in[i + 1], w = in[i + 2];
+		out[i] = o0 + (u * a0 + v * b0 + w * c0);
+		out[i + 1] = o1 + (u * a1 + v * b1 + w * c1);
+		out[i + 2] = o2 + (u * a2 + v * b2 + w * c2);
+	}
 }
 
-VectorialValue VectorialValue::cross(const VectorialValue &v) const {
-	return VectorialValue(y() * v.z() - z() * v.y(), z() * v.x() - x() * v.z(),
-			x() * v.y() - y() * v.x());
+void VectorialValue::scaleTriplets(double* xyz, size_t count, double factor) noexcept {
+	for (size_t i = 0; i < 3 * count; i++) {
+		xyz[i] *= factor;
+	}
 }
 
 ostream& operator<<(ostream& os, const VectorialValue& obj) {
@@ -231,27 +215,6 @@ ostream& operator<<(ostream& os, const VectorialValue& obj) {
 	return os;
 }
 
-VectorialValue& VectorialValue::operator=(const VectorialValue& vv) {
-    value=vv.value;
-	return *this;
-}
-VectorialValue operator+(const VectorialValue& left, const VectorialValue& right) {
-	return VectorialValue(left.x() + right.x(), left.y() + right.y(), left.z() + right.z());
-}
-
-VectorialValue operator-(const VectorialValue& left, const VectorialValue& right) {
-	return VectorialValue(left.x() - right.x(), left.y() - right.y(), left.z() - right.z());
-}
-
-VectorialValue operator*(const double& left, const VectorialValue& right) {
-	return VectorialValue(left * right.x(), left * right.y(), left * right.z());
-}
-
-VectorialValue operator/(const VectorialValue& left, const double& right) {
-	return VectorialValue(left.x() / right, left.y() / right, left.z() / right);
-}
-
-
 bool operator==(const VectorialValue& left, const VectorialValue& right) {
 	double norm = max(left.norm(), right.norm());
 	if (is_zero(norm))
@@ -29,7 +29,9 @@
 #include "Value.h"
 #include "Utility.h"
 
+#include <array>
 #include <climits>
+#include <cmath>
 #include <map>
 #include <vector>
 #include <memory>
@@ -60,7 +62,8 @@ public:
         VECTORFUNCTION
     };
 protected:
-    Value(Value::Type);
+    Value(Value::Type type) noexcept : type(type) {
+    }
     //Value(const Value& that) = delete; // Because of returned VectorialValue etc
 public:
     virtual ~Value() = default;
@@ -352,51 +355,104 @@ public:
 
 /*
  * Placeholder class, put here all the methods to operate on a vector.
+ * Components are stored inline and contiguous: copying or combining vectors does not allocate,
+ * and the static functions work on arrays of packed (x,y,z) triplets.
  * @see vega expression.pyx VectorialValue
  */
 class VectorialValue final : public Value {//: public TriValue {
 private:
-    ublas::vector<double> value;
-    VectorialValue(ublas::vector<double>& value);
+    std::array<double, 3> components;
     friend std::ostream& operator<<(std::ostream& os, const VectorialValue& obj);
 public:
-    VectorialValue();
-    VectorialValue(double x, double y, double z);
+    VectorialValue() noexcept :
+            Value(Value::Type::VECTOR), components{{0, 0, 0}} {
+    }
+    VectorialValue(double x, double y, double z) noexcept :
+            Value(Value::Type::VECTOR), components{{x, y, z}} {
+    }
     VectorialValue(std::initializer_list<double> c);
-    VectorialValue(const vega::VectorialValue&) = default;
-    VectorialValue(vega::VectorialValue&&) = default;
+    VectorialValue(const vega::VectorialValue& other) noexcept :
+            Value(Value::Type::VECTOR), components(other.components) {
+    }
+    VectorialValue(vega::VectorialValue&& other) noexcept :
+            Value(Value::Type::VECTOR), components(other.components) {
+    }
     inline double x() const noexcept {
-        return value[0];
+        return components[0];
     }
 
     inline double y() const noexcept {
-        return value[1];
+        return components[1];
     }
 
     inline double z() const noexcept {
-        return value[2];
+        return components[2];
+    }
+
+    inline double operator[](size_t i) const noexcept {
+        return components[i];
+    }
+
+    /**
+     * Components (x,y,z), contiguous.
+     */
+    inline const double* data() const noexcept {
+        return components.data();
     }
 
     VectorialValue normalized() const;
     void scale(double factor) override;
-    VectorialValue scaled(double factor) const;
-    double dot(const VectorialValue &v) const;
-    double norm() const;
+    inline VectorialValue scaled(double factor) const noexcept {
+        return VectorialValue(x() * factor, y() * factor, z() * factor);
+    }
+    inline double dot(const VectorialValue &v) const noexcept {
+        return x() * v.x() + y() * v.y() + z() * v.z();
+    }
+    inline double norm() const noexcept {
+        return std::sqrt(dot(*this));
+    }
     bool iszero() const override;
     /**
      *  Cross product with another VectorialValue. Result is ("this" x "other")
      **/
-    VectorialValue cross(const VectorialValue& other) const;
+    inline VectorialValue cross(const VectorialValue& v) const noexcept {
+        return VectorialValue(y() * v.z() - z() * v.y(), z() * v.x() - x() * v.z(),
+                x() * v.y() - y() * v.x());
+    }
     /**
      *  Return a vector orthonormal to "other", computed from this->value
      **/
     VectorialValue orthonormalized(const VectorialValue& other) const;
-    friend VectorialValue operator+(const VectorialValue&, const VectorialValue&);
-    friend VectorialValue operator-(const VectorialValue&, const VectorialValue&);
-    friend VectorialValue operator*(const double&, const VectorialValue&);
-    friend VectorialValue operator/(const VectorialValue&, const double&);
-    VectorialValue& operator=(const VectorialValue&);
-    VectorialValue& operator=(VectorialValue&&) = default;
+    /**
+     * Batch combination of count packed triplets: out = origin + in[0]*e1 + in[1]*e2 + in[2]*e3
+     * for each triplet. in and out may be the same array.
+     */
+    static void combine(const VectorialValue& origin, const VectorialValue& e1, const VectorialValue& e2,
+            const VectorialValue& e3, const double* in, double* out, size_t count) noexcept;
+    /**
+     * Batch scaling of count packed triplets.
+     */
+    static void scaleTriplets(double* xyz, size_t count, double factor) noexcept;
+    friend inline VectorialValue operator+(const VectorialValue& left, const VectorialValue& right) noexcept {
+        return VectorialValue(left.x() + right.x(), left.y() + right.y(), left.z() + right.z());
+    }
+    friend inline VectorialValue operator-(const VectorialValue& left, const VectorialValue& right) noexcept {
+        return VectorialValue(left.x() - right.x(), left.y() - right.y(), left.z() - right.z());
+    }
+    friend inline VectorialValue operator*(const double& left, const VectorialValue& right) noexcept {
+        return VectorialValue(left * right.x(), left * right.y(), left * right.z());
+    }
+    friend inline VectorialValue operator/(const VectorialValue& left, const double& right) noexcept {
+        return VectorialValue(left.x() / right, left.y() / right, left.z() / right);
+    }
+    inline VectorialValue& operator=(const VectorialValue& other) noexcept {
+        components = other.components;
+        return *this;
+    }
+    inline VectorialValue& operator=(VectorialValue&& other) noexcept {
+        components = other.components;
+        return *this;
+    }
     friend bool operator==(const VectorialValue&, const VectorialValue&);
     friend bool operator!=(const VectorialValue&, const VectorialValue&);
 
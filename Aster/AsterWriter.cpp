@@ -480,6 +480,16 @@ void AsterWriter::writeAnalyses() {
 					writeNodalDisplacementAssertion( dynamic_pointer_cast<NodalDisplacementAssertion>(assertion));
                     comm_file_ofs << "                     )," << endl;
 					break;
+				case Objective::Type::BULK_NODAL_DISPLACEMENT_ASSERTION: {
+					const auto& bulkAssertion = static_pointer_cast<BulkNodalDisplacementAssertion>(assertion);
+					for (size_t entry = 0; entry < bulkAssertion->entryCount(); entry++) {
+						comm_file_ofs << "                  _F(RESULTAT=" << resuName << "," << endl;
+						writeNodalDisplacementAssertion(bulkAssertion->getNodePosition(entry), bulkAssertion->getDOF(entry),
+								bulkAssertion->getValue(entry), bulkAssertion->getTolerance(entry), bulkAssertion->getInstant(entry));
+						comm_file_ofs << "                     )," << endl;
+					}
+					break;
+				}
 				case Objective::Type::FREQUENCY_ASSERTION:
 					writeFrequencyAssertion(analysis, dynamic_pointer_cast<FrequencyAssertion>(assertion));
 					break;
@@ -923,7 +933,7 @@ void AsterWriter::writeAffeCaraElem() {
 
 		const auto& discrets_0d = asterModel->model.elementSets.filter(
 				ElementSet::Type::DISCRETE_0D);
-		auto discrets_1d = asterModel->model.elementSets.filter(ElementSet::Type::DISCRETE_1D);
+		vector<shared_ptr<ElementSet>> discrets_1d = asterModel->model.elementSets.filter(ElementSet::Type::DISCRETE_1D);
         const auto& scalar_springs = asterModel->model.elementSets.filter(ElementSet::Type::SCALAR_SPRING);
         const auto& structural_segments = asterModel->model.elementSets.filter(ElementSet::Type::STRUCTURAL_SEGMENT);
         discrets_1d.insert(discrets_1d.end(), scalar_springs.begin(), scalar_springs.end());
@@ -1612,7 +1622,9 @@ void AsterWriter::writeLIAISON_SOLIDE( const ConstraintSet& cset) {
 		for (const auto& constraintPtr : constraints) {
 			comm_file_ofs << "                                   _F(NOEUD=(";
 			for (int node : constraintPtr->nodePositions()) {
-				comm_file_ofs << "'" << Node::MedName(node) << "',";
+				comm_file_ofs << "'";
+				Node::writeMedName(comm_file_ofs, node);
+				comm_file_ofs << "',";
 			}
 			comm_file_ofs << ")," << endl;
 			comm_file_ofs << "                                      )," << endl;
@@ -1676,7 +1688,9 @@ void AsterWriter::writeRBE3( const ConstraintSet& cset) {
 
 			comm_file_ofs << "                                    NOEUD_ESCL=(";
 			for (int slaveNode : slaveNodes) {
-				comm_file_ofs << "'" << Node::MedName(slaveNode) << "',";
+				comm_file_ofs << "'";
+				Node::writeMedName(comm_file_ofs, slaveNode);
+				comm_file_ofs << "',";
 			}
 			comm_file_ofs << ")," << endl;
 			comm_file_ofs << "                                    DDL_ESCL=(";
@@ -1998,7 +2012,9 @@ void AsterWriter::writeNodeContainer(const NodeContainer& nodeContainer) {
       comm_file_ofs << "NOEUD=(";
       for (int nodePosition : nodeContainer.getNodePositionsExcludingGroups()) {
         cnode++;
-        comm_file_ofs << "'" << Node::MedName(nodePosition) << "',";
+        comm_file_ofs << "'";
+        Node::writeMedName(comm_file_ofs, nodePosition);
+        comm_file_ofs << "',";
         if (cnode % 6 == 0) {
           comm_file_ofs << endl << "                             ";
         }
@@ -2036,7 +2052,9 @@ void AsterWriter::writeCellContainer(const CellContainer& cellContainer) {
 //            singleCellGroup->addCellPosition(cellPosition);
 //            singleGroupCellPositions.insert(cellPosition);
 //        }
-        comm_file_ofs << "'" << Cell::MedName(cellPosition) << "',";
+        comm_file_ofs << "'";
+        Cell::writeMedName(comm_file_ofs, cellPosition);
+        comm_file_ofs << "',";
         if (celem % 6 == 0) {
           comm_file_ofs << endl << "                             ";
         }
@@ -2888,22 +2906,27 @@ double AsterWriter::writeAnalysis(const shared_ptr<Analysis>& analysis, double d
 }
 
 void AsterWriter::writeNodalDisplacementAssertion(const shared_ptr<NodalDisplacementAssertion>& nda) {
+	writeNodalDisplacementAssertion(nda->nodePosition, nda->dof, nda->value, nda->tolerance, nda->instant);
+}
+
+void AsterWriter::writeNodalDisplacementAssertion(int nodePosition, const DOF& dof, double value, double tolerance,
+		double instant) {
 
-	bool relativeComparison = abs(nda->value) >= SMALLEST_RELATIVE_COMPARISON;
+	bool relativeComparison = abs(value) >= SMALLEST_RELATIVE_COMPARISON;
 	comm_file_ofs << "                     CRITERE = " << (relativeComparison ? "'RELATIF'," : "'ABSOLU',") << endl;
-	comm_file_ofs << "                     NOEUD='" << Node::MedName(nda->nodePosition) << "'," << endl;
-	comm_file_ofs << "                     NOM_CMP    = '" << AsterModel::DofByPosition.at(nda->dof.position) << "'," << endl;
+	comm_file_ofs << "                     NOEUD='" << Node::MedName(nodePosition) << "'," << endl;
+	comm_file_ofs << "                     NOM_CMP    = '" << AsterModel::DofByPosition.at(dof.position) << "'," << endl;
 	comm_file_ofs << "                     NOM_CHAM   = 'DEPL'," << endl;
-	if (!is_equal(nda->instant, -1)) {
-		comm_file_ofs << "                     INST = " << nda->instant << "," << endl;
+	if (!is_equal(instant, -1)) {
+		comm_file_ofs << "                     INST = " << instant << "," << endl;
 	} else {
 		comm_file_ofs << "                     NUME_ORDRE = 1," << endl;
 	}
     comm_file_ofs << "                     REFERENCE = 'SOURCE_EXTERNE'," << endl;
-    comm_file_ofs << "                     PRECISION = " << nda->tolerance << "," << endl;
-	comm_file_ofs << "                     VALE_REFE = " << nda->value << "," << endl;
-	comm_file_ofs << "                     VALE_CALC = " << (is_zero(nda->value) ? 1e-10 : nda->value) << "," << endl;
-	comm_file_ofs << "                     TOLE_MACHINE = (" << nda->tolerance << "," << 1e-5 << ")," << endl;
+    comm_file_ofs << "                     PRECISION = " << tolerance << "," << endl;
+	comm_file_ofs << "                     VALE_REFE = " << value << "," << endl;
+	comm_file_ofs << "                     VALE_CALC = " << (is_zero(value) ? 1e-10 : value) << "," << endl;
+	comm_file_ofs << "                     TOLE_MACHINE = (" << tolerance << "," << 1e-5 << ")," << endl;
 
 }
 
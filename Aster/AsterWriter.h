@@ -35,8 +35,8 @@ class AsterWriter final : public Writer {
 	std::list<std::string> destroyableConcepts;
 //	std::set<int> singleGroupCellPositions;
 	static constexpr double SMALLEST_RELATIVE_COMPARISON = 1e-7;
-	std::ofstream exp_file_ofs;
-	std::ofstream comm_file_ofs;
+	BufferedOutputFile exp_file_ofs;
+	BufferedOutputFile comm_file_ofs;
 
 	void writeExport();
 	void writeComm();
@@ -67,6 +67,7 @@ class AsterWriter final : public Writer {
 	void writeAssemblage(const std::shared_ptr<Analysis>& analysis, bool canBeReused);
 	void writeCalcFreq(const std::shared_ptr<LinearModal>& analysis);
 	void writeNodalDisplacementAssertion(const std::shared_ptr<NodalDisplacementAssertion>&);
+	void writeNodalDisplacementAssertion(int nodePosition, const DOF&, double value, double tolerance, double instant);
 	void writeNodalComplexDisplacementAssertion(const std::shared_ptr<NodalComplexDisplacementAssertion>&);
 	void writeNodalCellVonMisesAssertion(const std::shared_ptr<NodalCellVonMisesAssertion>&);
 	void writeFrequencyAssertion(const std::shared_ptr<Analysis>&, const std::shared_ptr<FrequencyAssertion>&);
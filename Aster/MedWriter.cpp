@@ -26,6 +26,12 @@
 #include <med.h>
 #define MESGERR 1
 #include <boost/filesystem.hpp>
+#include <boost/functional/hash.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <numeric>
+#include <thread>
 
 namespace vega {
 namespace aster {
@@ -35,51 +41,107 @@ using namespace std;
 // Declaration to avoid Wmissing-declarations error
 void createFamilies(med_idt fid, const char meshname[], const std::vector<Family>& families);
 
+/**
+ * Family index of each entity (node or cell position), given the positions of the entities in
+ * each group. The signature of an entity is the list of the groups containing it: entities with
+ * the same signature share a family. Families are indexed from 1 in the lexicographic order of
+ * their signatures, so the numbering depends neither on the entity order nor on the hashing.
+ * Entities outside of any group get the index 0. signatures receives the groups of each family.
+ */
+static vector<int> familyIndexBySignature(size_t entityCount, const vector<set<int>>& positionsByGroup,
+		vector<vector<size_t>>& signatures) {
+	// Groups of each entity, stored contiguously: memberships[offsets[e]..offsets[e+1]]
+	// is sorted because the groups are visited in order.
+	vector<size_t> offsets(entityCount + 1, 0);
+	for (const auto& positions : positionsByGroup) {
+		for (int position : positions) {
+			offsets[static_cast<size_t>(position) + 1]++;
+		}
+	}
+	partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+	vector<size_t> memberships(offsets.back());
+	vector<size_t> cursors(offsets.begin(), offsets.end() - 1);
+	for (size_t groupIndex = 0; groupIndex < positionsByGroup.size(); groupIndex++) {
+		for (int position : positionsByGroup[groupIndex]) {
+			memberships[cursors[static_cast<size_t>(position)]++] = groupIndex;
+		}
+	}
+	cursors.clear();
+	cursors.shrink_to_fit();
+
+	vector<int> familyIndexes(entityCount, 0);
+	unordered_map<vector<size_t>, int, boost::hash<vector<size_t>>> indexBySignature;
+	vector<size_t> signature;
+	for (size_t entity = 0; entity < entityCount; entity++) {
+		if (offsets[entity] == offsets[entity + 1]) {
+			continue;
+		}
+		signature.assign(memberships.begin() + static_cast<ptrdiff_t>(offsets[entity]),
+				memberships.begin() + static_cast<ptrdiff_t>(offsets[entity + 1]));
+		const auto& it = indexBySignature.find(signature);
+		if (it != indexBySignature.end()) {
+			familyIndexes[entity] = it->second;
+		} else {
+			signatures.push_back(signature);
+			const int familyIndex = static_cast<int>(signatures.size());
+			indexBySignature.insert({signature, familyIndex});
+			familyIndexes[entity] = familyIndex;
+		}
+	}
+
+	// Renumber in signature order
+	vector<size_t> order(signatures.size());
+	iota(order.begin(), order.end(), 0);
+	sort(order.begin(), order.end(), [&signatures](size_t a, size_t b) {return signatures[a] < signatures[b];});
+	vector<int> renumbering(signatures.size() + 1, 0);
+	vector<vector<size_t>> sortedSignatures;
+	sortedSignatures.reserve(signatures.size());
+	for (size_t rank = 0; rank < order.size(); rank++) {
+		renumbering[order[rank] + 1] = static_cast<int>(rank + 1);
+		sortedSignatures.push_back(move(signatures[order[rank]]));
+	}
+	signatures = move(sortedSignatures);
+	for (int& familyIndex : familyIndexes) {
+		familyIndex = renumbering[static_cast<size_t>(familyIndex)];
+	}
+	return familyIndexes;
+}
+
+/**
+ * Families matching the signatures returned by familyIndexBySignature. The name joins the names of
+ * the groups, or is defaultPrefix followed by the index when it does not fit in a MED name.
+ */
+static vector<Family> familiesOfSignatures(const vector<vector<size_t>>& signatures,
+		const vector<shared_ptr<Group>>& groups, int numSign, const string& defaultPrefix) {
+	vector<Family> families;
+	families.reserve(signatures.size());
+	for (size_t index = 0; index < signatures.size(); index++) {
+		Family fam;
+		fam.num = numSign * static_cast<int>(index + 1);
+		for (size_t groupIndex : signatures[index]) {
+			const auto& group = groups[groupIndex];
+			fam.name += (fam.groups.empty() ? "" : "_") + group->getName();
+			fam.groups.push_back(group);
+		}
+		if (fam.name.length() >= MED_LNAME_SIZE) {
+			fam.name = defaultPrefix + to_string(index + 1);
+		}
+		families.push_back(move(fam));
+	}
+	return families;
+}
+
 NodeGroup2Families::NodeGroup2Families(int nnodes, const vector<shared_ptr<NodeGroup>> nodeGroups) {
-	int currentFamilyId = 0;
-	unordered_map<int, int> newFamilyByOldfamily;
-	unordered_map<int, Family> familyByFamilyId;
 	if (nnodes > 0 && nodeGroups.size() > 0) {
-		this->nodes.resize(nnodes, 0);
+		vector<set<int>> positionsByGroup;
+		positionsByGroup.reserve(nodeGroups.size());
 		for (const auto& nodeGroup : nodeGroups) {
-			newFamilyByOldfamily.clear();
-			for (int nodePosition : nodeGroup->nodePositions()) {
-				int oldFamilyId = nodes[nodePosition];
-				auto newFamilyPair = newFamilyByOldfamily.find(oldFamilyId);
-				int newFamilyId;
-				if (newFamilyPair == newFamilyByOldfamily.end()) {
-					//family not found, create one
-					currentFamilyId++;
-                    newFamilyId = currentFamilyId;
-					Family fam;
-					fam.num = currentFamilyId;
-					auto oldFamilyPair = familyByFamilyId.find(oldFamilyId);
-					if (oldFamilyPair != familyByFamilyId.end()) {
-						Family& oldFamily = oldFamilyPair->second;
-						fam.groups.insert(fam.groups.begin(), oldFamily.groups.begin(),
-								oldFamily.groups.end());
-						fam.name = oldFamily.name + "_" + nodeGroup->getName();
-						if (fam.name.length() >= MED_LNAME_SIZE) {
-							fam.name = "Family" + to_string(currentFamilyId);
-						}
-					} else {
-						fam.name = nodeGroup->getName();
-					}
-					fam.groups.push_back(nodeGroup);
-					newFamilyByOldfamily.insert({oldFamilyId, currentFamilyId});
-					familyByFamilyId.insert({currentFamilyId, fam});
-				} else {
-					newFamilyId = newFamilyPair->second;
-				}
-				nodes[nodePosition] = newFamilyId;
-			}
-		}
-	}
-	set<int> familiesInUse(nodes.begin(), nodes.end());
-	for (int fam_id : familiesInUse) {
-		if (fam_id != 0) {
-			families.push_back(familyByFamilyId[fam_id]);
+			positionsByGroup.push_back(nodeGroup->nodePositions());
 		}
+		vector<vector<size_t>> signatures;
+		this->nodes = familyIndexBySignature(static_cast<size_t>(nnodes), positionsByGroup, signatures);
+		const vector<shared_ptr<Group>> groups(nodeGroups.begin(), nodeGroups.end());
+		this->families = familiesOfSignatures(signatures, groups, 1, "Family");
 	}
 }
 
@@ -94,61 +156,33 @@ vector<int> NodeGroup2Families::getFamilyOnNodes() const {
 CellGroup2Families::CellGroup2Families(
 		const Mesh& mesh, unordered_map<CellType::Code, size_t, EnumClassHash> cellCountByType,
 		const vector<shared_ptr<CellGroup>>& cellGroups) : mesh(mesh) {
-	int currentFamilyId = 0;
-	unordered_map<int, int> newFamilyByOldfamily;
-	unordered_map<int, Family> familyByFamilyId;
 	for (const auto& cellCountByTypePair : cellCountByType) {
 		shared_ptr<vector<int>> cells = make_shared<vector<int>>();
 		cells->resize(cellCountByTypePair.second, 0);
 		cellFamiliesByType[cellCountByTypePair.first] = cells;
 	}
 
+	vector<set<int>> positionsByGroup;
+	positionsByGroup.reserve(cellGroups.size());
+	size_t cellPositionCount = 0;
 	for (const auto& cellGroup : cellGroups) {
-		newFamilyByOldfamily.clear();
-		for (const auto& cellPosition : cellGroup->cellPositions()) {
-			const Cell&& cell = mesh.findCell(cellPosition);
-			shared_ptr<vector<int>> currentCellFamilies = cellFamiliesByType[cell.type.code];
-			int oldFamilyId = currentCellFamilies->at(cell.cellTypePosition);
-			auto newFamilyPair = newFamilyByOldfamily.find(oldFamilyId);
-			int newFamilyId;
-			if (newFamilyPair == newFamilyByOldfamily.end()) {
-				//family not found, create one
-				currentFamilyId--;
-                newFamilyId = currentFamilyId;
-                Family fam;
-                fam.num = currentFamilyId;
-				auto oldFamilyPair = familyByFamilyId.find(oldFamilyId);
-				if (oldFamilyPair != familyByFamilyId.end()) {
-					Family& oldFamily = oldFamilyPair->second;
-					fam.groups.insert(fam.groups.begin(), oldFamily.groups.begin(),
-							oldFamily.groups.end());
-					fam.name = oldFamily.name + "_" + cellGroup->getName();
-					if (fam.name.length() >= MED_LNAME_SIZE) {
-						fam.name = "CELLFamily" + to_string(-currentFamilyId);
-					}
-				} else {
-					fam.name = cellGroup->getName();
-				}
-				fam.groups.push_back(cellGroup);
-				newFamilyByOldfamily[oldFamilyId] = currentFamilyId;
-				familyByFamilyId[currentFamilyId] = fam;
-			} else {
-				newFamilyId = newFamilyPair->second;
-			}
-			currentCellFamilies->at(cell.cellTypePosition) = newFamilyId;
+		positionsByGroup.push_back(cellGroup->cellPositions());
+		if (not positionsByGroup.back().empty()) {
+			cellPositionCount = max(cellPositionCount, static_cast<size_t>(*positionsByGroup.back().rbegin()) + 1);
 		}
 	}
-
-	set<int> familiesInUse;
-	for (const auto& cellFamilyAndTypePair : cellFamiliesByType) {
-		familiesInUse.insert(cellFamilyAndTypePair.second->begin(),
-				cellFamilyAndTypePair.second->end());
-	}
-	for (int fam_id : familiesInUse) {
-		if (fam_id != 0) {
-			families.push_back(familyByFamilyId[fam_id]);
+	vector<vector<size_t>> signatures;
+	const vector<int>& familyIndexes = familyIndexBySignature(cellPositionCount, positionsByGroup, signatures);
+	positionsByGroup.clear();
+	for (size_t cellPosition = 0; cellPosition < cellPositionCount; cellPosition++) {
+		if (familyIndexes[cellPosition] == 0) {
+			continue;
 		}
+		const auto& typeAndPosition = mesh.findCellTypePosition(static_cast<int>(cellPosition));
+		cellFamiliesByType.at(typeAndPosition.first)->at(typeAndPosition.second) = -familyIndexes[cellPosition];
 	}
+	const vector<shared_ptr<Group>> groups(cellGroups.begin(), cellGroups.end());
+	families = familiesOfSignatures(signatures, groups, -1, "CELLFamily");
 }
 
 vector<Family> CellGroup2Families::getFamilies() const {
@@ -176,6 +210,37 @@ void createFamilies(med_idt fid, const char meshname[],
 	}
 }
 
+void MedWriter::runConcurrently(const vector<function<void()>>& tasks) {
+	const size_t threads = min(tasks.size(), static_cast<size_t>(max(1u, thread::hardware_concurrency())));
+	atomic<size_t> nextTask(0);
+	vector<exception_ptr> errors(tasks.size());
+	auto work = [&tasks, &nextTask, &errors]() {
+		for (size_t task = nextTask++; task < tasks.size(); task = nextTask++) {
+			try {
+				tasks[task]();
+			} catch (...) {
+				errors[task] = current_exception();
+			}
+		}
+	};
+	if (threads <= 1) {
+		work();
+	} else {
+		vector<thread> workers;
+		for (size_t t = 0; t < threads; t++) {
+			workers.emplace_back(work);
+		}
+		for (auto& worker : workers) {
+			worker.join();
+		}
+	}
+	for (const auto& error : errors) {
+		if (error != nullptr) {
+			rethrow_exception(error);
+		}
+	}
+}
+
 void MedWriter::writeMED(const Model& model, const string& medFileName) {
 	//if (!finished) {
 	//	this->finish();
@@ -193,6 +258,85 @@ void MedWriter::writeMED(const Model& model, const string& medFileName) {
 		cout << "Num nodes : " << nnodes << endl;
 		cout << "Num cells : " << model.mesh.countCells() << endl;
 	}
+	const auto& counter = [&model]() {return model.profilerCounts();};
+
+	/*
+	 * The buffers given to the MED library (coordinates, connectivity and numbers of each cell
+	 * type, families) are independent: they are prepared concurrently. The MED library is not
+	 * thread safe, it is only called afterwards.
+	 */
+	vector<med_float> coordinates;
+	vector<med_int> numnoe;
+	struct CellTypeBuffers {
+		med_int code;
+		med_int numCells;
+		const CellType* type;
+		const vector<int>* cellPositions;
+		vector<med_int> connectivity;
+		vector<med_int> cellnums;
+	};
+	vector<CellTypeBuffers> cellTypeBuffers;
+	unique_ptr<NodeGroup2Families> ng2fam;
+	unique_ptr<CellGroup2Families> cellGroup2Family;
+	const vector<shared_ptr<NodeGroup>>& nodeGroups = model.mesh.getNodeGroups();
+	const vector<shared_ptr<CellGroup>>& cellGroups = model.mesh.getCellGroups();
+	{
+		Profiler::Scope phase(model.profiler, "prepareMED", counter);
+		// Computed on first use: must not be computed by the workers
+		const vector<double>& globalXs = model.mesh.getGlobalXs();
+		const vector<double>& globalYs = model.mesh.getGlobalYs();
+		const vector<double>& globalZs = model.mesh.getGlobalZs();
+		vector<function<void()>> tasks;
+		tasks.push_back([&]() {
+			coordinates.reserve(3 * nnodes);
+			numnoe.reserve(nnodes);
+			for (med_int i = 0; i < nnodes; i++) {
+				coordinates.push_back(globalXs[i]);
+				coordinates.push_back(globalYs[i]);
+				coordinates.push_back(globalZs[i]);
+				numnoe.push_back(i+1);
+			}
+		});
+		for (const auto& kv : model.mesh.cellPositionsByType) {
+			if (kv.first.numNodes == 0 || kv.second.empty()) {
+				continue;
+			}
+			cellTypeBuffers.push_back({static_cast<med_int>(kv.first.code), static_cast<med_int>(kv.second.size()),
+				&kv.first, &kv.second, {}, {}});
+		}
+		for (auto& buffers : cellTypeBuffers) {
+			tasks.push_back([&model, &buffers]() {
+				// Cells of a type are stored in the same order as cellPositions: the connectivity
+				// can be written in one pass. med nodes starts at node number 1.
+				const vector<int>& typeConnectivity = model.mesh.cells.connectivity(*buffers.type);
+				buffers.connectivity.resize(typeConnectivity.size());
+				transform(typeConnectivity.begin(), typeConnectivity.end(), buffers.connectivity.begin(),
+						[](int nodePosition) {return static_cast<med_int>(nodePosition + 1);});
+				buffers.cellnums.reserve(buffers.cellPositions->size());
+				for (int cellPosition : *buffers.cellPositions) {
+					buffers.cellnums.push_back(cellPosition+1);
+				}
+			});
+		}
+		if (not nodeGroups.empty()) {
+			tasks.push_back([&]() {
+				ng2fam = make_unique<NodeGroup2Families>(nnodes, nodeGroups);
+			});
+		}
+		if (not cellGroups.empty()) {
+			tasks.push_back([&]() {
+				unordered_map<CellType::Code, size_t, EnumClassHash> cellCountByType;
+				for (const auto& typeAndCodePair : CellType::typeByCode) {
+					size_t cellNum = model.mesh.countCells(*typeAndCodePair.second);
+					if (cellNum > 0) {
+						cellCountByType[typeAndCodePair.first] = cellNum;
+					}
+				}
+				cellGroup2Family = make_unique<CellGroup2Families>(model.mesh, cellCountByType, cellGroups);
+			});
+		}
+		runConcurrently(tasks);
+	}
 
 	/* open MED file */
 	med_idt fid = MEDfileOpen(medFileName.c_str(), MED_ACC_CREAT);
@@ -205,146 +349,59 @@ void MedWriter::writeMED(const Model& model, const string& medFileName) {
 			MED_SORT_DTIT, MED_CARTESIAN, axisname, unitname) < 0) {
 		throw logic_error("ERROR : Mesh creation ...");
 	}
-	vector<med_float> coordinates;
-	coordinates.reserve(nnodes);
-	for (const NodeData& nodeData : model.mesh.nodes.getNodeDatas()) {
-	    if (nodeData.cpPos == CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID){
-            coordinates.push_back(nodeData.x);
-            coordinates.push_back(nodeData.y);
-            coordinates.push_back(nodeData.z);
-	    } else {
-	        shared_ptr<CoordinateSystem> coordSystem = model.mesh.getCoordinateSystemByPosition(nodeData.cpPos);
-            VectorialValue gCoord = coordSystem->positionToGlobal(VectorialValue(nodeData.x,nodeData.y,nodeData.z));
-            coordinates.push_back(gCoord.x());
-            coordinates.push_back(gCoord.y());
-            coordinates.push_back(gCoord.z());
-	    }
-	}
-	if (MEDmeshNodeCoordinateWr(fid, meshname, MED_NO_DT, MED_NO_IT, 0.0, MED_FULL_INTERLACE,
-			nnodes, coordinates.data()) < 0) {
-		throw logic_error("ERROR : writing nodes ...");
+	{
+		Profiler::Scope phase(model.profiler, "writeMEDNodes", counter);
+		if (MEDmeshNodeCoordinateWr(fid, meshname, MED_NO_DT, MED_NO_IT, 0.0, MED_FULL_INTERLACE,
+				nnodes, coordinates.data()) < 0) {
+			throw logic_error("ERROR : writing nodes ...");
+		}
+		MEDmeshEntityNumberWr(fid, meshname, MED_NO_DT, MED_NO_IT, MED_NODE, MED_NONE,nnodes, numnoe.data());
+		coordinates = vector<med_float>();
+		numnoe = vector<med_int>();
 	}
 
-/*	char* nodeNames = new char[nnodes*MED_SNAME_SIZE]();
-
-    for(int i=0; i<nnodes;i++){
-        strncpy(nodeNames+(i*MED_SNAME_SIZE),Node::MedName(i).c_str(),MED_SNAME_SIZE);
-    }
-    // Problem: Le nom  existe déjà dans le répertoire de noms MAIL    .NOMNOE.
-    MEDmeshEntityNameWr(fid, meshname, MED_NO_DT, MED_NO_IT, MED_NODE, MED_NONE,
-    nnodes, nodeNames);
-    delete[](nodeNames);*/
-
-    vector<med_int> numnoe;
-    numnoe.reserve(nnodes);
-    for(med_int i=0; i<nnodes;i++){
-        numnoe.push_back(i+1);
-    }
-    MEDmeshEntityNumberWr(fid, meshname, MED_NO_DT, MED_NO_IT, MED_NODE, MED_NONE,nnodes, numnoe.data());
-    numnoe.clear();
-
-	for (const auto& kv : model.mesh.cellPositionsByType) {
-		CellType type = kv.first;
-		med_int code = static_cast<med_int>(type.code);
-		vector<med_int> cellPositions = kv.second;
-		med_int numCells = static_cast<med_int>(cellPositions.size());
-		if (type.numNodes == 0 || numCells == 0) {
-			continue;
-		}
-		vector<med_int> connectivity;
-		connectivity.reserve(numCells * type.numNodes);
-		for (med_int cellPosition : cellPositions) {
-			const Cell&& cell = model.mesh.findCell(cellPosition);
-			for (med_int nodePosition : cell.nodePositions) {
-				// med nodes starts at node number 1.
-				connectivity.push_back(nodePosition + 1);
+	{
+		Profiler::Scope phase(model.profiler, "writeMEDCells", counter);
+		for (auto& buffers : cellTypeBuffers) {
+			int result = MEDmeshElementConnectivityWr(fid, meshname, MED_NO_DT,
+			MED_NO_IT, 0.0, MED_CELL, buffers.code, MED_NODAL, MED_FULL_INTERLACE,
+					buffers.numCells,
+					buffers.connectivity.data());
+			if (result < 0) {
+				throw logic_error("ERROR : writing cells ...");
 			}
+			buffers.connectivity = vector<med_int>();
+			MEDmeshEntityNumberWr(fid, meshname, MED_NO_DT, MED_NO_IT, MED_CELL, buffers.code,
+					buffers.numCells, buffers.cellnums.data());
+			buffers.cellnums = vector<med_int>();
 		}
-		int result = MEDmeshElementConnectivityWr(fid, meshname, MED_NO_DT,
-		MED_NO_IT, 0.0, MED_CELL, code, MED_NODAL, MED_FULL_INTERLACE,
-				numCells,
-				connectivity.data());
-		if (result < 0) {
-			throw logic_error("ERROR : writing cells ...");
-		}
-		connectivity.clear();
-
-/*		char* cellNames = new char[numCells*MED_SNAME_SIZE]();
-		//med_int* cellNum=new med_int[numCells];
-		int i = 0;
-        for (int cellPosition : cellPositions) {
-            //int cellId = findCellId(cellPosition);
-            //cellNum[i] = cellId;
-            //cellNum[i] = cellPosition;
-            strncpy(cellNames+(i*MED_SNAME_SIZE),Cell::MedName(cellPosition).c_str(),MED_SNAME_SIZE);
-            cout << cellNames+(i*MED_SNAME_SIZE) << endl;
-            ++i;
-        }
-        result = MEDmeshEntityNameWr(fid, meshname, MED_NO_DT, MED_NO_IT, MED_CELL, code,
-        numCells, cellNames);
-        cout << "result:" << to_string(result) << endl;
-        delete[](cellNames);
-        //result = MEDmeshEntityNumberWr(fid, meshname, MED_NO_DT, MED_NO_IT, MED_CELL, code, numCells, cellNum);
-        //delete[](cellNum);*/
-
-        vector<med_int> cellnums;
-        cellnums.reserve(numCells);
-        for (int cellPosition : cellPositions) {
-            cellnums.push_back(cellPosition+1);
-        }
-        MEDmeshEntityNumberWr(fid, meshname, MED_NO_DT, MED_NO_IT, MED_CELL, code, numCells, cellnums.data());
-        cellnums.clear();
-
-        if (result < 0) {
-        throw logic_error("ERROR : writing cell names ...");
-        }
-	}
-
-	if (MEDfamilyCr(fid, meshname, MED_NO_NAME, 0, 0, MED_NO_GROUP) < 0) {
-		throw logic_error("ERROR : writing family 0 ...");
 	}
 
-	vector<shared_ptr<NodeGroup>> nodeGroups = model.mesh.getNodeGroups();
-    // To avoid useless cast to type ‘int’ in some installations
-	if (not nodeGroups.empty()) {
-		NodeGroup2Families ng2fam(nnodes, nodeGroups);
-		//WARN: if writing to file is delayed to MEDfileClose may be necessary
-		//to move the allocation outside the if
-		const auto& families = ng2fam.getFamilies();
-		createFamilies(fid, meshname, families);
-		//write family number for nodes
-		if (MEDmeshEntityFamilyNumberWr(fid, meshname, MED_NO_DT, MED_NO_IT, MED_NODE, MED_NONE,
-				nnodes, ng2fam.getFamilyOnNodes().data()) < 0) {
-			throw logic_error("ERROR : writing family on nodes ...");
+	{
+		Profiler::Scope phase(model.profiler, "writeMEDFamilies", counter);
+		if (MEDfamilyCr(fid, meshname, MED_NO_NAME, 0, 0, MED_NO_GROUP) < 0) {
+			throw logic_error("ERROR : writing family 0 ...");
 		}
-	}
-	vector<shared_ptr<CellGroup>> cellGroups = model.mesh.getCellGroups();
-	if (not cellGroups.empty()) {
-		unordered_map<CellType::Code, size_t, EnumClassHash> cellCountByType;
-		for (const auto& typeAndCodePair : CellType::typeByCode) {
-			size_t cellNum = model.mesh.countCells(*typeAndCodePair.second);
-			if (cellNum > 0) {
-				cellCountByType[typeAndCodePair.first] = cellNum;
+		if (ng2fam != nullptr) {
+			createFamilies(fid, meshname, ng2fam->getFamilies());
+			//write family number for nodes
+			if (MEDmeshEntityFamilyNumberWr(fid, meshname, MED_NO_DT, MED_NO_IT, MED_NODE, MED_NONE,
+					nnodes, ng2fam->getFamilyOnNodes().data()) < 0) {
+				throw logic_error("ERROR : writing family on nodes ...");
 			}
 		}
-		CellGroup2Families cellGroup2Family = CellGroup2Families(model.mesh, cellCountByType, cellGroups);
-		createFamilies(fid, meshname, cellGroup2Family.getFamilies());
-		for (const auto& cellCodeFamilyVectorPair : cellGroup2Family.getFamilyOnCells()) {
-			int ncells = static_cast<int>(cellCodeFamilyVectorPair.second->size());
-			if (MEDmeshEntityFamilyNumberWr(fid, meshname, MED_NO_DT, MED_NO_IT, MED_CELL,
-					static_cast<int>(cellCodeFamilyVectorPair.first), ncells, cellCodeFamilyVectorPair.second->data())
-					< 0) {
-				throw logic_error("ERROR : writing family on cells ...");
+		if (cellGroup2Family != nullptr) {
+			createFamilies(fid, meshname, cellGroup2Family->getFamilies());
+			for (const auto& cellCodeFamilyVectorPair : cellGroup2Family->getFamilyOnCells()) {
+				int ncells = static_cast<int>(cellCodeFamilyVectorPair.second->size());
+				if (MEDmeshEntityFamilyNumberWr(fid, meshname, MED_NO_DT, MED_NO_IT, MED_CELL,
+						static_cast<int>(cellCodeFamilyVectorPair.first), ncells, cellCodeFamilyVectorPair.second->data())
+						< 0) {
+					throw logic_error("ERROR : writing family on cells ...");
+				}
 			}
 		}
 	}
-	/*
-	 if (MEDmeshElementWr(fid, meshname, MED_NO_DT, MED_NO_IT, 0.0, MED_CELL, MED_TRIA3,
-	 MED_NODAL, MED_FULL_INTERLACE, 30, conn3,MED_FALSE,nullptr,MED_FALSE,nullptr,MED_FALSE,nullptr) < 0) {
-	 MESSAGE("ERROR : triangular cells connectivity ...");
-	 goto ERROR;
-	 }
-	 */
 	/* close MED file */
 	if (MEDfileClose(fid) < 0) {
 		throw logic_error("ERROR : closing med file ...");
@@ -27,6 +27,7 @@
 
 #include "../Abstract/ConfigurationParameters.h"
 #include "../Abstract/Mesh.h"
+#include <functional>
 
 namespace vega {
 
@@ -65,6 +66,11 @@ class MedWriter {
 private:
     friend Mesh;
     friend NodeData;
+    /**
+     * Run the tasks on up to hardware_concurrency threads. The first exception thrown by a task
+     * is thrown again once all of them are done.
+     */
+    static void runConcurrently(const std::vector<std::function<void()>>& tasks);
 public:
     MedWriter() = default;
 	MedWriter(const MedWriter& that) = delete;
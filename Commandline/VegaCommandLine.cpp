@@ -89,28 +89,60 @@ VegaCommandLine::ExitCode VegaCommandLine::convertStudy(
         cout << "Selected writer: " << *writerIterator->second << endl;
     }
 
+    shared_ptr<Profiler> profiler = nullptr;
+    if (configuration.logLevel >= LogLevel::DEBUG or not configuration.profileReportFile.empty()) {
+        profiler = make_shared<Profiler>(configuration.logLevel >= LogLevel::DEBUG);
+    }
+    unique_ptr<Model> model = nullptr;
+    const auto& counter = [&model]() {
+        return model == nullptr ? Profiler::Counts() : model->profilerCounts();
+    };
+
     // Parsing the input file
-    unique_ptr<Model> model = parserIterator->second->parse(configuration);
+    {
+        Profiler::Scope phase(profiler, "parse", counter);
+        model = parserIterator->second->parse(configuration);
+    }
+    model->profiler = profiler;
 
     //adding assertions if result file is set in the model
-    unique_ptr<ResultReader> resultReader = result::ResultReadersFacade::getResultReader(
-            configuration);
-    if (resultReader != nullptr) {
-        resultReader->add_assertions(configuration, *model);
+    {
+        Profiler::Scope phase(profiler, "readResults", counter);
+        unique_ptr<ResultReader> resultReader = result::ResultReadersFacade::getResultReader(
+                configuration);
+        if (resultReader != nullptr) {
+            resultReader->add_assertions(configuration, *model);
+        }
     }
 
-    model->finish();
-    bool validationResult = model->validate();
+    {
+        Profiler::Scope phase(profiler, "finish", counter);
+        model->finish();
+    }
+    bool validationResult;
+    {
+        Profiler::Scope phase(profiler, "validate", counter);
+        validationResult = model->validate();
+    }
     if (!validationResult
             && configuration.translationMode == ConfigurationParameters::TranslationMode::MODE_STRICT) {
+        writeProfileReport(configuration, profiler);
         cerr << "Errors validating model. EXIT" << endl;
         return ExitCode::MODEL_VALIDATION_ERROR;
     }
 
-    string modelFile = writerIterator->second->writeModel(*model, configuration);
-    modelFileOut.append(modelFile);
+    {
+        Profiler::Scope phase(profiler, "write", counter);
+        string modelFile = writerIterator->second->writeModel(*model, configuration);
+        modelFileOut.append(modelFile);
+    }
 
-    bool writingResult = model->checkWritten();
+    bool writingResult;
+    {
+        Profiler::Scope phase(profiler, "checkWritten", counter);
+        writingResult = model->checkWritten();
+    }
+    writeProfileReport(configuration, profiler);
 
     if (!writingResult
             && configuration.translationMode == ConfigurationParameters::TranslationMode::MODE_STRICT) {
@@ -120,6 +152,22 @@ VegaCommandLine::ExitCode VegaCommandLine::convertStudy(
     return ExitCode::OK;
 }
 
+void VegaCommandLine::writeProfileReport(const ConfigurationParameters& configuration,
+        const shared_ptr<Profiler>& profiler) {
+    if (profiler == nullptr or configuration.profileReportFile.empty()) {
+        return;
+    }
+    ofstream out(configuration.profileReportFile);
+    if (!out) {
+        cerr << "Cannot write profile report " << configuration.profileReportFile << endl;
+        return;
+    }
+    profiler->writeJson(out);
+    if (configuration.logLevel >= LogLevel::INFO) {
+        cout << "Profile report written to " << configuration.profileReportFile << endl;
+    }
+}
+
 fs::path VegaCommandLine::normalize_path(string strpath) {
     if (strpath.front() == '"' || strpath.front() == '\'') {
         strpath.erase(0, 1); // erase the first character
@@ -169,6 +217,10 @@ ConfigurationParameters VegaCommandLine::readCommandLineParameters(const po::var
     } else {
         tolerance = 0.02;
     }
+    int sampledAssertionNodes = 0;
+    if (vm.count("assertion-nodes")) {
+        sampledAssertionNodes = vm["assertion-nodes"].as<int>();
+    }
     ConfigurationParameters::TranslationMode translationMode = ConfigurationParameters::TranslationMode::BEST_EFFORT;
     bool hasParamBestEffort = false;
     if (vm.count("best-effort")) {
@@ -234,6 +286,12 @@ ConfigurationParameters VegaCommandLine::readCommandLineParameters(const po::var
         }
     }
 
+    string profileReportFile;
+    if (vm.count("profile-report")) {
+        profileReportFile = normalize_path(vm["profile-report"].as<string>()).string();
+    }
+    const bool keepInputContext = vm.count("no-input-context") == 0;
+
     // Option for Nastran Conversion
     string nastranOutputDialect="cosmic95";
     if (vm.count("nastran.OutputDialect")){
@@ -399,7 +457,8 @@ ConfigurationParameters VegaCommandLine::readCommandLineParameters(const po::var
             solverVersion, modelName, outputDir, logLevel, translationMode, testFnamePath,
             tolerance, runSolver, createGraph, solverServer, solverCommand,
             systusRBE2TranslationMode, systusRBEStiffness, systusRBECoefficient, systusOptionAnalysis, systusOutputProduct,
-            systusSubcases, systusOutputMatrix, systusSizeMatrix, systusDynamicMethod, nastranOutputDialect);
+            systusSubcases, systusOutputMatrix, systusSizeMatrix, systusDynamicMethod, nastranOutputDialect,
+            profileReportFile, keepInputContext, sampledAssertionNodes);
     return configuration;
 }
 
@@ -478,6 +537,8 @@ VegaCommandLine::ExitCode VegaCommandLine::process(int ac, const char* av[]) {
         ("debug,d", "set debug options in solvers, verbose output") //
         ("solver-version", po::value<string>(), "output solver specific version") //
         ("tolerance,x", po::value<double>(), "use TOLERANCE during tests.") //
+        ("assertion-nodes", po::value<int>(), "Check the displacements of only this number of nodes, "
+                "evenly chosen, in each subcase of the test file.") //
         ("best-effort,b", "All the recognized keywords in the source file are "
                 "translated, unknown keywords are skipped.") //
         ("listOptions,l", "Print the options used by current translation.") //
@@ -486,7 +547,11 @@ VegaCommandLine::ExitCode VegaCommandLine::process(int ac, const char* av[]) {
         ("strict,s", "Stops translation at the first "
                 "unrecognized keyword or parameter.")//
         ("graph,g", "Creates a graph of the study") //
-        ("verbosity", po::value<string>(), "Verbosity of VEGA. From low to high: ERROR, WARN, INFO, DEBUG, TRACE"); //
+        ("verbosity", po::value<string>(), "Verbosity of VEGA. From low to high: ERROR, WARN, INFO, DEBUG, TRACE") //
+        ("profile-report", po::value<string>(), "Write the time and memory used by each translation phase "
+                "to this JSON file. Phases are also printed in DEBUG verbosity.") //
+        ("no-input-context", "Do not keep the input line of each object: saves memory on large models, "
+                "but messages no longer point to the input."); //
 
         po::options_description nastranOptions("Nastran specific options");
         nastranOptions.add_options() //
@@ -69,6 +69,8 @@ private:
     static void printHeader();
     std::string expand_user(std::string path);
     static fs::path normalize_path(std::string path);
+    static void writeProfileReport(const ConfigurationParameters& configuration,
+            const std::shared_ptr<Profiler>& profiler);
     std::unordered_map<SolverName, std::unique_ptr<Parser>, EnumClassHash> parserBySolverName;
     std::unordered_map<SolverName, std::unique_ptr<Writer>, EnumClassHash> writersBySolverName;
     std::unordered_map<SolverName, std::unique_ptr<Runner>, EnumClassHash> runnerBySolverType;
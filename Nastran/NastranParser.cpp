@@ -26,8 +26,11 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/math/constants/constants.hpp>
 #include <boost/tokenizer.hpp>
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <vector>
 #include <ciso646>
 
@@ -533,40 +536,196 @@ NastranParser::parseElementFPtr NastranParser::findCmdParser(string keyword) con
     }
 }
 
+void NastranParser::setBulkParsingThreads(unsigned int threads, size_t minimumSize) {
+    this->bulkParsingThreads = threads;
+    this->parallelBulkMinimumSize = minimumSize;
+}
+
 void NastranParser::parseBULKSection(NastranTokenizer &tok, Model& model) {
 
+    if (parseBULKSectionInParallel(tok, model)) {
+        return;
+    }
     while (tok.nextSymbolType == NastranTokenizer::SymbolType::SYMBOL_KEYWORD) {
-        string keyword = tok.nextString(true,"");
-        tok.setCurrentKeyword(keyword);
-        try{
-            auto parser = findCmdParser(keyword);
-            if (parser != nullptr) {
-                (this->*parser)(tok, model);
-
-            } else if (IGNORED_KEYWORDS.find(keyword) != IGNORED_KEYWORDS.end()) {
-                if (model.configuration.logLevel >= LogLevel::TRACE) {
-                    cout << "Keyword " << keyword << " ignored." << endl;
-                }
-                tok.skipToNextKeyword();
+        parseBULKCard(tok, model);
+        tok.nextLine();
+    }
 
-            } else if (!keyword.empty()) {
-                handleParsingError("Unknown keyword.", tok, model);
-                tok.skipToNextKeyword();
-            }
+}
 
-            //Warning if there are unparsed fields. Skip the empty ones
-            if (!tok.isEmptyUntilNextKeyword()) {
-                handleParsingError("Parsing of line not complete:[" + tok.remainingTextUntilNextKeyword()+"]", tok, model);
+void NastranParser::parseBULKCard(NastranTokenizer &tok, Model& model) {
+    string keyword = tok.nextString(true,"");
+    tok.setCurrentKeyword(keyword);
+    try{
+        auto parser = findCmdParser(keyword);
+        if (parser != nullptr) {
+            (this->*parser)(tok, model);
+
+        } else if (IGNORED_KEYWORDS.find(keyword) != IGNORED_KEYWORDS.end()) {
+            if (model.configuration.logLevel >= LogLevel::TRACE) {
+                cout << "Keyword " << keyword << " ignored." << endl;
             }
+            tok.skipToNextKeyword();
 
-        } catch (std::string&) {
-            // Parsing errors are catched by VegaCommandLine.
-            // If we are not in strict mode, we dismiss this command and continue, hoping for the best.
+        } else if (!keyword.empty()) {
+            handleParsingError("Unknown keyword.", tok, model);
             tok.skipToNextKeyword();
         }
-        tok.nextLine();
+
+        //Warning if there are unparsed fields. Skip the empty ones
+        if (!tok.isEmptyUntilNextKeyword()) {
+            handleParsingError("Parsing of line not complete:[" + tok.remainingTextUntilNextKeyword()+"]", tok, model);
+        }
+
+    } catch (std::string&) {
+        // Parsing errors are catched by VegaCommandLine.
+        // If we are not in strict mode, we dismiss this command and continue, hoping for the best.
+        tok.skipToNextKeyword();
+    }
+}
+
+bool NastranParser::parseBULKSectionInParallel(NastranTokenizer &tok, Model& model) {
+    const char* begin = tok.currentCardBegin();
+    const char* end = tok.inputEnd();
+    // Trace messages must come out in file order
+    if (begin == nullptr or tok.nextSymbolType != NastranTokenizer::SymbolType::SYMBOL_KEYWORD
+            or this->logLevel >= LogLevel::TRACE) {
+        return false;
+    }
+    const unsigned int threads = bulkParsingThreads == 0 ? thread::hardware_concurrency() : bulkParsingThreads;
+    const size_t size = static_cast<size_t>(end - begin);
+    if (threads <= 1 or size < parallelBulkMinimumSize) {
+        return false;
     }
 
+    // Each chunk starts at the first line beginning with a letter after its share of the input.
+    // A wrong guess (a continuation line starting with a letter) is detected after the split.
+    vector<BulkChunk> chunks(1);
+    chunks[0].begin = begin;
+    for (unsigned int i = 1; i < threads; i++) {
+        const char* position = max(begin + size / threads * i, chunks.back().begin + 1);
+        while (position < end and (position[-1] != '\n' or not isalpha(static_cast<unsigned char>(*position)))) {
+            const char* lineEnd = static_cast<const char*>(memchr(position, '\n', static_cast<size_t>(end - position)));
+            position = lineEnd == nullptr ? end : lineEnd + 1;
+        }
+        if (position >= end) {
+            break;
+        }
+        chunks.back().end = position;
+        chunks.emplace_back();
+        chunks.back().begin = position;
+    }
+    chunks.back().end = end;
+    if (chunks.size() == 1) {
+        return false;
+    }
+
+    const string fileName = tok.getFileName();
+    vector<thread> workers;
+    for (auto& chunk : chunks) {
+        workers.emplace_back([this, &chunk, end, &fileName]() {
+            readBulkChunk(chunk, end, fileName);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (size_t i = 0; i < chunks.size(); i++) {
+        const char* nextChunkBegin = i + 1 < chunks.size() ? chunks[i + 1].begin : nullptr;
+        if (chunks[i].failed or chunks[i].nextCardBegin != nextChunkBegin) {
+            if (model.configuration.logLevel >= LogLevel::DEBUG) {
+                cout << "BULK section can't be split, parsing it sequentially." << endl;
+            }
+            return false;
+        }
+    }
+
+    // The cell cards are known: size the connectivity arrays once
+    map<const CellType*, size_t> cellCountByType;
+    for (const auto& chunk : chunks) {
+        for (const auto& card : chunk.cards) {
+            if (card.kind == BulkCard::Kind::CELL) {
+                cellCountByType[card.cellType]++;
+            }
+        }
+    }
+    for (const auto& cellCount : cellCountByType) {
+        model.mesh.reserveCells(*cellCount.first, cellCount.second);
+    }
+
+    int lineNumber = tok.currentCardLineNumber() - 1;
+    for (const auto& chunk : chunks) {
+        size_t label = 0;
+        for (const auto& card : chunk.cards) {
+            for (; label < card.labelEnd; label++) {
+                tok.labelByCommentTypeAndId[chunk.labels[label].first] = chunk.labels[label].second;
+            }
+            const int* ints = chunk.ints.data() + card.intStart;
+            const double* doubles = chunk.doubles.data() + card.doubleStart;
+            switch (card.kind) {
+            case BulkCard::Kind::GRID:
+                addGRID(model, ints[0], ints[1] == Globals::UNAVAILABLE_INT ? grdSet.cp : ints[1],
+                        doubles[0], doubles[1], doubles[2], ints[2] == Globals::UNAVAILABLE_INT ? grdSet.cd : ints[2],
+                        ints[3] == Globals::UNAVAILABLE_INT ? grdSet.ps : ints[3]);
+                break;
+            case BulkCard::Kind::CELL: {
+                const vector<int> medConnect(ints + 2, ints + 2 + card.cellType->numNodes);
+                model.mesh.addCell(ints[0], *card.cellType, medConnect, false,
+                        CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID, ints[1], doubles[0]);
+                addProperty(tok, ints[1], ints[0], model);
+                break;
+            }
+            case BulkCard::Kind::REPLAY:
+                tok.seek(card.begin, lineNumber + card.lineNumber - 1);
+                tok.nextLine();
+                parseBULKCard(tok, model);
+                break;
+            default:
+                throw logic_error("BULK card kind not handled");
+            }
+        }
+        // Comments read after the last card of the chunk
+        for (; label < chunk.labels.size(); label++) {
+            tok.labelByCommentTypeAndId[chunk.labels[label].first] = chunk.labels[label].second;
+        }
+        lineNumber += chunk.lineCount;
+    }
+    tok.seek(end, lineNumber);
+    tok.nextLine();
+    return true;
+}
+
+void NastranParser::readBulkChunk(BulkChunk& chunk, const char* inputEnd, const string& fileName) const {
+    try {
+        chunk.lineCount = static_cast<int>(count(chunk.begin, chunk.end, '\n'));
+        NastranTokenizer tok {chunk.begin, inputEnd, this->logLevel, fileName, this->translationMode};
+        // Line numbers are relative to the chunk, and the cards are added by the sequential pass anyway
+        tok.keepInputContext(false);
+        tok.bulkSection();
+        tok.nextLine();
+        while (tok.nextSymbolType == NastranTokenizer::SymbolType::SYMBOL_KEYWORD) {
+            for (auto& label : tok.labelByCommentTypeAndId) {
+                chunk.labels.emplace_back(label.first, move(label.second));
+            }
+            tok.labelByCommentTypeAndId.clear();
+            if (tok.currentCardBegin() >= chunk.end) {
+                chunk.nextCardBegin = tok.currentCardBegin();
+                break;
+            }
+            BulkCard card;
+            card.begin = tok.currentCardBegin();
+            card.lineNumber = tok.currentCardLineNumber();
+            card.labelEnd = chunk.labels.size();
+            card.cellType = nullptr;
+            const string keyword = tok.nextString(true, "");
+            decodeGeometryCard(tok, findCmdParser(keyword), chunk, card);
+            chunk.cards.push_back(card);
+            tok.nextLine();
+        }
+    } catch (...) {
+        // The sequential parsing reports the problem
+        chunk.failed = true;
+    }
 }
 
 fs::path NastranParser::findModelFile(const string& filename) {
@@ -580,6 +739,7 @@ fs::path NastranParser::findModelFile(const string& filename) {
 unique_ptr<Model> NastranParser::parse(const ConfigurationParameters& configuration) {
     this->translationMode = configuration.translationMode;
     this->logLevel = configuration.logLevel;
+    this->keepInputContext = configuration.keepInputContext;
 
     const string filename = configuration.inputFile;
 
@@ -587,10 +747,14 @@ unique_ptr<Model> NastranParser::parse(const ConfigurationParameters& configurat
     const string modelName = inputFilePath.filename().string();
     unique_ptr<Model> model = make_unique<Model>(modelName, "UNKNOWN", SolverName::NASTRAN,
             configuration.getModelConfiguration());
+    bulkNodalForceByLoadSetId.clear();
+    gridSpcByPs.clear();
+    spcBySetDofsAndValue.clear();
     map<string, string> executive_section_context;
     const string inputFilePathStr = inputFilePath.string();
-    ifstream istream(inputFilePathStr);
-    NastranTokenizer tok {istream, logLevel, inputFilePath.string(), this->translationMode};
+    const MappedFile inputFile(inputFilePathStr);
+    NastranTokenizer tok {inputFile.begin(), inputFile.end(), logLevel, inputFilePathStr, this->translationMode};
+    tok.keepInputContext(this->keepInputContext);
 
     if (model->configuration.logLevel >= LogLevel::DEBUG) {
         cout << "Parsing Executive section." << endl;
@@ -602,7 +766,6 @@ unique_ptr<Model> NastranParser::parse(const ConfigurationParameters& configurat
     }
     tok.bulkSection();
     parseBULKSection(tok, *model);
-    istream.close();
 
     if (model->configuration.logLevel >= LogLevel::DEBUG) {
         cout << "Parsing finished." << endl;
@@ -1631,6 +1794,17 @@ void NastranParser::parseEIGRL(NastranTokenizer& tok, Model& model) {
     model.add(frequencySearch);
 }
 
+shared_ptr<BulkNodalForce> NastranParser::getOrCreateBulkNodalForce(NastranTokenizer& tok, Model& model, int loadset_id) {
+    auto& bulkNodalForce = bulkNodalForceByLoadSetId[loadset_id];
+    if (bulkNodalForce == nullptr) {
+        const auto& loadSet = model.getOrCreateLoadSet(loadset_id, LoadSet::Type::LOAD);
+        bulkNodalForce = make_shared<BulkNodalForce>(model, loadSet);
+        bulkNodalForce->setInputContext(tok.getInputContext());
+        model.add(bulkNodalForce);
+    }
+    return bulkNodalForce;
+}
+
 void NastranParser::parseFORCE(NastranTokenizer& tok, Model& model) {
 
     int loadset_id = tok.nextInt();
@@ -1641,12 +1815,10 @@ void NastranParser::parseFORCE(NastranTokenizer& tok, Model& model) {
     double fy = tok.nextDouble(true,0.0) * force;
     double fz = tok.nextDouble(true,0.0) * force;
 
-    const auto& loadSet = model.getOrCreateLoadSet(loadset_id, LoadSet::Type::LOAD);
-    const auto& force1 = make_shared<NodalForce>(model, loadSet, fx, fy, fz, 0., 0., 0., Loading::NO_ORIGINAL_ID,
+    const int csPosition = model.mesh.findOrReserveCoordinateSystem(
             Reference<CoordinateSystem>(CoordinateSystem::Type::ABSOLUTE, csid));
-    force1->addNodeId(node_id);
-    force1->setInputContext(tok.getInputContext());
-    model.add(force1);
+    getOrCreateBulkNodalForce(tok, model, loadset_id)->addEntry(node_id, VectorialValue(fx, fy, fz),
+            VectorialValue(0, 0, 0), csPosition);
 }
 
 void NastranParser::parseFORCE1(NastranTokenizer& tok, Model& model) {
@@ -1780,12 +1952,12 @@ void NastranParser::parseInclude(NastranTokenizer& tok, Model& model) {
     fs::path includePath = currentFname.parent_path() / fileName;
     const string includePathStr = includePath.string();
     if (fs::exists(includePath)) {
-        ifstream istream(includePathStr);
-        NastranTokenizer tok2 {istream, this->logLevel, includePathStr, this->translationMode};
+        const MappedFile includeFile(includePathStr);
+        NastranTokenizer tok2 {includeFile.begin(), includeFile.end(), this->logLevel, includePathStr, this->translationMode};
+        tok2.keepInputContext(this->keepInputContext);
         tok2.bulkSection();
         tok2.nextLine();
         parseBULKSection(tok2, model);
-        istream.close();
     } else {
         handleParsingError("Missing include file "+includePathStr, tok, model);
     }
@@ -1985,12 +2157,8 @@ void NastranParser::parseMOMENT(NastranTokenizer& tok, Model& model) {
     double fry = tok.nextDouble(true) * scale;
     double frz = tok.nextDouble(true) * scale;
 
-    const auto& loadSet = model.getOrCreateLoadSet(loadset_id, LoadSet::Type::LOAD);
-    const auto& force1 = make_shared<NodalForce>(model, loadSet, VectorialValue(0, 0, 0), VectorialValue(frx, fry, frz),
-            Loading::NO_ORIGINAL_ID);
-    force1->addNodeId(node_id);
-    force1->setInputContext(tok.getInputContext());
-    model.add(force1);
+    getOrCreateBulkNodalForce(tok, model, loadset_id)->addEntry(node_id, VectorialValue(0, 0, 0),
+            VectorialValue(frx, fry, frz));
 }
 
 void NastranParser::parseMPC(NastranTokenizer& tok, Model& model) {
@@ -3343,6 +3511,19 @@ void NastranParser::parseSLOAD(NastranTokenizer& tok, Model& model) {
         model.add(force1);
     }
 }
+shared_ptr<SinglePointConstraint> NastranParser::getOrCreateSpc(NastranTokenizer& tok, Model& model, int set_id,
+        int dofs, double value) {
+    auto& spc = spcBySetDofsAndValue[make_tuple(set_id, dofs, value)];
+    if (spc == nullptr) {
+        spc = make_shared<SinglePointConstraint>(model, DOFS::nastranCodeToDOFS(dofs), value);
+        spc->setInputContext(tok.getInputContext());
+        model.add(spc);
+        model.addConstraintIntoConstraintSet(*spc,
+                Reference<ConstraintSet>(ConstraintSet::Type::SPC, set_id));
+    }
+    return spc;
+}
+
 void NastranParser::parseSPC(NastranTokenizer& tok, Model& model) {
     int spcSet_id = tok.nextInt();
     string name = "SPC_" + to_string(spcSet_id);
@@ -3356,14 +3537,8 @@ void NastranParser::parseSPC(NastranTokenizer& tok, Model& model) {
         }
         const int gi = tok.nextInt(true, 123456);
         const double displacement = tok.nextDouble(true, 0.0);
-        const auto& spc = make_shared<SinglePointConstraint>(model, DOFS::nastranCodeToDOFS(gi), displacement);
-        spc->addNodeId(nodeId);
+        getOrCreateSpc(tok, model, spcSet_id, gi, displacement)->addNodeId(nodeId);
         spcNodeGroup->addNodeId(nodeId);
-
-        spc->setInputContext(tok.getInputContext());
-        model.add(spc);
-        model.addConstraintIntoConstraintSet(*spc,
-                Reference<ConstraintSet>(ConstraintSet::Type::SPC, spcSet_id));
     }
 }
 
@@ -3371,21 +3546,8 @@ void NastranParser::parseSPC1(NastranTokenizer& tok, Model& model) {
     int set_id = tok.nextInt();
     const int dofInt = tok.nextInt();
 
-    const auto& spc = make_shared<SinglePointConstraint>(model, DOFS::nastranCodeToDOFS(dofInt), 0.0);
-
-    // Nodes are added to the constraint Node Group
-    string name = "SPC1_" + to_string(set_id);
-    //shared_ptr<NodeGroup> spcNodeGroup = model.mesh.findOrCreateNodeGroup(name,NodeGroup::NO_ORIGINAL_ID,"SPC1");
-
     // Parsing Nodes
-    spc->addNodeIds(tok.nextInts());
-
-    // Adding the constraint to the model
-    spc->setInputContext(tok.getInputContext());
-    model.add(spc);
-    model.addConstraintIntoConstraintSet(*spc,
-            Reference<ConstraintSet>(ConstraintSet::Type::SPC, set_id));
-
+    getOrCreateSpc(tok, model, set_id, dofInt, 0.0)->addNodeIds(tok.nextInts());
 }
 
 void NastranParser::parseSPCADD(NastranTokenizer& tok, Model& model) {
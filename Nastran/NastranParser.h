@@ -70,7 +70,52 @@ private:
     };
     GrdSet grdSet;
 
+    /**
+     * A card of the BULK section read by a worker thread of the parallel parsing.
+     * GRID and solid or shell element cards are decoded in the chunk arrays, any other
+     * card (or any card which would need a message) is replayed through its parsing method.
+     */
+    struct BulkCard {
+        enum class Kind {
+            GRID, /**< ints: id, cp, cd, ps (UNAVAILABLE_INT if blank), doubles: x1, x2, x3 **/
+            CELL, /**< ints: id, property id, node ids in Med order, doubles: offset **/
+            REPLAY
+        };
+        Kind kind;
+        const char* begin;  /**< First line of the card in the input buffer **/
+        int lineNumber;     /**< Number of the first line of the card, relative to the chunk **/
+        size_t labelEnd;    /**< Comment labels read up to this card are labels[0, labelEnd) of the chunk **/
+        size_t intStart;
+        size_t doubleStart;
+        const CellType* cellType;
+    };
+    /**
+     * A slice of the BULK section, starting at a card, and the cards decoded from it.
+     */
+    struct BulkChunk {
+        const char* begin = nullptr;
+        const char* end = nullptr;
+        const char* nextCardBegin = nullptr; /**< First card read past the end, must be the begin of the next chunk **/
+        int lineCount = 0; /**< Number of lines between begin and end **/
+        bool failed = false;
+        std::vector<BulkCard> cards;
+        std::vector<int> ints;
+        std::vector<double> doubles;
+        std::vector<std::pair<std::pair<NastranTokenizer::CommentType, int>, std::string>> labels;
+    };
+    unsigned int bulkParsingThreads = 0;
+    size_t parallelBulkMinimumSize = 1 << 20;
+
     std::unordered_map<std::string, Reference<ElementSet>> directMatrixByName;
+    /**
+     * FORCE and MOMENT cards of a load set are gathered in one BulkNodalForce, GRID PS fields in one
+     * SinglePointConstraint by PS code, SPC and SPC1 cards in one by set, DOFs and value.
+     */
+    std::unordered_map<int, std::shared_ptr<BulkNodalForce>> bulkNodalForceByLoadSetId;
+    std::unordered_map<int, std::shared_ptr<SinglePointConstraint>> gridSpcByPs;
+    std::map<std::tuple<int, int, double>, std::shared_ptr<SinglePointConstraint>> spcBySetDofsAndValue;
+    std::shared_ptr<BulkNodalForce> getOrCreateBulkNodalForce(NastranTokenizer& tok, Model& model, int loadset_id);
+    std::shared_ptr<SinglePointConstraint> getOrCreateSpc(NastranTokenizer& tok, Model& model, int set_id, int dofs, double value);
     static const std::unordered_map<std::string, NastranAnalysis> ANALYSIS_BY_LABEL;
     static const std::unordered_map<std::string, parseElementFPtr> PARSE_FUNCTION_BY_KEYWORD;
     static const std::unordered_map<std::string, parseElementFPtr> PARSEPARAM_FUNCTION_BY_KEYWORD;
@@ -83,6 +128,34 @@ private:
 
     fs::path findModelFile(const std::string& filename);
     void parseBULKSection(NastranTokenizer &tok, Model& model1);
+    /**
+     * Parse the card on which the tokenizer is positioned.
+     */
+    void parseBULKCard(NastranTokenizer &tok, Model& model);
+    /**
+     * Two-phase parsing of the BULK section of an in-memory input: worker threads split the
+     * input into card records and decode the mesh cards, then the records are merged in file
+     * order and the other cards replayed through the parsing methods.
+     * @return false, without having modified the model, if the section must be parsed sequentially.
+     */
+    bool parseBULKSectionInParallel(NastranTokenizer &tok, Model& model);
+    void readBulkChunk(BulkChunk& chunk, const char* inputEnd, const std::string& fileName) const;
+    /**
+     * Decode a GRID or element card without touching the model.
+     * @return false if the card must be replayed through its parsing method.
+     */
+    bool decodeGeometryCard(NastranTokenizer& tok, parseElementFPtr parser, BulkChunk& chunk, BulkCard& card) const;//in NastranParser_geometry.cpp
+    bool decodeGRID(NastranTokenizer& tok, BulkChunk& chunk) const;//in NastranParser_geometry.cpp
+    bool decodeElem(NastranTokenizer& tok, BulkChunk& chunk, const std::vector<CellType>&, BulkCard& card) const;//in NastranParser_geometry.cpp
+    bool decodeShellElem(NastranTokenizer& tok, BulkChunk& chunk, const CellType& cellType) const;//in NastranParser_geometry.cpp
+    /**
+     * Add a GRID to the mesh, with the SPC of its PS field.
+     */
+    void addGRID(Model& model, int id, int cp, double x1, double x2, double x3, int cd, int ps);//in NastranParser_geometry.cpp
+    /**
+     * Reorder a Nastran connectivity as expected by Med.
+     */
+    static std::vector<int> nastranToMedConnectivity(const CellType& cellType, const std::vector<int>& nastranConnect);//in NastranParser_geometry.cpp
 
     void parseExecutiveSection(NastranTokenizer& tok, Model& model, std::map<std::string, std::string>& context);
     /**Renumbers the nodes
@@ -974,6 +1047,11 @@ public:
     NastranParser(const NastranParser& that) = delete;
     virtual ~NastranParser() = default;
     std::unique_ptr<Model> parse(const ConfigurationParameters& configuration) override;
+    /**
+     * Number of threads decoding the mesh cards of the BULK section: 0 for one per core, 1 for
+     * a sequential parsing. BULK sections smaller than minimumSize bytes are always read sequentially.
+     */
+    void setBulkParsingThreads(unsigned int threads, size_t minimumSize = 1 << 20);
 };
 
 }
@@ -24,6 +24,7 @@
 //#include <boost/unordered_map.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/tokenizer.hpp>
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -74,6 +75,16 @@ void NastranParser::parseGRDSET(NastranTokenizer& tok, Model& model) {
 void NastranParser::parseGRID(NastranTokenizer& tok, Model& model) {
     int id = tok.nextInt();
     int cp = tok.nextInt(true, grdSet.cp);
+    double x1 = tok.nextDouble(true, 0.0);
+    double x2 = tok.nextDouble(true, 0.0);
+    double x3 = tok.nextDouble(true, 0.0);
+    /* Coordinate System for Displacement */
+    int cd = tok.nextInt(true, grdSet.cd);
+    int ps = tok.nextInt(true, grdSet.ps);
+    addGRID(model, id, cp, x1, x2, x3, cd, ps);
+}
+
+void NastranParser::addGRID(Model& model, int id, int cp, double x1, double x2, double x3, int cd, int ps) {
     int cpos = CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID;
     string scp;
     if (cp != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID){
@@ -81,12 +92,6 @@ void NastranParser::parseGRID(NastranTokenizer& tok, Model& model) {
         scp=" in CS"+to_string(cp)+"_"+to_string(cpos);
     }
 
-    double x1 = tok.nextDouble(true, 0.0);
-    double x2 = tok.nextDouble(true, 0.0);
-    double x3 = tok.nextDouble(true, 0.0);
-
-    /* Coordinate System for Displacement */
-    int cd = tok.nextInt(true, grdSet.cd);
     int cdos = CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID;
     string scd="";
     if (cd != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID){
@@ -95,13 +100,14 @@ void NastranParser::parseGRID(NastranTokenizer& tok, Model& model) {
     }
     model.mesh.addNode(id, x1, x2, x3, cpos, cdos);
 
-    int ps = tok.nextInt(true, grdSet.ps);
     if (ps) {
-        string spcName = "SPC" + to_string(id);
-        const auto& spc = make_shared<SinglePointConstraint>(model, DOFS::nastranCodeToDOFS(ps));
+        auto& spc = gridSpcByPs[ps];
+        if (spc == nullptr) {
+            spc = make_shared<SinglePointConstraint>(model, DOFS::nastranCodeToDOFS(ps));
+            model.add(spc);
+            model.addConstraintIntoConstraintSet(*spc, *model.commonConstraintSet);
+        }
         spc->addNodeId(id);
-        model.add(spc);
-        model.addConstraintIntoConstraintSet(*spc, *model.commonConstraintSet);
     }
 
     if (this->logLevel >= LogLevel::TRACE) {
@@ -438,23 +444,24 @@ void NastranParser::parseElem(NastranTokenizer& tok, Model& model,
         cellType = *it;
         it++;
     }
-    vector<int> nastranConnect;
-    nastranConnect.reserve(nodeIds.size());
-    nastranConnect.insert( nastranConnect.end(), nodeIds.begin(), nodeIds.end() );
-    vector<int> medConnect;
+    const vector<int> nastranConnect(nodeIds.begin(), nodeIds.end());
+    const vector<int>& medConnect = nastranToMedConnectivity(cellType, nastranConnect);
+    model.mesh.addCell(cell_id, cellType, medConnect, false, CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID, property_id);
+    addProperty(tok, property_id, cell_id, model);
+}
+
+vector<int> NastranParser::nastranToMedConnectivity(const CellType& cellType, const vector<int>& nastranConnect) {
     auto nastran2med_it = nastran2medNodeConnectByCellType.find(cellType.code);
     if (nastran2med_it == nastran2medNodeConnectByCellType.end()) {
-        medConnect = nastranConnect;
-    } else {
-        const auto& nastran2medNodeConnect = nastran2med_it->second;
-        medConnect.resize(cellType.numNodes);
-        for (unsigned int i2 = 0; i2 < cellType.numNodes; i2++) {
-            //model.mesh.findOrReserveNode(nastranConnect[i2], property_id); // LD this is optional : preserving cell nodeid order for better output readeability
-            medConnect[nastran2medNodeConnect[i2]] = nastranConnect[i2];
-        }
+        return nastranConnect;
     }
-    model.mesh.addCell(cell_id, cellType, medConnect, false, CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID, property_id);
-    addProperty(tok, property_id, cell_id, model);
+    const auto& nastran2medNodeConnect = nastran2med_it->second;
+    vector<int> medConnect(cellType.numNodes);
+    for (unsigned int i2 = 0; i2 < cellType.numNodes; i2++) {
+        //model.mesh.findOrReserveNode(nastranConnect[i2], property_id); // LD this is optional : preserving cell nodeid order for better output readeability
+        medConnect[nastran2medNodeConnect[i2]] = nastranConnect[i2];
+    }
+    return medConnect;
 }
 
 void NastranParser::parseCGAP(NastranTokenizer& tok, Model& model) {
@@ -640,6 +647,177 @@ void NastranParser::parseShellElem(NastranTokenizer& tok, Model& model,
 
 }
 
+bool NastranParser::decodeGeometryCard(NastranTokenizer& tok, parseElementFPtr parser, BulkChunk& chunk,
+        BulkCard& card) const {
+    static const vector<CellType> HEXA_TYPES = { CellType::HEXA8, CellType::HEXA20 };
+    static const vector<CellType> PENTA_TYPES = { CellType::PENTA6, CellType::PENTA15 };
+    static const vector<CellType> PYRAM_TYPES = { CellType::PYRA5, CellType::PYRA13 };
+    static const vector<CellType> QUAD_TYPES = { CellType::QUAD4, CellType::QUAD8, CellType::QUAD9 };
+    static const vector<CellType> TETRA_TYPES = { CellType::TETRA4, CellType::TETRA10 };
+
+    card.kind = BulkCard::Kind::CELL;
+    card.intStart = chunk.ints.size();
+    card.doubleStart = chunk.doubles.size();
+    bool decoded = false;
+    if (parser == &NastranParser::parseGRID) {
+        card.kind = BulkCard::Kind::GRID;
+        decoded = decodeGRID(tok, chunk);
+    } else if (parser == &NastranParser::parseCHEXA) {
+        decoded = decodeElem(tok, chunk, HEXA_TYPES, card);
+    } else if (parser == &NastranParser::parseCPENTA) {
+        decoded = decodeElem(tok, chunk, PENTA_TYPES, card);
+    } else if (parser == &NastranParser::parseCPYRAM) {
+        decoded = decodeElem(tok, chunk, PYRAM_TYPES, card);
+    } else if (parser == &NastranParser::parseCQUAD) {
+        decoded = decodeElem(tok, chunk, QUAD_TYPES, card);
+    } else if (parser == &NastranParser::parseCTETRA) {
+        decoded = decodeElem(tok, chunk, TETRA_TYPES, card);
+    } else if (parser == &NastranParser::parseCQUAD4 or parser == &NastranParser::parseCQUADR) {
+        card.cellType = &CellType::QUAD4;
+        decoded = decodeShellElem(tok, chunk, CellType::QUAD4);
+    } else if (parser == &NastranParser::parseCQUAD8) {
+        card.cellType = &CellType::QUAD8;
+        decoded = decodeShellElem(tok, chunk, CellType::QUAD8);
+    } else if (parser == &NastranParser::parseCTRIA3 or parser == &NastranParser::parseCTRIAR) {
+        card.cellType = &CellType::TRI3;
+        decoded = decodeShellElem(tok, chunk, CellType::TRI3);
+    } else if (parser == &NastranParser::parseCTRIA6) {
+        card.cellType = &CellType::TRI6;
+        decoded = decodeShellElem(tok, chunk, CellType::TRI6);
+    }
+    // Unparsed fields are reported by parseBULKCard
+    decoded = decoded and tok.isEmptyUntilNextKeyword();
+    if (not decoded) {
+        card.kind = BulkCard::Kind::REPLAY;
+        chunk.ints.resize(card.intStart);
+        chunk.doubles.resize(card.doubleStart);
+    }
+    return decoded;
+}
+
+bool NastranParser::decodeGRID(NastranTokenizer& tok, BulkChunk& chunk) const {
+    // CP, CD and PS default to the GRDSET in effect when the GRID is added to the model
+    int id, cp, cd, ps;
+    double x1, x2, x3;
+    if (not (tok.tryNextInt(id) and tok.tryNextInt(cp, true, Globals::UNAVAILABLE_INT)
+            and tok.tryNextDouble(x1, true, 0.0) and tok.tryNextDouble(x2, true, 0.0)
+            and tok.tryNextDouble(x3, true, 0.0) and tok.tryNextInt(cd, true, Globals::UNAVAILABLE_INT)
+            and tok.tryNextInt(ps, true, Globals::UNAVAILABLE_INT))) {
+        return false;
+    }
+    chunk.ints.insert(chunk.ints.end(), { id, cp, cd, ps });
+    chunk.doubles.insert(chunk.doubles.end(), { x1, x2, x3 });
+    return true;
+}
+
+bool NastranParser::decodeElem(NastranTokenizer& tok, BulkChunk& chunk, const vector<CellType>& cellTypes,
+        BulkCard& card) const {
+    int cell_id, property_id;
+    if (not (tok.tryNextInt(cell_id) and tok.tryNextInt(property_id, true, cell_id))) {
+        return false;
+    }
+    vector<int> nastranConnect;
+    while (tok.isNextInt()) {
+        int nodeId;
+        if (not tok.tryNextInt(nodeId)) {
+            return false;
+        }
+        nastranConnect.push_back(nodeId);
+    }
+    if (tok.isNextTHRU()) {
+        return false;
+    }
+    auto it = find_if(cellTypes.begin(), cellTypes.end(), [&nastranConnect](const CellType& cellType) {
+        return cellType.numNodes == nastranConnect.size();
+    });
+    if (it == cellTypes.end()) {
+        return false;
+    }
+    card.cellType = &*it;
+    chunk.ints.push_back(cell_id);
+    chunk.ints.push_back(property_id);
+    const vector<int>& medConnect = nastranToMedConnectivity(*it, nastranConnect);
+    chunk.ints.insert(chunk.ints.end(), medConnect.begin(), medConnect.end());
+    chunk.doubles.push_back(0.0);
+    return true;
+}
+
+bool NastranParser::decodeShellElem(NastranTokenizer& tok, BulkChunk& chunk, const CellType& cellType) const {
+    int cell_id, property_id;
+    if (not (tok.tryNextInt(cell_id) and tok.tryNextInt(property_id, true, cell_id))) {
+        return false;
+    }
+    chunk.ints.push_back(cell_id);
+    chunk.ints.push_back(property_id);
+
+    double thetaOrMCID = 0.0;
+    double zoffs = 0.0;
+    int tflag = 0;
+    bool isThereT = false;
+    auto readNodes = [&tok, &chunk](unsigned int count) {
+        for (unsigned int i = 0; i < count; i++) {
+            int nodeId;
+            if (not tok.tryNextInt(nodeId)) {
+                return false;
+            }
+            chunk.ints.push_back(nodeId);
+        }
+        return true;
+    };
+    auto readThicknesses = [&tok, &isThereT](unsigned int count) {
+        for (unsigned int i = 0; i < count; i++) {
+            double t;
+            if (not tok.tryNextDouble(t, true)) {
+                return false;
+            }
+            isThereT = isThereT or (!is_equal(t, Globals::UNAVAILABLE_DOUBLE));
+        }
+        return true;
+    };
+
+    // Same field layouts as parseShellElem
+    switch (cellType.code) {
+    case CellType::Code::TRI3_CODE:
+        if (not (readNodes(3) and tok.tryNextDouble(thetaOrMCID, true, 0.0) and tok.tryNextDouble(zoffs, true, 0.0))) {
+            return false;
+        }
+        tok.skip(2);
+        if (not (tok.tryNextInt(tflag, true, 0) and readThicknesses(3))) {
+            return false;
+        }
+        break;
+    case CellType::Code::QUAD4_CODE:
+        if (not (readNodes(4) and tok.tryNextDouble(thetaOrMCID, true, 0.0) and tok.tryNextDouble(zoffs, true, 0.0))) {
+            return false;
+        }
+        tok.skip(1);
+        if (not (tok.tryNextInt(tflag, true, 0) and readThicknesses(4))) {
+            return false;
+        }
+        break;
+    case CellType::Code::TRI6_CODE:
+        if (not (readNodes(6) and tok.tryNextDouble(thetaOrMCID, true, 0.0) and tok.tryNextDouble(zoffs, true, 0.0)
+                and readThicknesses(3) and tok.tryNextInt(tflag, true, 0))) {
+            return false;
+        }
+        break;
+    case CellType::Code::QUAD8_CODE:
+        if (not (readNodes(8) and readThicknesses(4) and tok.tryNextDouble(thetaOrMCID, true, 0.0)
+                and tok.tryNextDouble(zoffs, true, 0.0) and tok.tryNextInt(tflag, true, 0))) {
+            return false;
+        }
+        break;
+    default:
+        return false;
+    }
+    // These are reported as warnings by parseShellElem
+    if (!is_zero(thetaOrMCID) or tflag != 0 or isThereT) {
+        return false;
+    }
+    chunk.doubles.push_back(zoffs);
+    return true;
+}
+
 /*
  * Defining DOFS::DX should suffice for VEGA to know, during the translation
  * that these GRID points have only one DOF. It's not the case, so we create SPC to
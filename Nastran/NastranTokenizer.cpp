@@ -9,7 +9,6 @@
  */
 
 #include <boost/algorithm/string.hpp>
-#include <boost/tokenizer.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <iostream>
@@ -18,15 +17,14 @@
 #include <vector>
 #include <fstream>
 #include <algorithm>
+#include <cstring>
+#include <cstdlib>
 #include "NastranTokenizer.h"
 #include "../Abstract/SolverInterfaces.h"
 #include <ciso646>
 
 using namespace std;
-using boost::tokenizer;
-using boost::offset_separator;
 using boost::lexical_cast;
-using boost::trim_copy;
 
 namespace vega {
 
@@ -39,6 +37,13 @@ NastranTokenizer::NastranTokenizer(istream& stream, vega::LogLevel logLevel, con
 		nextSymbolType{SymbolType::SYMBOL_KEYWORD} {
 }
 
+NastranTokenizer::NastranTokenizer(const char* begin, const char* end, vega::LogLevel logLevel, const string fileName,
+		const vega::ConfigurationParameters::TranslationMode translationMode) :
+		Tokenizer(logLevel, fileName, translationMode),
+		currentField(0), bufferCursor(begin), bufferEnd(end), currentSection(SectionType::SECTION_EXECUTIVE),
+		nextSymbolType{SymbolType::SYMBOL_KEYWORD} {
+}
+
 const string NastranTokenizer::HM_COMMENT_START = "$HMNAME ";
 
 const map<string, NastranTokenizer::CommentType> NastranTokenizer::commentTypeByString = {
@@ -61,10 +66,77 @@ const map<string, NastranTokenizer::CommentType> NastranTokenizer::commentTypeBy
         { "VECTORCOL", CommentType::VECTORCOL },
 };
 
-NastranTokenizer::LineType NastranTokenizer::getLineType(const string& line) {
-	const string beginning = line.substr(0, 8);
-	if (beginning.find(",") == string::npos) {
-		if (beginning.find("*") == string::npos) {
+boost::string_ref NastranTokenizer::trim(boost::string_ref field) {
+	while (not field.empty() and isspace(static_cast<unsigned char>(field.front()))) {
+		field.remove_prefix(1);
+	}
+	while (not field.empty() and isspace(static_cast<unsigned char>(field.back()))) {
+		field.remove_suffix(1);
+	}
+	return field;
+}
+
+void NastranTokenizer::split(const boost::string_ref line, const boost::string_ref separators, bool compress,
+		vector<boost::string_ref>& fields) {
+	auto isSeparator = [&separators](char c) {return separators.find(c) != boost::string_ref::npos;};
+	size_t start = 0;
+	for (size_t i = 0; i < line.size(); ++i) {
+		if (not isSeparator(line[i])) {
+			continue;
+		}
+		fields.push_back(line.substr(start, i - start));
+		if (compress) {
+			while (i + 1 < line.size() and isSeparator(line[i + 1])) {
+				++i;
+			}
+		}
+		start = i + 1;
+	}
+	fields.push_back(line.substr(start));
+}
+
+bool NastranTokenizer::readRawLine(boost::string_ref& line) {
+	if (this->instrream == nullptr) {
+		if (bufferCursor == bufferEnd) {
+			return false;
+		}
+		lastLineBegin = bufferCursor;
+		const size_t remaining = static_cast<size_t>(bufferEnd - bufferCursor);
+		const char* lineEnd = static_cast<const char*>(memchr(bufferCursor, '\n', remaining));
+		if (lineEnd == nullptr) {
+			line = boost::string_ref(bufferCursor, remaining);
+			bufferCursor = bufferEnd;
+		} else {
+			line = boost::string_ref(bufferCursor, static_cast<size_t>(lineEnd - bufferCursor));
+			bufferCursor = lineEnd + 1;
+		}
+	} else {
+		string streamLine;
+		if (not getline(*this->instrream, streamLine)) {
+			return false;
+		}
+		line = storeLine(move(streamLine));
+	}
+	lineNumber += 1;
+	return true;
+}
+
+char NastranTokenizer::peekChar() const {
+	if (this->instrream == nullptr) {
+		return bufferCursor == bufferEnd ? static_cast<char>(EOF) : *bufferCursor;
+	}
+	return static_cast<char>(this->instrream->peek());
+}
+
+boost::string_ref NastranTokenizer::storeLine(string&& line) {
+	lineStorage.push_back(move(line));
+	return lineStorage.back();
+}
+
+NastranTokenizer::LineType NastranTokenizer::getLineType(const boost::string_ref line) {
+	const boost::string_ref beginning = line.substr(0, 8);
+	if (beginning.find(',') == boost::string_ref::npos) {
+		if (beginning.find('*') == boost::string_ref::npos) {
 			return LineType::SHORT_FORMAT;
 		} else {
 			return LineType::LONG_FORMAT;
@@ -99,17 +171,14 @@ void NastranTokenizer::replaceTabs(string& line, bool longFormat) {
 }
 
 
-string NastranTokenizer::nextSymbolString() {
+boost::string_ref NastranTokenizer::nextSymbolView() {
 
     if (this->currentField >= this->currentLineVector.size()){
         this->nextSymbolType = SymbolType::SYMBOL_KEYWORD;
-        return "";
+        return boost::string_ref();
     }
 
-    string result = boost::trim_right_copy(currentLineVector[currentField]);
-    if (this->nextSymbolType == SymbolType::SYMBOL_KEYWORD) {
-        boost::to_upper(result);
-    }
+    const boost::string_ref result = currentLineVector[currentField];
     this->nextSymbolType = SymbolType::SYMBOL_FIELD;
     this->currentField++;
     if (this->currentField >= this->currentLineVector.size()){
@@ -119,17 +188,23 @@ string NastranTokenizer::nextSymbolString() {
     return result;
 }
 
-bool NastranTokenizer::readLineSkipComment(string& line, bool firstLine) {
+string NastranTokenizer::nextSymbolString() {
+    const bool isKeyword = this->nextSymbolType == SymbolType::SYMBOL_KEYWORD;
+    string result = nextSymbolView().to_string();
+    if (isKeyword) {
+        boost::to_upper(result);
+    }
+    return result;
+}
+
+bool NastranTokenizer::readLineSkipComment(boost::string_ref& line, bool firstLine) {
 	bool eof = true;
-	while (getline(this->instrream, line)) {
-		lineNumber += 1;
+	while (readRawLine(line)) {
 		bool blankLine = all_of(line.begin(), line.end(), [](int c) {return isblank(c);});
 		if (not line.empty() and not blankLine and line[0] != '$') {
-			boost::iterator_range<string::iterator> middle_dollar = boost::find_first(line, "$");
-			if (middle_dollar) {
-				boost::erase_tail(line,
-						static_cast<int>(line.size())
-								- static_cast<int>(distance(line.begin(), middle_dollar.begin())));
+			const size_t middle_dollar = line.find('$');
+			if (middle_dollar != boost::string_ref::npos) {
+				line = line.substr(0, middle_dollar);
 			}
 			//if the line is not blank exit the loop
 			if (!boost::all(line, [](int c) { return isblank(c); })){
@@ -140,9 +215,9 @@ bool NastranTokenizer::readLineSkipComment(string& line, bool firstLine) {
             eof = false;
             break;
 		} else if (boost::starts_with(line, HM_COMMENT_START)) {
-		    boost::erase_head(line, static_cast<int>(HM_COMMENT_START.size()));
+		    const string comment(line.begin() + HM_COMMENT_START.size(), line.end());
 		    vector<string> commentParts;
-		    boost::split(commentParts, line, boost::is_any_of(" \""), boost::token_compress_on);
+		    boost::split(commentParts, comment, boost::is_any_of(" \""), boost::token_compress_on);
             if (commentParts.size() >= 3) {
                 bool isPart2Int = all_of(commentParts[1].begin(), commentParts[1].end(), ::isdigit);
                 auto result = commentTypeByString.find(commentParts[0]);
@@ -152,36 +227,42 @@ bool NastranTokenizer::readLineSkipComment(string& line, bool firstLine) {
             }
 		}
 	}
+	if (eof) {
+		line = boost::string_ref();
+	}
 	return eof;
 }
 
-void NastranTokenizer::splitFreeFormat(string line, bool firstLine) {
+void NastranTokenizer::splitFreeFormat(const boost::string_ref line, bool firstLine) {
+	const size_t firstField = currentLineVector.size();
 	if (firstLine) {
-		split(currentLineVector, line, boost::is_any_of(","));
+		split(line, ",", false, currentLineVector);
 	} else {
 		//skip first field;
-		string lineNoContinuation = line.substr(line.find(',') + 1);
-		vector<string> otherLine;
-		split(otherLine, lineNoContinuation, boost::is_any_of(","));
-		currentLineVector.insert(currentLineVector.end(), otherLine.begin(), otherLine.end());
+		const size_t continuationEnd = line.find(',');
+		split(continuationEnd == boost::string_ref::npos ? line : line.substr(continuationEnd + 1), ",", false,
+				currentLineVector);
+	}
+	for (size_t fieldIndex = firstField; fieldIndex < currentLineVector.size(); fieldIndex++) {
+		currentLineVector[fieldIndex] = trim(currentLineVector[fieldIndex]);
 	}
 	bool explicitContinuation = false;
 	for (size_t fieldIndex = 1; fieldIndex < currentLineVector.size(); fieldIndex += 8) {
-		string field = trim_copy(currentLineVector[fieldIndex]);
-		if (field[0] == '+') {
+		const boost::string_ref field = currentLineVector[fieldIndex];
+		if (not field.empty() and field[0] == '+') {
 			explicitContinuation = true;
-			currentLineVector.erase(currentLineVector.begin() + fieldIndex);
+			currentLineVector.erase(currentLineVector.begin() + static_cast<long>(fieldIndex));
 		}
 	}
-	char c = static_cast<char>(this->instrream.peek());
-    string line2;
+	char c = peekChar();
+    boost::string_ref line2;
     if (explicitContinuation || c == ',' || c == '+' || c == '*') {
 		readLineSkipComment(line2, false);
 		splitFreeFormat(line2, false);
 	}
 }
 
-void NastranTokenizer::parseBulkSectionLine(string line) {
+void NastranTokenizer::parseBulkSectionLine(const boost::string_ref line) {
 	LineType lineType = getLineType(line);
 	switch (lineType) {
 	case LineType::LONG_FORMAT:
@@ -218,42 +299,43 @@ void NastranTokenizer::bulkSection() {
 }
 
 void NastranTokenizer::parseParameters() {
-	split(currentLineVector, this->currentLine, boost::is_any_of("\\="));
+	currentLineVector.clear();
+	split(this->currentLine, "\\=", false, currentLineVector);
 }
 
 bool NastranTokenizer::isNextInt() {
 	if (nextSymbolType != SymbolType::SYMBOL_FIELD) {
 		return false;
 	}
-	string curField = trim_copy(currentLineVector[currentField]);
-	return !curField.empty() && (strspn(curField.c_str(), "-0123456789") == curField.size());
+	const boost::string_ref curField = currentLineVector[currentField];
+	return !curField.empty() && all_of(curField.begin(), curField.end(), [](char c) {
+		return c == '-' || isdigit(static_cast<unsigned char>(c));
+	});
 }
 
 bool NastranTokenizer::isNextTHRU() {
 	if (nextSymbolType != SymbolType::SYMBOL_FIELD) {
 		return false;
 	}
-	string curField = trim_copy(currentLineVector[currentField]);
-	boost::to_upper(curField);
-	return curField == "THRU";
+	return boost::iequals(currentLineVector[currentField], "THRU");
 }
 
 bool NastranTokenizer::isNextBY() {
 	if (nextSymbolType != SymbolType::SYMBOL_FIELD) {
 		return false;
 	}
-	string curField = trim_copy(currentLineVector[currentField]);
-	boost::to_upper(curField);
-	return curField == "BY";
+	return boost::iequals(currentLineVector[currentField], "BY");
 }
 
 bool NastranTokenizer::isNextDouble() {
 	if (nextSymbolType != SymbolType::SYMBOL_FIELD) {
 		return false;
 	}
-	string curField = trim_copy(currentLineVector[currentField]);
-	boost::algorithm::erase_all(curField, " ");
-	return !curField.empty() && (strspn(curField.c_str(), "-+0123456789.eEdD") == curField.size());
+	// fields are trimmed: not empty means at least one character which is not a blank
+	const boost::string_ref curField = currentLineVector[currentField];
+	return !curField.empty() && all_of(curField.begin(), curField.end(), [](char c) {
+		return c == ' ' || strchr("-+0123456789.eEdD", c) != nullptr;
+	});
 }
 
 bool NastranTokenizer::isNextEmpty(int n) {
@@ -263,8 +345,7 @@ bool NastranTokenizer::isNextEmpty(int n) {
             result = false;
             break;
         }
-        string curField = trim_copy(currentLineVector[currentField + i]);
-        result &= curField.empty();
+        result &= currentLineVector[currentField + i].empty();
     }
 	return result;
 }
@@ -277,8 +358,7 @@ bool NastranTokenizer::isEmptyUntilNextKeyword() {
 	}
 	bool result = true;
 	for (size_t i = currentField; i < this->currentLineVector.size() && result; i++) {
-		string curField = trim_copy(currentLineVector[i]);
-		result &= curField.empty();
+		result &= currentLineVector[i].empty();
 	}
 	return result;
 }
@@ -291,7 +371,7 @@ string NastranTokenizer::remainingTextUntilNextKeyword() {
 	}
     ostringstream oss;
 	for (size_t i = currentField; i < this->currentLineVector.size(); i++) {
-        string curfield = trim_copy(currentLineVector[i]);
+        const boost::string_ref curfield = currentLineVector[i];
         if (!curfield.empty()) {
             oss << "," << curfield;
         }
@@ -305,13 +385,16 @@ void NastranTokenizer::nextLine() {
 //enough in 99% of lines
 	currentLineVector.reserve(128);
 	currentField = 0;
+	lineStorage.clear();
 
 	bool iseof = readLineSkipComment(this->currentLine, true);
 	if (!iseof) {
+		cardBegin = lastLineBegin;
+		cardLineNumber = lineNumber;
 		switch (currentSection) {
 		case SectionType::SECTION_EXECUTIVE:
-			boost::algorithm::trim(this->currentLine);
-			split(currentLineVector, this->currentLine, boost::is_any_of("\t\\= "), boost::algorithm::token_compress_on);
+			this->currentLine = trim(this->currentLine);
+			split(this->currentLine, "\t\\= ", true, currentLineVector);
 			break;
 		case SectionType::SECTION_BULK:
 			parseBulkSectionLine(this->currentLine);
@@ -325,52 +408,71 @@ void NastranTokenizer::nextLine() {
 	}
 }
 
-void NastranTokenizer::splitFixedFormat(string& line, const bool longFormat, const bool firstLine) {
-	boost::offset_separator f;
-
-	int fieldMax;
-	if (longFormat) {
-		int offsets[] = { SFSIZE, LFSIZE, LFSIZE, LFSIZE, LFSIZE, SFSIZE };
-		fieldMax = 5;
-		f = offset_separator(offsets, offsets + 6);
-	} else {
-		int offsets[] = { SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE };
-		fieldMax = 9;
-		f = offset_separator(offsets, offsets + 10);
+void NastranTokenizer::seek(const char* position, int lineNumber) {
+	if (this->instrream != nullptr) {
+		throw logic_error("Only a tokenizer reading from memory can seek");
 	}
+	bufferCursor = position;
+	this->lineNumber = lineNumber;
+	currentLineVector.clear();
+	currentField = 0;
+	this->nextSymbolType = SymbolType::SYMBOL_KEYWORD;
+}
 
-	replaceTabs(line, longFormat);
-	tokenizer<offset_separator> tok(line, f);
-	tokenizer<offset_separator>::iterator beg = tok.begin();
+void NastranTokenizer::splitFixedFormat(boost::string_ref line, const bool longFormat, const bool firstLine) {
+	static const size_t longOffsets[] = { SFSIZE, LFSIZE, LFSIZE, LFSIZE, LFSIZE, SFSIZE };
+	static const size_t shortOffsets[] = { SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE };
+	const size_t* offsets = longFormat ? longOffsets : shortOffsets;
+	const size_t offsetCount = longFormat ? 6 : 10;
+	const int fieldMax = longFormat ? 5 : 9;
+
+	if (line.find('\t') != boost::string_ref::npos) {
+		string expandedLine = line.to_string();
+		replaceTabs(expandedLine, longFormat);
+		line = storeLine(move(expandedLine));
+	}
+	// Same slicing as a boost::offset_separator: offsets are wrapped, the last field may be partial
+	size_t linePosition = 0;
+	size_t offsetIndex = 0;
+	auto nextSlice = [&](boost::string_ref& slice) {
+		if (linePosition >= line.size()) {
+			return false;
+		}
+		slice = line.substr(linePosition, offsets[offsetIndex++ % offsetCount]);
+		linePosition += slice.size();
+		return true;
+	};
+	boost::string_ref slice;
 	int count = 0;
 	if (!firstLine) {
 		//todo:check that explicit continuation tokens are the same
-		++beg;
+		nextSlice(slice);
 		count++;
 	}
 	bool explicitContinuation = false;
-	for (; beg != tok.end(); ++beg) {
-		string trimCopy = trim_copy(*beg);
+	while (nextSlice(slice)) {
+		boost::string_ref field = trim(slice);
 		//erase all the long format specifiers
-		if (count == 0) {
-			boost::erase_all(trimCopy, "*");
+		if (count == 0 and field.find('*') != boost::string_ref::npos) {
+			string keyword = field.to_string();
+			boost::erase_all(keyword, "*");
+			field = storeLine(move(keyword));
 		}
-		currentLineVector.push_back(trimCopy);
+		currentLineVector.push_back(field);
 		if (++count == fieldMax) {
-			explicitContinuation = (++beg != tok.end()) && !(trim_copy(*beg).empty());
+			explicitContinuation = nextSlice(slice) && !(trim(slice).empty());
 			if (explicitContinuation && this->logLevel >= vega::LogLevel::TRACE) {
 				cout << "explicitContinuation" << endl;
 			}
 			break;
 		}
 	}
-	string line2;
-	char c0 = static_cast<char>(this->instrream.peek());
+	boost::string_ref line2;
+	char c0 = peekChar();
 
 	while (c0 == '$') { // Trying to skip "comment inside card case"
-        getline(this->instrream, line2);
-        lineNumber += 1;
-        c0 = static_cast<char>(this->instrream.peek());
+        readRawLine(line2);
+        c0 = peekChar();
     }
 
 	if (explicitContinuation or c0 == '+') {
@@ -385,12 +487,12 @@ void NastranTokenizer::splitFixedFormat(string& line, const bool longFormat, con
 		/** Test for automatic continuation : we allow tabulation
 		 *  Even if it's, strictly speaking, not authorized by Nastran
 		 */
-		char c = static_cast<char>(this->instrream.peek());
+		char c = peekChar();
 		if (c == ' ' || c == '+' || c == '*' || c=='\t') {
 			readLineSkipComment(line2, false);
 			//fill the current line with empty fields
 			for (; count < fieldMax; count++) {
-				currentLineVector.push_back("");
+				currentLineVector.push_back(boost::string_ref());
 			}
 			bool longFormat2 = (c == '*');
 			splitFixedFormat(line2, longFormat2, false);
@@ -400,7 +502,7 @@ void NastranTokenizer::splitFixedFormat(string& line, const bool longFormat, con
 }
 
 string NastranTokenizer::nextString(bool returnDefaultIfNotFoundOrBlank, string defaultValue) {
-    string value =  trim_copy(nextSymbolString());
+    string value = nextSymbolString();
     boost::to_upper(value);
     if (value.empty()) {
         if (returnDefaultIfNotFoundOrBlank){
@@ -441,7 +543,7 @@ void NastranTokenizer::skipToNextKeyword() {
 
 int NastranTokenizer::nextInt(bool returnDefaultIfNotFoundOrBlank, int defaultValue) {
 	int result = 0;
-	string value = trim_copy(nextSymbolString());
+	const boost::string_ref value = nextSymbolView();
 	if (value.empty()) {
 	    if (returnDefaultIfNotFoundOrBlank){
 	        return defaultValue;
@@ -450,12 +552,10 @@ int NastranTokenizer::nextInt(bool returnDefaultIfNotFoundOrBlank, int defaultVa
 	        handleParsingError(message);
 	    }
 	}
-	try {
-		result = lexical_cast<int>(value);
-	} catch (boost::bad_lexical_cast &) {
+	if (not decodeInt(value, result)) {
 		string currentFieldstr =
 				currentField == 0 ? "LAST" : to_string(currentField - 1);
-		string message = "Value [" + value + "] can't be converted to int. Field Num: "
+		string message = "Value [" + value.to_string() + "] can't be converted to int. Field Num: "
 				+ currentFieldstr;
 		handleParsingError(message);
 	}
@@ -499,7 +599,7 @@ list<double> NastranTokenizer::nextDoubles() {
 
 double NastranTokenizer::nextDouble(bool returnDefaultIfNotFoundOrBlank, double defaultValue) {
 	double result = 0.0;
-	string value = trim_copy(nextSymbolString());
+	const boost::string_ref value = nextSymbolView();
 	if (value.empty()) {
 	    if (returnDefaultIfNotFoundOrBlank) {
 	        return defaultValue;
@@ -509,31 +609,201 @@ double NastranTokenizer::nextDouble(bool returnDefaultIfNotFoundOrBlank, double
 	    }
 	}
 
-	boost::replace_all(value, "d", "e");
-	boost::replace_all(value, "D", "E");
-	boost::algorithm::erase_all(value, " ");
-	size_t position = value.find_first_of("+-", 1);
-	if (position != string::npos and position != value.find_first_of("eE", 1) + 1) {
-		value.insert(position, "E");
-	}
-	try {
-		result = lexical_cast<double>(value);
-	} catch (boost::bad_lexical_cast &) {
+	if (not decodeDouble(value, result)) {
 		string currentFieldstr =
 				currentField == 0 ? "LAST" : to_string(currentField - 1);
-		string message = "Value [" + value + "] can't be converted to double. Field Num: "
+		string message = "Value [" + value.to_string() + "] can't be converted to double. Field Num: "
 				+ currentFieldstr;
 		handleParsingError(message);
 	}
 	return result;
 }
 
+bool NastranTokenizer::tryNextInt(int& value, bool returnDefaultIfNotFoundOrBlank, int defaultValue) {
+	const boost::string_ref field = nextSymbolView();
+	if (field.empty()) {
+		if (returnDefaultIfNotFoundOrBlank) {
+			value = defaultValue;
+		}
+		return returnDefaultIfNotFoundOrBlank;
+	}
+	return decodeInt(field, value);
+}
+
+bool NastranTokenizer::tryNextDouble(double& value, bool returnDefaultIfNotFoundOrBlank, double defaultValue) {
+	const boost::string_ref field = nextSymbolView();
+	if (field.empty()) {
+		if (returnDefaultIfNotFoundOrBlank) {
+			value = defaultValue;
+		}
+		return returnDefaultIfNotFoundOrBlank;
+	}
+	return decodeDouble(field, value);
+}
+
+bool NastranTokenizer::decodeInt(const boost::string_ref field, int& value) {
+	size_t i = 0;
+	bool negative = false;
+	if (not field.empty() and (field[0] == '+' or field[0] == '-')) {
+		negative = field[0] == '-';
+		i++;
+	}
+	if (i == field.size()) {
+		return false;
+	}
+	const long long limit = static_cast<long long>(numeric_limits<int>::max()) + (negative ? 1 : 0);
+	long long result = 0;
+	for (; i < field.size(); i++) {
+		const char c = field[i];
+		if (c < '0' or c > '9') {
+			return false;
+		}
+		result = result * 10 + (c - '0');
+		if (result > limit) {
+			return false;
+		}
+	}
+	value = static_cast<int>(negative ? -result : result);
+	return true;
+}
+
+bool NastranTokenizer::decodeDouble(const boost::string_ref field, double& value) {
+	// Exactly representable powers of ten: with a mantissa below 2^53 a single
+	// multiplication or division gives the correctly rounded result.
+	static const double EXACT_POWERS_OF_TEN[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+			1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+	static const int MAX_EXACT_POWER = 22;
+	static const unsigned long long MAX_EXACT_MANTISSA = 1ULL << 53;
+	static const int MAX_MANTISSA_DIGITS = 19;
+
+	// Normalized copy of the field ("-1.5E-3"), only used when the fast path is not exact
+	char normalized[64];
+	size_t length = 0;
+	auto append = [&normalized, &length](char c) {
+		if (length < sizeof(normalized)) {
+			normalized[length] = c;
+		}
+		length++;
+	};
+	size_t i = 0;
+	auto current = [&field, &i]() {
+		while (i < field.size() and field[i] == ' ') {
+			i++;
+		}
+		return i < field.size() ? field[i] : '\0';
+	};
+
+	bool negative = false;
+	char c = current();
+	if (c == '+' or c == '-') {
+		negative = c == '-';
+		append(c);
+		i++;
+		c = current();
+	}
+	unsigned long long mantissa = 0;
+	int mantissaDigits = 0;
+	int exponent = 0;
+	bool hasDigit = false;
+	bool truncated = false;
+	bool fraction = false;
+	for (;; c = current()) {
+		if (c >= '0' and c <= '9') {
+			hasDigit = true;
+			if (mantissa == 0 and c == '0') {
+				// leading zeros are not significant
+				exponent -= fraction ? 1 : 0;
+			} else if (mantissaDigits < MAX_MANTISSA_DIGITS) {
+				mantissa = mantissa * 10 + static_cast<unsigned long long>(c - '0');
+				mantissaDigits++;
+				exponent -= fraction ? 1 : 0;
+			} else {
+				truncated = true;
+			}
+		} else if (c == '.' and not fraction) {
+			fraction = true;
+		} else {
+			break;
+		}
+		append(c);
+		i++;
+	}
+	if (not hasDigit) {
+		return false;
+	}
+
+	bool hasExponent = false;
+	if (c == 'E' or c == 'e' or c == 'D' or c == 'd') {
+		hasExponent = true;
+		i++;
+		c = current();
+	} else if (c == '+' or c == '-') {
+		// implicit exponent: "1.5-3"
+		hasExponent = true;
+	} else if (c != '\0') {
+		return false;
+	}
+	if (hasExponent) {
+		append('E');
+		bool negativeExponent = false;
+		if (c == '+' or c == '-') {
+			negativeExponent = c == '-';
+			append(c);
+			i++;
+			c = current();
+		}
+		if (c < '0' or c > '9') {
+			return false;
+		}
+		int exponentValue = 0;
+		for (; c >= '0' and c <= '9'; c = current()) {
+			// saturate: anything above is an overflow or an underflow anyway
+			exponentValue = min(exponentValue * 10 + (c - '0'), 100000);
+			append(c);
+			i++;
+		}
+		if (c != '\0') {
+			return false;
+		}
+		exponent += negativeExponent ? -exponentValue : exponentValue;
+	}
+
+	if (mantissa == 0 and not truncated) {
+		value = negative ? -0.0 : 0.0;
+		return true;
+	}
+	if (not truncated and mantissa <= MAX_EXACT_MANTISSA and abs(exponent) <= MAX_EXACT_POWER) {
+		double result = static_cast<double>(mantissa);
+		if (exponent < 0) {
+			result /= EXACT_POWERS_OF_TEN[-exponent];
+		} else {
+			result *= EXACT_POWERS_OF_TEN[exponent];
+		}
+		value = negative ? -result : result;
+		return true;
+	}
+	if (length > sizeof(normalized)) {
+		return false;
+	}
+	try {
+		value = lexical_cast<double>(normalized, length);
+	} catch (boost::bad_lexical_cast &) {
+		return false;
+	}
+	return true;
+}
+
 vector<string> NastranTokenizer::currentDataLine() const {
-	return currentLineVector;
+	vector<string> dataLine;
+	dataLine.reserve(currentLineVector.size());
+	for (const auto& field : currentLineVector) {
+		dataLine.push_back(field.to_string());
+	}
+	return dataLine;
 }
 
 string NastranTokenizer::currentRawDataLine() const {
-	return this->currentLine;
+	return this->currentLine.to_string();
 }
 
 } /* namespace nastran */
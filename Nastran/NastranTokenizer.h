@@ -27,8 +27,10 @@
 #include <string>
 #include <fstream>
 #include <vector>
+#include <deque>
 #include <iostream>
 #include <limits>
+#include <boost/utility/string_ref.hpp>
 #include "../Abstract/ConfigurationParameters.h"
 #include "../Abstract/SolverInterfaces.h"
 
@@ -70,24 +72,49 @@ private:
     static const std::map<std::string, CommentType> commentTypeByString;
 
     unsigned int currentField;   /**< Current position of the Tokenizer, i.e, the next field to be interpreted **/
-    std::vector<std::string> currentLineVector;
-    std::string currentLine = "";
+    std::vector<boost::string_ref> currentLineVector; /**< Trimmed fields of the current card, pointing into the input buffer or into lineStorage **/
+    boost::string_ref currentLine;
+    std::deque<std::string> lineStorage; /**< Owns the lines read from a stream and the rewritten fields of the current card **/
+    const char* bufferCursor = nullptr; /**< Next character to read when reading from memory **/
+    const char* bufferEnd = nullptr;
+    const char* lastLineBegin = nullptr; /**< Start of the last line read from memory **/
+    const char* cardBegin = nullptr; /**< Start of the first line of the current card, when reading from memory **/
+    int cardLineNumber = 0; /**< Line number of the first line of the current card **/
 
-    NastranTokenizer::LineType getLineType(const std::string& line); /**< Determine the LineType of the line.**/
+    /**
+     * Read the next physical line, from the stream or from the memory buffer.
+     * Return false if the end of the input has been reached.
+     */
+    bool readRawLine(boost::string_ref& line);
+    char peekChar() const;
+    boost::string_ref storeLine(std::string&& line); /**< Keep a line alive until the next card is read. **/
+
+    NastranTokenizer::LineType getLineType(const boost::string_ref line); /**< Determine the LineType of the line.**/
     void replaceTabs(std::string &line, bool longFormat); /**< Replace all tabulation by the needed number of space. **/
 
-    void splitFixedFormat(std::string& line, bool longFormat, bool firstLine);
+    void splitFixedFormat(boost::string_ref line, bool longFormat, bool firstLine);
 
-    bool readLineSkipComment(std::string& line, bool firstLine);
-    void splitFreeFormat(std::string line, bool firstLine);
-    void parseBulkSectionLine(std::string line);
+    bool readLineSkipComment(boost::string_ref& line, bool firstLine);
+    void splitFreeFormat(const boost::string_ref line, bool firstLine);
+    void parseBulkSectionLine(const boost::string_ref line);
     void parseParameters();
 
+    static boost::string_ref trim(boost::string_ref field);
+    /**
+     * Split a line at each of the separators, appending the pieces to fields.
+     * Same behavior as boost::split, without copying the pieces.
+     */
+    static void split(const boost::string_ref line, const boost::string_ref separators, bool compress, std::vector<boost::string_ref>& fields);
+
+    /**
+     * Return the next symbol to be interpreted, as a slice of the input, and advances to next field
+     * Return a void slice if it's the end of the line.
+     */
+    boost::string_ref nextSymbolView();
     /**
      * Return the next symbol to be interpreted, as a string (trimmed + uppercase), and advances to next field
      * Return a void string if it's the end of the line.
      */
-    //string nextBulkString();
     std::string nextSymbolString();
 
 public:
@@ -109,6 +136,13 @@ public:
     NastranTokenizer(std::istream& stream, vega::LogLevel logLevel = vega::LogLevel::INFO,
             const std::string fileName = "UNKNOWN",
             const vega::ConfigurationParameters::TranslationMode translationMode = vega::ConfigurationParameters::TranslationMode::BEST_EFFORT);
+    /**
+     * Tokenizer over an in-memory input, typically a MappedFile. Fields are handed out as slices of
+     * the buffer, which must outlive the tokenizer.
+     */
+    NastranTokenizer(const char* begin, const char* end, vega::LogLevel logLevel = vega::LogLevel::INFO,
+            const std::string fileName = "UNKNOWN",
+            const vega::ConfigurationParameters::TranslationMode translationMode = vega::ConfigurationParameters::TranslationMode::BEST_EFFORT);
     virtual ~NastranTokenizer() = default;
     NastranTokenizer(const NastranTokenizer& that) = delete;
 
@@ -164,6 +198,29 @@ public:
     double nextDouble(bool returnDefaultIfNotFoundOrBlank = false, double defaultValue =
             Globals::UNAVAILABLE_DOUBLE);
 
+    /**
+     * Convert a Nastran real field in a single pass, without temporary strings.
+     * Blanks are ignored, the exponent can be introduced by E or D or be implicit
+     * ("1.5-3" is 1.5E-3).
+     * @return false if the field is not a valid real, value is then left untouched.
+     */
+    static bool decodeDouble(const boost::string_ref field, double& value);
+    /**
+     * Convert a Nastran integer field, with an optional sign.
+     * @return false if the field is not a valid integer, value is then left untouched.
+     */
+    static bool decodeInt(const boost::string_ref field, int& value);
+    /**
+     * Same as nextInt, but report a missing or invalid field by returning false instead of
+     * raising a parsing error. The field is consumed in any case.
+     */
+    bool tryNextInt(int& value, bool returnDefaultIfNotFoundOrBlank = false, int defaultValue = Globals::UNAVAILABLE_INT);
+    /**
+     * Same as nextDouble, but report a missing or invalid field by returning false instead of
+     * raising a parsing error. The field is consumed in any case.
+     */
+    bool tryNextDouble(double& value, bool returnDefaultIfNotFoundOrBlank = false, double defaultValue = Globals::UNAVAILABLE_DOUBLE);
+
     /**
      * Skip at most n fields. It stops if end of line is reached.
      * @param fieldNum
@@ -192,6 +249,18 @@ public:
      */
     void nextLine();
 
+    /**
+     * Start of the current card in the input buffer, nullptr when reading from a stream.
+     */
+    inline const char* currentCardBegin() const noexcept {return cardBegin;};
+    inline int currentCardLineNumber() const noexcept {return cardLineNumber;};
+    inline const char* inputEnd() const noexcept {return bufferEnd;};
+    /**
+     * Move a tokenizer reading from memory to the start of a line of its input: the next call
+     * to nextLine() reads the card beginning there. lineNumber is the number of the line before.
+     */
+    void seek(const char* position, int lineNumber);
+
 };
 
 } /* namespace nastran */
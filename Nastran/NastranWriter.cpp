@@ -18,10 +18,13 @@
 #include <string>
 #include <fstream>
 #include <limits>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <ciso646>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string.hpp>
-#include <boost/format.hpp>
 
 namespace fs = boost::filesystem;
 using namespace std;
@@ -64,57 +67,123 @@ Line& Line::add() noexcept {
 	return *this;
 }
 
-Line& Line::add(double value) noexcept {
-	std::ostringstream strs;
+size_t Line::formatReal(double value, unsigned int width, char* buffer) noexcept {
 	if (is_zero(value)) {
-        strs << "0.";
-	} else {
-	    // https://github.com/SteveDoyle2/pyNastran/blob/master/pyNastran/bdf/field_writer_8.py
-	    string str1 = str(boost::format("%8.11e") % value);
-	    boost::algorithm::trim(str1);
-	    size_t pos = str1.find("e");
-	    double mant = stod(str1.substr(0, pos));
-	    string exp2 = to_string(stoi(str1.substr(pos + 1))); // "00" becomes 0, "01" becomes 1 etc.
-	    boost::algorithm::trim_left_if(exp2, boost::is_any_of("-+"));
-	    char sign = abs(value) < 1. ? '-' : '+';
-	    size_t leftover = 5 - exp2.size();
-	    leftover -= value < 0 ? 1 : 0;
-	    const string fmt = str(boost::format("%%1.%sf") % leftover);
-        string svalue3 = str(boost::format(fmt) % mant);
-        boost::algorithm::trim_if(svalue3, boost::is_any_of("0"));
-        strs << boost::format("%8s") % (svalue3 + sign + exp2);
+		buffer[0] = '0';
+		buffer[1] = '.';
+		return 2;
+	}
+	if (not std::isfinite(value)) {
+		return static_cast<size_t>(snprintf(buffer, REAL_BUFFER_SIZE, "%g", value));
+	}
+	const int sign = value < 0 ? 1 : 0;
+	const double magnitude = std::abs(value);
+	const int maxDigits = min(DBL_DIG + 2, static_cast<int>(width) - sign - 1);
+	char scientific[32];
+	char digits[DBL_DIG + 2];
+	int digitCount = 0;
+	int exponent = 0;
+	// Correctly rounded decimal digits "d.ddd" and exponent of the magnitude
+	auto decompose = [&](int count) {
+		snprintf(scientific, sizeof(scientific), "%.*e", count - 1, magnitude);
+		digitCount = count;
+		digits[0] = scientific[0];
+		const char* c = scientific + (count > 1 ? 2 : 1);
+		for (int i = 1; i < count; i++) {
+			digits[i] = *c++;
+		}
+		exponent = atoi(c + 1);
+	};
+	auto exponentWidth = [](int e) {
+		e = std::abs(e);
+		return e >= 100 ? 3 : (e >= 10 ? 2 : 1);
+	};
+	decompose(maxDigits);
+	// Keep the most significant digits that fit, either as "ddd.ddd" or ".000ddd"
+	// or as the Nastran exponent form "d.ddd+e"
+	for (;;) {
+		const int fixedDigits = exponent >= 0 ?
+				(exponent + 2 + sign <= static_cast<int>(width) ? static_cast<int>(width) - sign - 1 : 0)
+				: static_cast<int>(width) - sign + exponent;
+		const int exponentDigits = static_cast<int>(width) - sign - 2 - exponentWidth(exponent);
+		const int fitting = min(maxDigits, max(fixedDigits, exponentDigits));
+		if (fitting >= digitCount or fitting < 1) {
+			break;
+		}
+		// rounding to fewer digits can raise the exponent ("9.99" becomes "10.0"), check again
+		decompose(fitting);
 	}
-	//strs << boost::format("%.5f") % value;
-	string gnum = strs.str();
-	strs.str("");
-	strs.clear();
-	if (gnum.length() <= fieldLength) {
-		strs << internal << setw(this->fieldLength) << gnum;
+	while (digitCount > 1 and digits[digitCount - 1] == '0') {
+		digitCount--;
+	}
+
+	const int fixedLength = sign + (exponent >= 0 ? max(exponent + 1, digitCount) + 1 : digitCount - exponent);
+	const int exponentLength = sign + digitCount + 2 + exponentWidth(exponent);
+	char* out = buffer;
+	if (sign) {
+		*out++ = '-';
+	}
+	if (fixedLength <= exponentLength and fixedLength <= static_cast<int>(width)) {
+		if (exponent >= 0) {
+			for (int i = 0; i <= exponent; i++) {
+				*out++ = i < digitCount ? digits[i] : '0';
+			}
+			*out++ = '.';
+			for (int i = exponent + 1; i < digitCount; i++) {
+				*out++ = digits[i];
+			}
+		} else {
+			*out++ = '.';
+			for (int i = -1; i > exponent; i--) {
+				*out++ = '0';
+			}
+			for (int i = 0; i < digitCount; i++) {
+				*out++ = digits[i];
+			}
+		}
 	} else {
-		strs << internal << setw(this->fieldLength) << boost::format("%4.2e") % value;
+		*out++ = digits[0];
+		*out++ = '.';
+		for (int i = 1; i < digitCount; i++) {
+			*out++ = digits[i];
+		}
+		*out++ = exponent < 0 ? '-' : '+';
+		char exponentBuffer[20];
+		char* exponentEnd = exponentBuffer + sizeof(exponentBuffer);
+		for (char* c = formatDecimal(std::abs(exponent), exponentEnd); c != exponentEnd; c++) {
+			*out++ = *c;
+		}
 	}
-	this->fields.push_back(strs.str());
+	return static_cast<size_t>(out - buffer);
+}
+
+void Line::addField(const char* value, size_t length) noexcept {
+	string field(length < fieldLength ? fieldLength - length : 0, ' ');
+	field.append(value, length);
+	this->fields.push_back(move(field));
+}
+
+Line& Line::add(double value) noexcept {
+	char buffer[REAL_BUFFER_SIZE];
+	addField(buffer, formatReal(value, fieldLength, buffer));
 	return *this;
 }
 
 Line& Line::add(string value) noexcept {
-	std::ostringstream strs;
-	strs << internal << setw(this->fieldLength) << value;
-	this->fields.push_back(strs.str());
+	addField(value.data(), value.size());
 	return *this;
 }
 
 Line& Line::add(const char* value) noexcept {
-	std::ostringstream strs;
-	strs << internal << setw(this->fieldLength) << value;
-	this->fields.push_back(strs.str());
+	addField(value, strlen(value));
 	return *this;
 }
 
 Line& Line::add(int value) noexcept {
-	std::ostringstream strs;
-	strs << internal << setw(this->fieldLength) << value;
-	this->fields.push_back(strs.str());
+	char buffer[20];
+	char* end = buffer + sizeof(buffer);
+	const char* begin = formatDecimal(value, end);
+	addField(begin, static_cast<size_t>(end - begin));
 	return *this;
 }
 
@@ -194,9 +263,13 @@ string NastranWriter::getNasFilename(const Model& model,
 	return modelPath;
 }
 
-void NastranWriter::writeSOL(const Model& model, ofstream& out) const
+void NastranWriter::writeSOL(const Model& model, ostream& out) const
     {
-	auto& firstAnalysis = *model.analyses.begin();
+	if (model.analyses.empty()) {
+		out << "$ WARN no valid analysis. Skipping SOL." << endl;
+		return;
+	}
+	const auto& firstAnalysis = model.analyses.first();
 	string analysisLabel;
 	if (isCosmic()) {
         switch (firstAnalysis->type) {
@@ -242,14 +315,19 @@ void NastranWriter::writeSOL(const Model& model, ofstream& out) const
 	firstAnalysis->markAsWritten();
 }
 
-void NastranWriter::writeCells(const Model& model, ofstream& out) const
+void NastranWriter::writeCells(const Model& model, ostream& out) const
 		{
 	for (const auto& elementSet : model.elementSets) {
 		if (elementSet->isMatrixElement()) {
 			continue;
 		}
+		vector<int> nodeIds;
 		for (const int cellPosition : elementSet->cellPositions()) {
-            const Cell& cell = model.mesh.findCell(cellPosition);
+            const CellView& cell = model.mesh.viewCell(cellPosition);
+            nodeIds.clear();
+            for (const int nodePosition : cell.nodePositions) {
+                nodeIds.push_back(model.mesh.findNodeId(nodePosition));
+            }
 			string keyword;
 			if (elementSet->isBeam()) {
                 keyword = isCosmic() ? "CBAR" : "CBEAM";
@@ -334,21 +412,23 @@ void NastranWriter::writeCells(const Model& model, ofstream& out) const
             vector<int> nasConnect;
             auto entry = med2nastranNodeConnectByCellType.find(cell.type.code);
             if (entry == med2nastranNodeConnectByCellType.end()) {
-                nasConnect = cell.nodeIds;
+                nasConnect = nodeIds;
             } else {
-                vector<int> med2nastranNodeConnectByCellType = entry->second;
+                const vector<int>& med2nastranNodeConnect = entry->second;
                 nasConnect.resize(cell.type.numNodes);
                 for (unsigned int i2 = 0; i2 < cell.type.numNodes; i2++)
-                    nasConnect[med2nastranNodeConnectByCellType[i2]] = cell.nodeIds[i2];
+                    nasConnect[med2nastranNodeConnect[i2]] = nodeIds[i2];
             }
 
             Line cellLine{keyword};
             cellLine.add(cell.id).add(elementSet->bestId()).add(nasConnect);
 
-            if (elementSet->isBeam() and cell.hasOrientation) {
+            if (elementSet->isBeam() and cell.hasOrientation()) {
                 vector<double> x1x2x3;
                 string F;
-                const auto& v = cell.orientation->getV();
+                const auto& orientation = static_pointer_cast<OrientationCoordinateSystem>(
+                        model.mesh.getCoordinateSystemByPosition(cell.cspos));
+                const auto& v = orientation->getV();
                 x1x2x3 = {v.x(), v.y(), v.z()};
                 if (isCosmic())
                     F = "1";
@@ -362,7 +442,7 @@ void NastranWriter::writeCells(const Model& model, ofstream& out) const
 	}
 }
 
-void NastranWriter::writeNodes(const Model& model, ofstream& out) const
+void NastranWriter::writeNodes(const Model& model, ostream& out) const
 		{
 	for (Node node : model.mesh.nodes) {
 	    if (node.positionCS!= CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID)
@@ -373,7 +453,7 @@ void NastranWriter::writeNodes(const Model& model, ofstream& out) const
 	}
 }
 
-void NastranWriter::writeMaterials(const Model& model, ofstream& out) const
+void NastranWriter::writeMaterials(const Model& model, ostream& out) const
 		{
 	for (const auto& material : model.materials) {
 		Line mat1("MAT1");
@@ -394,7 +474,7 @@ void NastranWriter::writeMaterials(const Model& model, ofstream& out) const
 	}
 }
 
-void NastranWriter::writeConstraints(const Model& model, ofstream& out) const
+void NastranWriter::writeConstraints(const Model& model, ostream& out) const
 		{
 	for (const auto& constraintSet : model.constraintSets) {
 		const auto& spcs = constraintSet->getConstraintsByType(Constraint::Type::SPC);
@@ -547,7 +627,7 @@ void NastranWriter::writeConstraints(const Model& model, ofstream& out) const
 	}
 }
 
-void NastranWriter::writeLoadings(const Model& model, ofstream& out) const
+void NastranWriter::writeLoadings(const Model& model, ostream& out) const
 		{
 	for (const auto& loadingSet : model.loadSets) {
 		const auto& gravities = loadingSet->getLoadingsByType(Loading::Type::GRAVITY);
@@ -765,13 +845,13 @@ void NastranWriter::writeLoadings(const Model& model, ofstream& out) const
 	}
 }
 
-void NastranWriter::writeRuler(ofstream& out) const
+void NastranWriter::writeRuler(ostream& out) const
 		{
 	out << "$---1--][---2--][---3--][---4--][---5--][---6--][---7--][---8--][---9--][--10--]"
 			<< endl;
 }
 
-void NastranWriter::writeElements(const Model& model, ofstream& out) const
+void NastranWriter::writeElements(const Model& model, ostream& out) const
 		{
 	for (const auto& truss : model.getTrusses()) {
 		Line prod("PROD");
@@ -894,7 +974,7 @@ string NastranWriter::writeModel(Model& model,
 	}
 
 	string nasPath = getNasFilename(model, outputPath);
-	ofstream out;
+	BufferedOutputFile out;
 	out.precision(DBL_DIG);
 	out.open(nasPath.c_str(), ios::out | ios::trunc);
 	if (!out.is_open()) {
@@ -31,8 +31,22 @@ class Line {
 	unsigned int fieldNum = 0;
 	const std::string keyword = "";
 	std::vector<std::string> fields;
+	/**
+	 * Append a field, right justified in fieldLength characters.
+	 */
+	void addField(const char* value, size_t length) noexcept;
 public:
+	/**
+	 * Size of the buffer given to formatReal.
+	 */
+	static const size_t REAL_BUFFER_SIZE = 32;
 	Line(std::string) noexcept;
+	/**
+	 * Write value in at most width characters (8 for small field, 16 for large field) as a
+	 * Nastran real, with as many significant digits as fit: "123.4567", ".00125", "1.2345+12".
+	 * Returns the number of characters written, no padding is added.
+	 */
+	static size_t formatReal(double value, unsigned int width, char* buffer) noexcept;
 	Line& add() noexcept;
 	Line& add(double) noexcept;
 	Line& add(std::string) noexcept;
@@ -64,14 +78,14 @@ private:
 	bool isCosmic() const {
 	    return dialect == Dialect::COSMIC95;
 	}
-	void writeSOL(const Model& model, std::ofstream& out) const;
-	void writeCells(const Model& model, std::ofstream& out) const;
-	void writeNodes(const Model& model, std::ofstream& out) const;
-	void writeMaterials(const Model& model, std::ofstream& out) const;
-	void writeConstraints(const Model& model, std::ofstream& out) const;
-	void writeLoadings(const Model& model, std::ofstream& out) const;
-	void writeRuler(std::ofstream& out) const;
-	void writeElements(const Model& model, std::ofstream& out) const;
+	void writeSOL(const Model& model, std::ostream& out) const;
+	void writeCells(const Model& model, std::ostream& out) const;
+	void writeNodes(const Model& model, std::ostream& out) const;
+	void writeMaterials(const Model& model, std::ostream& out) const;
+	void writeConstraints(const Model& model, std::ostream& out) const;
+	void writeLoadings(const Model& model, std::ostream& out) const;
+	void writeRuler(std::ostream& out) const;
+	void writeElements(const Model& model, std::ostream& out) const;
 };
 
 }
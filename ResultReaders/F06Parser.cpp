@@ -14,18 +14,24 @@
 #if defined VDEBUG && defined __GNUC__  && !defined(_WIN32)
 #include <valgrind/memcheck.h>
 #endif
+#include <cerrno>
+#include <climits>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <stdlib.h>
 #include <exception>
 #include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
 #include <ciso646>
 #include "../Abstract/Model.h"
 #include "../Abstract/ConfigurationParameters.h"
+#include "../Abstract/Utility.h"
 
 using namespace std;
+namespace fs = boost::filesystem;
 
 namespace vega {
 namespace result {
@@ -34,59 +40,60 @@ using boost::algorithm::trim;
 using boost::algorithm::trim_copy;
 
 int F06Parser::readDisplacementSection(int currentSubCase, Model& model,
-		const ConfigurationParameters& configuration, ifstream& istream,
-		vector<shared_ptr<Assertion>>& assertions, double loadStep) {
-	string header;
-	string currentLine;
+		const ConfigurationParameters& configuration,
+		shared_ptr<BulkNodalDisplacementAssertion>& assertion, double loadStep) {
+	const char* lineBegin = cursor;
+	const char* lineEnd = cursor;
 	int subcase_id = NO_SUBCASE;
+	// Coordinate system of the last node with a displacement coordinate system
+	int lastDisplacementCS = CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID;
+	shared_ptr<CoordinateSystem> coordSystem = nullptr;
 	//skip header line
-	this->readLine(istream, header);
+	this->nextLine(lineBegin, lineEnd);
 	try {
-		while (this->readLine(istream, currentLine)) {
-			size_t subCasePosition = currentLine.find("SUBCASE");
-			if (currentLine.find("DIAGNOSTIC TOOLS") != string::npos) {
+		Field fields[9];
+		while (this->nextLine(lineBegin, lineEnd)) {
+			if (contains(lineBegin, lineEnd, "DIAGNOSTIC TOOLS")) {
 				//skip
-			} else if (subCasePosition != string::npos) {
+			} else if (contains(lineBegin, lineEnd, "SUBCASE")) {
 				/*
 				 * Only used to detect if this section has ended.
 				 * Since the line has been consumed, we will return the (next) subcase
-				 * LD : All this should simply be replaced by a buffer parser and a "peek" getline
 				 */
-				subcase_id = parseSubcase(subcase_id, currentLine);
+				subcase_id = parseSubcase(subcase_id, string(lineBegin, lineEnd));
 				break;
-			} else if (!isspace(currentLine.at(0))) {
+			} else if (!isspace(static_cast<unsigned char>(*lineBegin))) {
 				//stop parsing the section at the first line that don't start with a space
 				break;
 			} else {
-				istringstream istringLine(currentLine);
-				vector<string> tokens;
-				copy(istream_iterator<string>(istringLine), istream_iterator<string>(),
-						back_inserter(tokens));
-				if (tokens.size() != 8)
+				if (splitFields(lineBegin, lineEnd, fields, 9) != 8)
 					break;
 
-				int nodeId = stoi(tokens[0]);
-				if (tokens[1] != "G"){
-					//cerr << "unsupported assertion type " << assertionType
-					//		<< " : line n." << lineNumber << " " << currentLine
-					//		<< endl;
+				int nodeId = parseInt(fields[0]);
+				if (fields[1].second - fields[1].first != 1 or *fields[1].first != 'G') {
 					continue;
 				}
-				shared_ptr<ObjectiveSet> objectiveSet = nullptr;
-				if (currentSubCase == NO_SUBCASE) {
-                    objectiveSet = model.commonObjectiveSet;
-				} else {
-                    objectiveSet = model.getOrCreateObjectiveSet(currentSubCase, ObjectiveSet::Type::ASSERTION);
-				}
-				VectorialValue translation(stod(tokens[2]), stod(tokens[3]), stod(tokens[4]));
-				VectorialValue rotation(stod(tokens[5]), stod(tokens[6]), stod(tokens[7]));
+				VectorialValue translation(parseDouble(fields[2]), parseDouble(fields[3]), parseDouble(fields[4]));
+				VectorialValue rotation(parseDouble(fields[5]), parseDouble(fields[6]), parseDouble(fields[7]));
 
 				const Node& node = model.mesh.findNode(model.mesh.findNodePosition(nodeId));
 				if (node.displacementCS != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID) {
-					shared_ptr<CoordinateSystem> coordSystem = model.mesh.getCoordinateSystemByPosition(node.displacementCS);
-					coordSystem->updateLocalBase(VectorialValue(node.x, node.y, node.z));
-					translation = coordSystem->vectorToGlobal(translation);
-					rotation = coordSystem->vectorToGlobal(rotation);
+					if (coordSystem == nullptr or node.displacementCS != lastDisplacementCS) {
+						coordSystem = model.mesh.getCoordinateSystemByPosition(node.displacementCS);
+						lastDisplacementCS = node.displacementCS;
+					}
+					const VectorialValue point(node.x, node.y, node.z);
+					translation = coordSystem->vectorToGlobalAt(point, translation);
+					rotation = coordSystem->vectorToGlobalAt(point, rotation);
+				}
+				if (assertion == nullptr) {
+					shared_ptr<ObjectiveSet> objectiveSet = nullptr;
+					if (currentSubCase == NO_SUBCASE) {
+						objectiveSet = model.commonObjectiveSet;
+					} else {
+						objectiveSet = model.getOrCreateObjectiveSet(currentSubCase, ObjectiveSet::Type::ASSERTION);
+					}
+					assertion = make_shared<BulkNodalDisplacementAssertion>(model, objectiveSet, configuration.testTolerance);
 				}
 				double values[6] = {
 						translation.x(), translation.y(), translation.z(),
@@ -96,8 +103,7 @@ int F06Parser::readDisplacementSection(int currentSubCase, Model& model,
 					double value = values[i];
 					if (abs(value) < 1e-12)
 						value = 0.;
-					assertions.push_back(make_shared<NodalDisplacementAssertion>(model, objectiveSet, configuration.testTolerance,
-									nodeId, DOF::findByPosition(i), value, loadStep));
+					assertion->addEntry(nodeId, DOF::findByPosition(i), value, configuration.testTolerance, loadStep);
 				}
 
 			}
@@ -107,7 +113,7 @@ int F06Parser::readDisplacementSection(int currentSubCase, Model& model,
 		message += string(e.what()) + " parsing:";
 		message += configuration.resultFile.string();
 		message += " Line number " + to_string(lineNumber);
-		message += " Line: " + currentLine;
+		message += " Line: " + string(lineBegin, lineEnd);
 		cerr << message << endl;
 		if (ConfigurationParameters::TranslationMode::MODE_STRICT == configuration.translationMode) {
 			throw e;
@@ -119,12 +125,12 @@ int F06Parser::readDisplacementSection(int currentSubCase, Model& model,
 }
 
 int F06Parser::readEigenvalueSection(int currentSubCase, Model& model,
-		const ConfigurationParameters& configuration, ifstream& istream,
+		const ConfigurationParameters& configuration,
 		vector<shared_ptr<Assertion>>& assertions) {
 	string currentLine;
 	int subcase_id = NO_SUBCASE;
 	try {
-		while (this->readLine(istream, currentLine)) {
+		while (this->readLine(currentLine)) {
 			size_t orderPosition = currentLine.find("ORDER");
 			if (orderPosition != string::npos) {
 				break;
@@ -140,7 +146,7 @@ int F06Parser::readEigenvalueSection(int currentSubCase, Model& model,
 				return subcase_id;
 			}
 		}
-		while (this->readLine(istream, currentLine)) {
+		while (this->readLine(currentLine)) {
             size_t subCasePosition = currentLine.find("SUBCASE");
             if (subCasePosition != string::npos) {
 				/*
@@ -190,20 +196,20 @@ int F06Parser::readEigenvalueSection(int currentSubCase, Model& model,
 }
 
 int F06Parser::readComplexDisplacementSection(int currentSubCase, Model& model,
-		const ConfigurationParameters& configuration, ifstream& istream,
+		const ConfigurationParameters& configuration,
 		vector<shared_ptr<Assertion>>& assertions, double frequency) {
 	string currentLine;
 	int subcase_id = NO_SUBCASE;
 	try {
 
-		while (this->readLine(istream, currentLine)) {
+		while (this->readLine(currentLine)) {
 			size_t orderPosition =
 					currentLine.find(
 							"POINT ID.   TYPE          T1             T2             T3             R1             R2             R3");
 			if (orderPosition != string::npos)
 				break;
 		}
-		while (this->readLine(istream, currentLine)) {
+		while (this->readLine(currentLine)) {
 			size_t subCasePosition = currentLine.find("SUBCASE");
 			if (subCasePosition != string::npos) {
 				subcase_id = parseSubcase(subcase_id, currentLine);
@@ -217,7 +223,7 @@ int F06Parser::readComplexDisplacementSection(int currentSubCase, Model& model,
 			if (tokens.size() != 9)
 				break;
 
-			this->readLine(istream, currentLine);
+			this->readLine(currentLine);
 			istringLine.clear();
 			istringLine.str(currentLine);
 			copy(istream_iterator<string>(istringLine), istream_iterator<string>(),
@@ -263,14 +269,14 @@ int F06Parser::readComplexDisplacementSection(int currentSubCase, Model& model,
 }
 
 int F06Parser::readStressesForSolidsSection(int currentSubCase, Model& model,
-		const ConfigurationParameters& configuration, ifstream& istream,
+		const ConfigurationParameters& configuration,
 		vector<shared_ptr<Assertion>>& assertions) {
 	string currentLine;
 	int subcase_id = NO_SUBCASE;
 	try {
 
         bool foundHeader = false;
-		while (this->readLine(istream, currentLine) and currentLine[0] != '1') {
+		while (this->readLine(currentLine) and currentLine[0] != '1') {
 			size_t orderPosition =
 					currentLine.find(
 							"ELEMENT-ID    GRID-ID        NORMAL              SHEAR             PRINCIPAL       -A-  -B-  -C-     PRESSURE       VON MISES");
@@ -279,7 +285,7 @@ int F06Parser::readStressesForSolidsSection(int currentSubCase, Model& model,
 				break;
 			}
 		}
-		while (foundHeader and this->readLine(istream, currentLine)) {
+		while (foundHeader and this->readLine(currentLine)) {
 			size_t subCasePosition = currentLine.find("SUBCASE");
 			if (subCasePosition != string::npos) {
                 subcase_id = parseSubcase(subcase_id, currentLine);
@@ -308,10 +314,10 @@ int F06Parser::readStressesForSolidsSection(int currentSubCase, Model& model,
             for (int nodePos = 1; nodePos <= nodeNum + 1 /* for CENTER stress */; nodePos++) {
                 for (int dir = 1; dir <= 3; dir++) {
                     // PAGE should only happen between nodes
-                    this->readLine(istream, currentLine);
+                    this->readLine(currentLine);
                     if (currentLine[0] == '1' and currentLine.find("PAGE") != string::npos) {
                         for (int i = 1; i < 5; i++) {  // skip page header
-                            this->readLine(istream, currentLine);
+                            this->readLine(currentLine);
                         }
                         nodePos--;
                         break;
@@ -364,10 +370,15 @@ int F06Parser::readStressesForSolidsSection(int currentSubCase, Model& model,
 }
 
 int F06Parser::addAssertionsToModel(int currentSubcase, double loadStep, Model &model,
-		const ConfigurationParameters& configuration, ifstream& istream) {
-
-	vector<shared_ptr<Assertion>> assertions;
-	int nextSubcase = readDisplacementSection(currentSubcase,model, configuration, istream, assertions, loadStep);
+		const ConfigurationParameters& configuration) {
+
+	// All the displacement sections of a subcase fill the same assertion
+	auto& assertion = displacementAssertionBySubcase[currentSubcase];
+	const size_t previousCount = assertion == nullptr ? 0 : assertion->entryCount();
+	int nextSubcase = readDisplacementSection(currentSubcase, model, configuration, assertion, loadStep);
+	if (assertion == nullptr or assertion->entryCount() == previousCount) {
+		return nextSubcase;
+	}
 	shared_ptr<Analysis> analysis;
 	if (currentSubcase != NO_SUBCASE) {
 		analysis = model.analyses.find(currentSubcase);
@@ -379,25 +390,25 @@ int F06Parser::addAssertionsToModel(int currentSubcase, double loadStep, Model &
 		// LD If no subcase indicated, the first one is used if exists.
 		analysis = model.analyses.first();
 	}
-	for (const auto& assertion : assertions) {
-		if (analysis != nullptr) {
+	if (analysis != nullptr) {
+		if (previousCount == 0) {
 			model.add(assertion);
-			if (model.configuration.logLevel >= LogLevel::TRACE) {
-				cout << "Adding NodalDisplacementAssertion : " << *assertion << " to subcase: "
-						<< currentSubcase << endl;
-			}
-		} else if (model.configuration.logLevel >= LogLevel::DEBUG) {
-			cout << "Discarding NodalDisplacementAssertion : " << *assertion
-					<< " because subcase id: " << currentSubcase << " was not found." << endl;
 		}
+		if (model.configuration.logLevel >= LogLevel::TRACE) {
+			cout << "Adding " << assertion->entryCount() - previousCount << " nodal displacement assertions to : "
+					<< *assertion << " of subcase: " << currentSubcase << endl;
+		}
+	} else if (model.configuration.logLevel >= LogLevel::DEBUG) {
+		cout << "Discarding " << assertion->entryCount() - previousCount << " nodal displacement assertions"
+				<< " because subcase id: " << currentSubcase << " was not found." << endl;
 	}
 	return nextSubcase;
 }
 
 int F06Parser::addFrequencyAssertionsToModel(int currentSubCase, Model& model,
-		const ConfigurationParameters& configuration, ifstream& istream) {
+		const ConfigurationParameters& configuration) {
 	vector<shared_ptr<Assertion>> assertions;
-	int nextSubcase = readEigenvalueSection(currentSubCase, model, configuration, istream, assertions);
+	int nextSubcase = readEigenvalueSection(currentSubCase, model, configuration, assertions);
 	shared_ptr<Analysis> analysis;
 	if (currentSubCase != NO_SUBCASE) {
 		analysis = model.analyses.find(currentSubCase);
@@ -430,9 +441,9 @@ int F06Parser::addFrequencyAssertionsToModel(int currentSubCase, Model& model,
 }
 
 int F06Parser::addComplexAssertionsToModel(int currentSubCase, double frequency, Model& model,
-		const ConfigurationParameters& configuration, ifstream& istream) {
+		const ConfigurationParameters& configuration) {
 	vector<shared_ptr<Assertion>> assertions;
-	int nextSubcase = readComplexDisplacementSection(currentSubCase, model, configuration, istream, assertions,
+	int nextSubcase = readComplexDisplacementSection(currentSubCase, model, configuration, assertions,
 			frequency);
 	shared_ptr<Analysis> analysis;
 	if (currentSubCase != NO_SUBCASE) {
@@ -463,10 +474,10 @@ int F06Parser::addComplexAssertionsToModel(int currentSubCase, double frequency,
 }
 
 int F06Parser::addVonMisesAssertionsToModel(int currentSubcase, Model &model,
-		const ConfigurationParameters& configuration, ifstream& istream) {
+		const ConfigurationParameters& configuration) {
 
 	vector<shared_ptr<Assertion>> assertions;
-	int nextSubcase = readStressesForSolidsSection(currentSubcase, model, configuration, istream, assertions);
+	int nextSubcase = readStressesForSolidsSection(currentSubcase, model, configuration, assertions);
 	shared_ptr<Analysis> analysis;
 	if (currentSubcase != NO_SUBCASE) {
 		analysis = model.analyses.find(currentSubcase);
@@ -511,14 +522,18 @@ int F06Parser::parseSubcase(int currentSubCase, const string& currentLine) {
 
 void F06Parser::add_assertions(const ConfigurationParameters& configuration,
 		Model& model) {
-	if (!configuration.resultFile.empty()) {
-		ifstream istream(configuration.resultFile.string());
+	if (!configuration.resultFile.empty() and fs::exists(configuration.resultFile)) {
+		const MappedFile resultFile(configuration.resultFile.string());
+		cursor = resultFile.begin();
+		end = resultFile.end();
+		lineNumber = 0;
+		displacementAssertionBySubcase.clear();
 		string currentLine;
 		int currentSubCase = NO_SUBCASE;
 		double loadStep = -1;
 		double frequency = -1;
 		int pointId = -1;
-		while (this->readLine(istream, currentLine)) {
+		while (this->readLine(currentLine)) {
 			trim(currentLine);
 			size_t subCasePosition = currentLine.find("SUBCASE");
 			if (subCasePosition != string::npos) {
@@ -552,21 +567,29 @@ void F06Parser::add_assertions(const ConfigurationParameters& configuration,
 				 * In this case, it will be given back as return value, to be used for the next section.
 				 */
 				currentSubCase = addAssertionsToModel(currentSubCase, loadStep, model,
-						configuration, istream);
+						configuration);
 			} else if (currentLine == "R E A L   E I G E N V A L U E S") {
-				currentSubCase = addFrequencyAssertionsToModel(currentSubCase, model, configuration, istream);
+				currentSubCase = addFrequencyAssertionsToModel(currentSubCase, model, configuration);
 			} else if (currentLine == "C O M P L E X   D I S P L A C E M E N T   V E C T O R") {
 				currentSubCase = addComplexAssertionsToModel(currentSubCase, frequency, model,
-						configuration, istream);
+						configuration);
 			}
 			size_t stressesPos = currentLine.find("S T R E S S E S");
 			size_t solidElementsPos = currentLine.find("S O L I D   E L E M E N T S");
 			if (stressesPos != string::npos and solidElementsPos != string::npos) {
 				currentSubCase = addVonMisesAssertionsToModel(currentSubCase, model,
-						configuration, istream);
+						configuration);
+			}
+		}
+		if (configuration.sampledAssertionNodes > 0) {
+			for (const auto& subcaseAndAssertion : displacementAssertionBySubcase) {
+				if (subcaseAndAssertion.second != nullptr) {
+					subcaseAndAssertion.second->sampleNodes(static_cast<size_t>(configuration.sampledAssertionNodes));
+				}
 			}
 		}
-		istream.close();
+		displacementAssertionBySubcase.clear();
+		cursor = end = nullptr;
 	}
 }
 
@@ -574,18 +597,92 @@ F06Parser::~F06Parser() {
 
 }
 
-bool F06Parser::readLine(istream &istream, string& line) {
-	bool lineAvailable = false;
-	while (getline(istream, line)) {
+bool F06Parser::nextLine(const char*& lineBegin, const char*& lineEnd) {
+	while (cursor < end) {
+		lineBegin = cursor;
+		lineEnd = static_cast<const char*>(memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+		if (lineEnd == nullptr) {
+			lineEnd = end;
+			cursor = end;
+		} else {
+			cursor = lineEnd + 1;
+		}
 		lineNumber += 1;
-		if (!line.empty()) {
-			if (not trim_copy(line).empty()) {
-				lineAvailable = true;
-				break;
-			}
+		if (find_if(lineBegin, lineEnd, [](char c) {return not isspace(static_cast<unsigned char>(c));}) != lineEnd) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool F06Parser::readLine(string& line) {
+	const char* lineBegin = nullptr;
+	const char* lineEnd = nullptr;
+	if (not nextLine(lineBegin, lineEnd)) {
+		return false;
+	}
+	line.assign(lineBegin, lineEnd);
+	return true;
+}
+
+bool F06Parser::contains(const char* begin, const char* end, const char* text) {
+	return search(begin, end, text, text + strlen(text)) != end;
+}
+
+size_t F06Parser::splitFields(const char* begin, const char* end, Field* fields, size_t maxFields) {
+	size_t fieldCount = 0;
+	const char* position = begin;
+	while (fieldCount < maxFields) {
+		while (position < end and isspace(static_cast<unsigned char>(*position))) {
+			position++;
 		}
+		if (position == end) {
+			break;
+		}
+		fields[fieldCount].first = position;
+		while (position < end and not isspace(static_cast<unsigned char>(*position))) {
+			position++;
+		}
+		fields[fieldCount].second = position;
+		fieldCount++;
+	}
+	return fieldCount;
+}
+
+int F06Parser::parseInt(const Field& field) {
+	char buffer[32];
+	const size_t length = static_cast<size_t>(field.second - field.first);
+	if (length >= sizeof(buffer)) {
+		throw out_of_range("parseInt");
+	}
+	copy(field.first, field.second, buffer);
+	buffer[length] = '\0';
+	char* parsedEnd = nullptr;
+	errno = 0;
+	const long value = strtol(buffer, &parsedEnd, 10);
+	if (parsedEnd == buffer) {
+		throw invalid_argument("parseInt");
+	}
+	if (errno == ERANGE or value < INT_MIN or value > INT_MAX) {
+		throw out_of_range("parseInt");
+	}
+	return static_cast<int>(value);
+}
+
+double F06Parser::parseDouble(const Field& field) {
+	char buffer[64];
+	const size_t length = static_cast<size_t>(field.second - field.first);
+	if (length >= sizeof(buffer)) {
+		throw out_of_range("parseDouble");
+	}
+	copy(field.first, field.second, buffer);
+	buffer[length] = '\0';
+	char* parsedEnd = nullptr;
+	const double value = strtod(buffer, &parsedEnd);
+	if (parsedEnd == buffer) {
+		throw invalid_argument("parseDouble");
 	}
-	return lineAvailable;
+	return value;
 }
 
 }
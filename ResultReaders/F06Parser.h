@@ -12,31 +12,53 @@
 #define F06PARSER_H_
 #include "../Abstract/SolverInterfaces.h"
 #include <iostream>
+#include <map>
+#include <memory>
+#include <utility>
 
 namespace vega {
 class Model;
+class BulkNodalDisplacementAssertion;
 
 namespace result {
 class F06Parser: public vega::ResultReader {
 private:
+	typedef std::pair<const char*, const char*> Field; /**< bounds of a field in a line */
 	int lineNumber = 0;
-	bool readLine(std::istream &istream, std::string& line);
+	const char* cursor = nullptr; /**< next character to read in the mapped result file */
+	const char* end = nullptr;
+	/**
+	 * Displacement assertions of each subcase: all the displacement sections (pages, load steps)
+	 * of a subcase are stored in the same one.
+	 */
+	std::map<int, std::shared_ptr<BulkNodalDisplacementAssertion>> displacementAssertionBySubcase;
+	/**
+	 * Move to the next line which is not blank, give back its bounds (end of line excluded).
+	 */
+	bool nextLine(const char*& lineBegin, const char*& lineEnd);
+	bool readLine(std::string& line);
+	static bool contains(const char* begin, const char* end, const char* text);
+	/**
+	 * Find the blank separated fields of a line, up to maxFields. Return the number found.
+	 */
+	static size_t splitFields(const char* begin, const char* end, Field* fields, size_t maxFields);
+	static int parseInt(const Field&);
+	static double parseDouble(const Field&);
 	int addAssertionsToModel(int currentSubcase, double loadStep, Model &model,
-			const ConfigurationParameters&, std::ifstream& istream);
-	int addFrequencyAssertionsToModel(int currentSubCase, Model&, const ConfigurationParameters&,
-			std::ifstream&);
+			const ConfigurationParameters&);
+	int addFrequencyAssertionsToModel(int currentSubCase, Model&, const ConfigurationParameters&);
 	int addComplexAssertionsToModel(int currentSubCase, double frequency, Model&,
-			const ConfigurationParameters&, std::ifstream&);
+			const ConfigurationParameters&);
     int addVonMisesAssertionsToModel(int currentSubCase, Model&,
-			const ConfigurationParameters&, std::ifstream&);
+			const ConfigurationParameters&);
 	int readDisplacementSection(int currentSubCase, Model& model, const ConfigurationParameters&,
-			std::ifstream& istream, std::vector<std::shared_ptr<Assertion>>& assertions, double loadStep);
-	int readEigenvalueSection(int currentSubCase, Model&, const ConfigurationParameters&, std::ifstream&,
+			std::shared_ptr<BulkNodalDisplacementAssertion>& assertion, double loadStep);
+	int readEigenvalueSection(int currentSubCase, Model&, const ConfigurationParameters&,
 			std::vector<std::shared_ptr<Assertion>>&);
-	int readComplexDisplacementSection(int currentSubCase, Model&, const ConfigurationParameters&, std::ifstream&,
+	int readComplexDisplacementSection(int currentSubCase, Model&, const ConfigurationParameters&,
 			std::vector<std::shared_ptr<Assertion>>&, double frequency);
     int readStressesForSolidsSection(int currentSubCase, Model& model, const ConfigurationParameters&,
-			std::ifstream& istream, std::vector<std::shared_ptr<Assertion>>& assertions);
+			std::vector<std::shared_ptr<Assertion>>& assertions);
 
 	int parseSubcase(int currentSubCase, const std::string& currentLine);
 	static const int NO_SUBCASE = -1;
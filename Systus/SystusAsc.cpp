@@ -80,17 +80,16 @@ void SystusTable::fill(std::shared_ptr<MatrixElement> me, int nbDOFS){
     // Building the table
     for (const auto np : me->nodePairs()){
         int pairCode = positionToSytusNumber[np.first]*1000 + positionToSytusNumber[np.second]*100;
-        shared_ptr<const DOFMatrix> dM = me->findSubmatrix(np.first, np.second);
-        for (const auto dof: dM->componentByDofs){
-            int dofi=DOFToInt(dof.first.first);
+        for (const auto& component : me->findSubmatrix(np.first, np.second)){
+            int dofi=DOFToInt(component.dof1);
             if (dofi> nbDOFS)
                 throw logic_error("Invalid degree of freedom ("+to_string(dofi)+") for Systus Table.");
-            int dofj=DOFToInt(dof.first.second);
+            int dofj=DOFToInt(component.dof2);
             if (dofj> nbDOFS)
                 throw logic_error("Invalid degree of freedom ("+to_string(dofj)+") for Systus Table.");
             int dofCode = 10*dofi + dofj;
             this->values.push_back(pairCode+dofCode);
-            this->values.push_back(dof.second);
+            this->values.push_back(component.value);
         }
     }
 
@@ -102,9 +101,8 @@ void SystusTable::fill(std::shared_ptr<MatrixElement> me, int nbDOFS){
 // Start of Systus Matrix
 
 SystusMatrix::SystusMatrix(systus_ascid_t id, int nbDOFS, int nbNodes ) :
-        id(id), nbDOFS(nbDOFS), nbNodes(nbNodes), size{nbNodes*nbNodes*nbDOFS*nbDOFS} {
-    this->values.resize(this->size, 0.0);
-
+        id(id), nbDOFS(nbDOFS), nbNodes(nbNodes),
+        size{static_cast<systus_ascid_t>(nbNodes)*static_cast<systus_ascid_t>(nbNodes*nbDOFS*nbDOFS)} {
 }
 
 void SystusMatrix::setValue(int i, int j, int dofi, int dofj, double value){
@@ -112,10 +110,18 @@ void SystusMatrix::setValue(int i, int j, int dofi, int dofj, double value){
         throw logic_error("Invalid degree of freedom ("+to_string(dofi)+") for Systus Matrix.");
     if (dofj> this->nbDOFS)
         throw logic_error("Invalid degree of freedom ("+to_string(dofj)+") for Systus Matrix.");
-    int pos = (dofi-1) + nbDOFS*(dofj-1) + nbDOFS*nbDOFS*(i-1)+ nbDOFS*nbDOFS*nbNodes*(j-1);
-    if (pos> this->size)
+    if (i < 1 or i > this->nbNodes or j < 1 or j > this->nbNodes)
         throw logic_error("Invalid access to Systus Matrix.");
-    this->values[pos]=value;
+    const systus_ascid_t blockIndex = static_cast<systus_ascid_t>((i-1) + nbNodes*(j-1));
+    auto it = blocks.find(blockIndex);
+    if (it == blocks.end()) {
+        // Only exact zeros: a tiny value must be written the same whether its block exists or not
+        if (fpclassify(value) == FP_ZERO) {
+            return;
+        }
+        it = blocks.insert({blockIndex, vector<double>(static_cast<size_t>(nbDOFS*nbDOFS), 0.0)}).first;
+    }
+    it->second[static_cast<size_t>((dofi-1) + nbDOFS*(dofj-1))] = value;
 }
 
 // A lot of fields are filled with 0, because we don't know what to put here
@@ -135,17 +141,32 @@ ostream& operator<<(ostream& os, const SystusMatrix & sm)
   for (int i=1; i<=sm.nbNodes;i++)
       os << i <<endl;
 
-  // Matrix elements. All dofs of SM(i,j) are written in one line
-  systus_ascid_t ioff=0;
-  systus_ascid_t sizeM = sm.nbDOFS*sm.nbDOFS;
-  for (int i=0; i<sm.nbNodes; i++){
-      for (int j=0; j<sm.nbNodes; j++){
-          for (systus_ascid_t k=0; k<sizeM; k++){
-              os << sm.values[k +ioff]<<" ";
-          }
-          os << endl;
-          ioff+= sizeM;
+  // Matrix elements. All dofs of SM(i,j) are written in one line, formatted as the stream
+  // would do it. Most blocks are empty: their line is prepared once.
+  const systus_ascid_t sizeM = static_cast<systus_ascid_t>(sm.nbDOFS*sm.nbDOFS);
+  string zeroLine;
+  for (systus_ascid_t k=0; k<sizeM; k++){
+      zeroLine += "0 ";
+  }
+  zeroLine += '\n';
+  const int precision = static_cast<int>(os.precision());
+  string line;
+  char number[32];
+  const systus_ascid_t nbBlocks = static_cast<systus_ascid_t>(sm.nbNodes)*static_cast<systus_ascid_t>(sm.nbNodes);
+  auto block = sm.blocks.begin();
+  for (systus_ascid_t blockIndex=0; blockIndex<nbBlocks; blockIndex++){
+      if (block == sm.blocks.end() or block->first != blockIndex) {
+          os.write(zeroLine.data(), static_cast<streamsize>(zeroLine.size()));
+          continue;
+      }
+      line.clear();
+      for (double value : block->second){
+          line.append(number, formatGeneral(value, precision, number));
+          line += ' ';
       }
+      line += '\n';
+      os.write(line.data(), static_cast<streamsize>(line.size()));
+      ++block;
   }
 
   //os << "0"<<endl;
@@ -156,7 +177,7 @@ ostream& operator<<(ostream& os, const SystusMatrix & sm)
 // Start of SystusMatrices
 
 void SystusMatrices::add(SystusMatrix sm){
-    this->matrices.push_back(sm);
+    this->matrices.push_back(std::move(sm));
 }
 
 void SystusMatrices::clear(){
@@ -81,8 +81,12 @@ public:
     systus_ascid_t id; /**< Id. Correspond to a "E id" in the material, or "REDUCTION id" in the reduction process.>**/
     int nbDOFS;
     int nbNodes;
-    int size;
-    std::vector<double> values;
+    systus_ascid_t size;
+    /**
+     * Blocks of nbDOFS*nbDOFS values (dofi first) holding a non-zero value, by their index
+     * (i-1) + nbNodes*(j-1) in the output. Absent blocks are written as zeros.
+     */
+    std::map<systus_ascid_t, std::vector<double>> blocks;
 
     SystusMatrix(systus_ascid_t id, int nbNodes, int nbDOFS);
     virtual ~SystusMatrix() = default;
@@ -358,7 +358,7 @@ string SystusWriter::writeModel(Model& model,
     }
 
     // On Systus output, we build a "general" solver file
-    ofstream dat_file_ofs;
+    BufferedOutputFile dat_file_ofs;
     string dat_path = systusModel.getOutputFileName("_ALL.DAT");
     if (configuration.systusOutputProduct=="systus"){
         dat_file_ofs.open(dat_path.c_str(), ios::trunc);
@@ -379,7 +379,7 @@ string SystusWriter::writeModel(Model& model,
 
         /* ASCI file */
         string asc_path = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1)+ "_DATA1.ASC");
-        ofstream asc_file_ofs;
+        BufferedOutputFile asc_file_ofs;
         asc_file_ofs.precision(DBL_DIG);
         asc_file_ofs.open(asc_path.c_str(), ios::trunc | ios::out);
         if (!asc_file_ofs.is_open()) {
@@ -392,7 +392,7 @@ string SystusWriter::writeModel(Model& model,
         this->writeMatrixFiles(systusModel, idSubcase);
 
         /* Analysis file */
-        ofstream analyse_file_ofs;
+        BufferedOutputFile analyse_file_ofs;
         analyse_file_ofs.precision(DBL_DIG);
         string analyse_path = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + ".DAT");
         analyse_file_ofs.open(analyse_path.c_str(), ios::trunc);
@@ -2284,7 +2284,7 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
                 aMatrix.setValue(2, 1, dofJ, dofI, -ss->getStiffness());
                 tId2+=SystusWriter::StiffnessAccessId;
                 seIdByElementSet[elementSet->getId()]= seId;
-                stiffnessMatrices.add(aMatrix);
+                stiffnessMatrices.add(std::move(aMatrix));
 
             }
             if (ss->hasDamping()){
@@ -2300,7 +2300,7 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
                 aMatrix.setValue(2, 1, dofJ, dofI, -ss->getDamping());
                 tId2+=SystusWriter::DampingAccessId*10000;
                 seIdByElementSet[elementSet->getId()]= seId;
-                dampingMatrices.add(aMatrix);
+                dampingMatrices.add(std::move(aMatrix));
             }
             tableByElementSet[elementSet->getId()]=-tId2;
         }
@@ -2328,18 +2328,17 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
         for (const auto np : dam->nodePairs()){
             int nI = positionToSytusNumber[np.first];
             int nJ = positionToSytusNumber[np.second];
-            const auto& dM = dam->findSubmatrix(np.first, np.second);
-            for (const auto dof: dM->componentByDofs){
-                int dofI = DOFToInt(dof.first.first);
-                int dofJ = DOFToInt(dof.first.second);
-                aMatrix.setValue(nI, nJ, dofI, dofJ, dof.second);
-                aMatrix.setValue(nJ, nI, dofJ, dofI, dof.second);
+            for (const auto& component : dam->findSubmatrix(np.first, np.second)){
+                int dofI = DOFToInt(component.dof1);
+                int dofJ = DOFToInt(component.dof2);
+                aMatrix.setValue(nI, nJ, dofI, dofJ, component.value);
+                aMatrix.setValue(nJ, nI, dofJ, dofI, component.value);
             }
         }
 
         tableByElementSet[elementSet->getId()]=-SystusWriter::DampingAccessId*10000;
         seIdByElementSet[elementSet->getId()]= seId;
-        dampingMatrices.add(aMatrix);
+        dampingMatrices.add(std::move(aMatrix));
         dam->markAsWritten();
     }
 
@@ -2361,18 +2360,17 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
         for (const auto np : mm->nodePairs()){
             int nI = positionToSytusNumber[np.first];
             int nJ = positionToSytusNumber[np.second];
-            const auto& dM = mm->findSubmatrix(np.first, np.second);
-            for (const auto dof: dM->componentByDofs){
-                int dofI = DOFToInt(dof.first.first);
-                int dofJ = DOFToInt(dof.first.second);
-                aMatrix.setValue(nI, nJ, dofI, dofJ, dof.second);
-                aMatrix.setValue(nJ, nI, dofJ, dofI, dof.second);
+            for (const auto& component : mm->findSubmatrix(np.first, np.second)){
+                int dofI = DOFToInt(component.dof1);
+                int dofJ = DOFToInt(component.dof2);
+                aMatrix.setValue(nI, nJ, dofI, dofJ, component.value);
+                aMatrix.setValue(nJ, nI, dofJ, dofI, component.value);
             }
         }
 
         tableByElementSet[elementSet->getId()]=-SystusWriter::MassAccessId*100;
         seIdByElementSet[elementSet->getId()]= seId;
-        massMatrices.add(aMatrix);
+        massMatrices.add(std::move(aMatrix));
         mm->markAsWritten();
     }
 
@@ -2393,18 +2391,17 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
         for (const auto np : sm->nodePairs()){
             int nI = positionToSytusNumber[np.first];
             int nJ = positionToSytusNumber[np.second];
-            const auto& dM = sm->findSubmatrix(np.first, np.second);
-            for (const auto dof: dM->componentByDofs){
-                int dofI = DOFToInt(dof.first.first);
-                int dofJ = DOFToInt(dof.first.second);
-                aMatrix.setValue(nI, nJ, dofI, dofJ, dof.second);
-                aMatrix.setValue(nJ, nI, dofJ, dofI, dof.second);
+            for (const auto& component : sm->findSubmatrix(np.first, np.second)){
+                int dofI = DOFToInt(component.dof1);
+                int dofJ = DOFToInt(component.dof2);
+                aMatrix.setValue(nI, nJ, dofI, dofJ, component.value);
+                aMatrix.setValue(nJ, nI, dofJ, dofI, component.value);
             }
         }
 
         tableByElementSet[elementSet->getId()]=-SystusWriter::StiffnessAccessId;
         seIdByElementSet[elementSet->getId()]= seId;
-        stiffnessMatrices.add(aMatrix);
+        stiffnessMatrices.add(std::move(aMatrix));
         sm->markAsWritten();
     }
 
@@ -2836,34 +2833,36 @@ void SystusWriter::writeElements(const SystusModel& systusModel, const int idSub
                 cellGroup->isUseful=true;
             }
         }
+        vector<int> systusConnect;
         for (const int cellPosition : elementSet->cellPositions()) {
-            const Cell& cell = mesh.findCell(cellPosition);
+            const CellView& cell = mesh.viewCell(cellPosition);
 
             if (systusModel.model.configuration.logLevel >= LogLevel::TRACE){
-                cout << "Writing cell " << cell << " from " << elementSet->name << endl;
+                cout << "Writing cell " << mesh.findCell(cellPosition) << " from " << elementSet->name << endl;
             }
             auto systus2med_it = systus2medNodeConnectByCellType.find(cell.type.code);
             if (systus2med_it == systus2medNodeConnectByCellType.end()) {
-                cout << "Warning in Elements: " << cell << " not supported in Systus" << endl;
+                cout << "Warning in Elements: " << mesh.findCell(cellPosition) << " not supported in Systus" << endl;
                 continue;
             }
 
             // Putting all nodes in the Systus order
             const auto& systus2medNodeConnect = systus2med_it->second;
-            const auto& medConnect = cell.nodeIds;
-            vector<int> systusConnect;
+            const auto& medConnect = cell.nodePositions;
+            systusConnect.clear();
             for (unsigned int medId : systus2medNodeConnect)
-                systusConnect.push_back(medConnect[medId]);
+                systusConnect.push_back(mesh.findNodeId(medConnect[medId]));
 
+            const unsigned int nodeCount = cell.nodeCount();
             if (elementSet->type==ElementSet::Type::STRUCTURAL_SEGMENT){
-                dim = (cell.nodeIds.size()==2) ? 1 : 0 ;
+                dim = (nodeCount==2) ? 1 : 0 ;
             }
 
             out << cell.id << " " << dim << typecell;              // Dimension and type of cell;
-            out << setfill('0') << setw(2) << cell.nodeIds.size(); // Number of nodes in two caracters: 01, 02, 05, 10, etc.
+            out << setfill('0') << setw(2) << nodeCount; // Number of nodes in two caracters: 01, 02, 05, 10, etc.
 
-            if (cell.nodeIds.size()>20){
-                cerr<< "Warning in Elements: " << cell << " has " << cell.nodeIds.size() << " but SYSTUS only support up to 20 nodes by element."<<endl;
+            if (nodeCount>20){
+                cerr<< "Warning in Elements: " << mesh.findCell(cellPosition) << " has " << nodeCount << " but SYSTUS only support up to 20 nodes by element."<<endl;
             }
 
             out << " " << materialIdByElementSetId[elementSet->getId()]; // Material Id
@@ -2876,7 +2875,7 @@ void SystusWriter::writeElements(const SystusModel& systusModel, const int idSub
             out << " " << isol;
 
             // Local Orientation
-            if (cell.hasOrientation){
+            if (cell.hasOrientation()){
                 writeElementLocalReferentiel(systusModel, dim, typecell, systusConnect, cell.cspos, out);
             }else{
                 out << " 0";
@@ -3227,6 +3226,20 @@ void SystusWriter::writeDat(const SystusModel& systusModel, const vega::Configur
                     assertion->markAsWritten();
                     break;
                 }
+                case Objective::Type::BULK_NODAL_DISPLACEMENT_ASSERTION: {
+                    const auto& bulkAssertion = static_pointer_cast<BulkNodalDisplacementAssertion>(assertion);
+                    for (size_t entry = 0; entry < bulkAssertion->entryCount(); entry++) {
+                        if (entry > 0) {
+                            out << endl;
+                        }
+                        writeNodalDisplacementAssertion(
+                                systusModel.model.mesh.findNodeId(bulkAssertion->getNodePosition(entry)),
+                                bulkAssertion->getDOF(entry), bulkAssertion->getValue(entry),
+                                bulkAssertion->getTolerance(entry), bulkAssertion->getInstant(entry), out);
+                    }
+                    assertion->markAsWritten();
+                    break;
+                }
                 case Objective::Type::FREQUENCY_ASSERTION: {
                     if (analysis->type == Analysis::Type::LINEAR_DYNA_MODAL_FREQ) {
                         handleWritingWarning("Ignoring frequency assertion for analysis of type linear dyna modal");
@@ -3275,26 +3288,30 @@ void SystusWriter::writeNodalDisplacementAssertion(Assertion& assertion, ostream
 //    if (systusOption == SystusOption::CONTINUOUS and nda.dof.isRotation) {
 //        return;
 //    }
-    if (!is_equal(nda.instant, -1))
+    writeNodalDisplacementAssertion(nda.nodeId, nda.dof, nda.value, nda.tolerance, nda.instant, out);
+}
+
+void SystusWriter::writeNodalDisplacementAssertion(int nodeId, const DOF& dof, double value, double tolerance,
+        double instant, ostream& out) {
+    if (!is_equal(instant, -1))
         handleWritingError("Instant in NodalDisplacementAssertion not supported");
-    int nodeId = nda.nodeId;
-    int dofPos = nda.dof.position + 1;
+    int dofPos = dof.position + 1;
 
     out << scientific;
     out << "displacement = node_displacement(1" << "," << nodeId << ");" << endl;
-    out << "diff = abs((displacement[" << dofPos << "]-(" << nda.value << "))/("
-            << (abs(nda.value) >= 1e-9 ? nda.value : 1.) << "));" << endl;
+    out << "diff = abs((displacement[" << dofPos << "]-(" << value << "))/("
+            << (abs(value) >= 1e-9 ? value : 1.) << "));" << endl;
 
     out << "fprintf(iResu,\" ------------------------ TEST_RESU DISPLACEMENT ASSERTION ------------------------\\n\")"
             << endl;
     out
     << "fprintf(iResu,\"      NOEUD        NUM_CMP      VALE_REFE             VALE_CALC    ERREUR       TOLE\\n\");"
     << endl;
-    out << "if (diff > abs(" << nda.tolerance
+    out << "if (diff > abs(" << tolerance
             << ")) fprintf(iResu,\" NOOK \"); else fprintf(iResu,\" OK   \");" << endl;
     out << "fprintf(iResu,\"" << setw(8) << nodeId << "     " << setw(8) << dofPos << "     "
-            << nda.value
-            << " %e %e " << nda.tolerance << " \\n\\n\", displacement[" << dofPos << "], diff);"
+            << value
+            << " %e %e " << tolerance << " \\n\\n\", displacement[" << dofPos << "], diff);"
             << endl;
     out.unsetf(ios::scientific);
 }
@@ -3357,7 +3374,7 @@ void SystusWriter::writeMatrixFiles(const SystusModel& systusModel, const int id
 
     /* Writing Damping Matrices */
     if (dampingMatrices.size()>0){
-        ofstream ofsMatrixFile;
+        BufferedOutputFile ofsMatrixFile;
         ofsMatrixFile.precision(DBL_DIG);
         string matrixFile = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + "_DAMGEN.ASC");
         ofsMatrixFile.open(matrixFile.c_str(), ios::trunc);
@@ -3372,7 +3389,7 @@ void SystusWriter::writeMatrixFiles(const SystusModel& systusModel, const int id
 
     /* Writing Mass Matrices */
     if (massMatrices.size()>0){
-        ofstream ofsMatrixFile;
+        BufferedOutputFile ofsMatrixFile;
         ofsMatrixFile.precision(DBL_DIG);
         string matrixFile = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + "_MASGEN.ASC");
         ofsMatrixFile.open(matrixFile.c_str(), ios::trunc);
@@ -3387,7 +3404,7 @@ void SystusWriter::writeMatrixFiles(const SystusModel& systusModel, const int id
 
     /* Writing Stiffness Matrices */
     if (stiffnessMatrices.size()>0){
-        ofstream ofsMatrixFile;
+        BufferedOutputFile ofsMatrixFile;
         ofsMatrixFile.precision(DBL_DIG);
         string matrixFile = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + "_STIGEN.ASC");
         ofsMatrixFile.open(matrixFile.c_str(), ios::trunc);
@@ -418,6 +418,8 @@ private:
     void writeDat(const SystusModel&, const ConfigurationParameters &, const int idSubcase, std::ostream&);
 
     void writeNodalDisplacementAssertion(Assertion& assertion, std::ostream& out);
+    void writeNodalDisplacementAssertion(int nodeId, const DOF& dof, double value, double tolerance,
+            double instant, std::ostream& out);
     void writeNodalComplexDisplacementAssertion(Assertion& assertion, std::ostream& out);
     void writeFrequencyAssertion(Assertion& assertion, std::ostream& out);
     void writeNodalForceVector(const SystusModel& systusModel, const std::shared_ptr<NodalForce>& nodalForce, const int idLoadCase, systus_ascid_t& vectorId);
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * CoordinateSystem_benchmark.cpp
+ *
+ * Time of positions transformed to the global coordinate system one by one and in batch,
+ * and of the reads of a BulkNodalForce given in a local coordinate system.
+ * Usage: CoordinateSystem_benchmark [number of positions (default 1000000)]
+ */
+
+#include "../../Abstract/Model.h"
+#include "../../Abstract/CoordinateSystem.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace vega;
+
+int main(int argc, char* argv[]) {
+	const int count = argc > 1 ? stoi(argv[1]) : 1000000;
+	const size_t positionCount = static_cast<size_t>(count);
+	{
+		Model model("transforms");
+		const VectorialValue ex = VectorialValue(1., 1., 0.).normalized();
+		const VectorialValue ey = VectorialValue(-1., 1., 0.).normalized();
+		CartesianCoordinateSystem cs(model.mesh, VectorialValue(10., 20., 30.), ex, ey);
+		vector<double> local(3 * positionCount);
+		for (size_t i = 0; i < local.size(); i++) {
+			local[i] = static_cast<double>(i % 1000) / 7.;
+		}
+
+		auto start = chrono::steady_clock::now();
+		vector<VectorialValue> globals;
+		globals.reserve(positionCount);
+		for (size_t i = 0; i < positionCount; i++) {
+			globals.push_back(cs.positionToGlobal(VectorialValue(local[3 * i], local[3 * i + 1], local[3 * i + 2])));
+		}
+		const auto oneByOneTime = chrono::steady_clock::now() - start;
+		cs.flatten();
+		start = chrono::steady_clock::now();
+		vector<double> batch(3 * positionCount);
+		cs.positionsToGlobal(local.data(), batch.data(), positionCount);
+		const auto batchTime = chrono::steady_clock::now() - start;
+		cout << "positionToGlobal " << count << " positions: one by one "
+				<< chrono::duration_cast<chrono::milliseconds>(oneByOneTime).count() << " ms, batch "
+				<< chrono::duration_cast<chrono::milliseconds>(batchTime).count() << " ms" << endl;
+	}
+	{
+		Model model{"bulk_nodal_force", "10.3", SolverName::NASTRAN};
+		const auto& loadSet1 = make_shared<LoadSet>(model, LoadSet::Type::LOAD, 1);
+		model.add(loadSet1);
+		CartesianCoordinateSystem cs(model.mesh, VectorialValue(1.0, 2.0, 3.0), VectorialValue(0.0, 1.0, 0.0),
+				VectorialValue(0.0, 0.0, 1.0), CoordinateSystem::GLOBAL_COORDINATE_SYSTEM, 7);
+		model.mesh.add(cs);
+		const int csPosition = model.mesh.findOrReserveCoordinateSystem(
+				Reference<CoordinateSystem>(CoordinateSystem::Type::ABSOLUTE, 7));
+		const auto& bulkForce = make_shared<BulkNodalForce>(model, loadSet1);
+		for (int i = 1; i <= count; i++) {
+			model.mesh.addNode(i, i, 0.0, 0.0);
+			bulkForce->addEntry(i, VectorialValue(1.0, 0.0, i), VectorialValue(0.0, 2.0, 0.0), csPosition);
+		}
+		model.add(bulkForce);
+
+		// What a writer does for each node of the loading
+		const auto start = chrono::steady_clock::now();
+		VectorialValue forceSum, momentSum;
+		for (int nodePosition = 0; nodePosition < count; nodePosition++) {
+			forceSum = forceSum + bulkForce->getForceInGlobalCS(nodePosition);
+			momentSum = momentSum + bulkForce->getMomentInGlobalCS(nodePosition);
+		}
+		const auto readTime = chrono::steady_clock::now() - start;
+		cout << "BulkNodalForce " << count << " nodes in a local coordinate system: "
+				<< chrono::duration_cast<chrono::milliseconds>(readTime).count() << " ms (force sum "
+				<< forceSum << ")" << endl;
+	}
+	return 0;
+}
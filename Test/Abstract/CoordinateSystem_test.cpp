@@ -174,6 +174,90 @@ BOOST_AUTO_TEST_CASE( test_chaining_CoordinateSystem ) {
     BOOST_CHECK_EQUAL(expectCS2O, cs2.positionToGlobal(O));
 }
 
+static void checkClose(const VectorialValue& expected, const VectorialValue& actual) {
+    BOOST_CHECK_SMALL((expected - actual).norm(), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE( test_flattened_CoordinateSystem ) {
+    Model model("flattened");
+    CartesianCoordinateSystem cs1(model.mesh, VectorialValue(10., 20., 30.), VectorialValue(0., 1., 0.),
+            VectorialValue(-1., 0., 1.), CoordinateSystem::GLOBAL_COORDINATE_SYSTEM, 1);
+    model.mesh.add(cs1);
+    const Reference<CoordinateSystem> ref1(CoordinateSystem::Type::ABSOLUTE, 1);
+    CartesianCoordinateSystem cs2(model.mesh, VectorialValue(1., 2., 3.), VectorialValue(1., 1., 0.),
+            VectorialValue(0., 0., 1.), ref1, 2);
+    model.mesh.add(cs2);
+    const Reference<CoordinateSystem> ref2(CoordinateSystem::Type::ABSOLUTE, 2);
+    CylindricalCoordinateSystem cyl(model.mesh, VectorialValue(-4., 5., 6.), VectorialValue(0., 0., 1.),
+            VectorialValue(1., 0., 0.), ref2, 3);
+    model.mesh.add(cyl);
+    SphericalCoordinateSystem sph(model.mesh, VectorialValue(2., -1., 0.5), VectorialValue(0., 1., 1.),
+            VectorialValue(1., 0., 0.), ref2, 5);
+    model.mesh.add(sph);
+    const Reference<CoordinateSystem> refSph(CoordinateSystem::Type::ABSOLUTE, 5);
+    // A node given in the spherical coordinate system: (r, theta, phi)
+    const int sphPosition = model.mesh.findOrReserveCoordinateSystem(refSph);
+    const int nodePosition = model.mesh.addNode(1, 1., 90., 0., sphPosition);
+
+    const vector<VectorialValue> points = { VectorialValue(1., 2., 3.), VectorialValue(-7., 0.5, 2.),
+            VectorialValue(3., 135., -1.) };
+    const auto& coordSystem2 = model.mesh.findCoordinateSystem(ref2);
+    const auto& coordSystemCyl = model.mesh.findCoordinateSystem(Reference<CoordinateSystem>(CoordinateSystem::Type::ABSOLUTE, 3));
+    const auto& coordSystemSph = model.mesh.findCoordinateSystem(refSph);
+    vector<VectorialValue> positions2, vectors2, positionsCyl, vectorsCyl, positionsSph;
+    for (const auto& point : points) {
+        positionsSph.push_back(coordSystemSph->positionToGlobal(point));
+        positions2.push_back(coordSystem2->positionToGlobal(point));
+        vectors2.push_back(coordSystem2->vectorToGlobal(point));
+        positionsCyl.push_back(coordSystemCyl->positionToGlobal(point));
+        coordSystemCyl->updateLocalBase(point);
+        vectorsCyl.push_back(coordSystemCyl->vectorToGlobal(point));
+        // The stateless transform matches the stateful one
+        checkClose(vectorsCyl.back(), coordSystemCyl->vectorToGlobalAt(point, point));
+    }
+
+    const VectorialValue& nodeGlobal = coordSystemSph->positionToGlobal(VectorialValue(1., 90., 0.));
+
+    model.finish();
+    BOOST_CHECK(coordSystem2->isFlattened());
+    BOOST_CHECK(coordSystemCyl->isFlattened());
+    BOOST_CHECK(coordSystemSph->isFlattened());
+    const Node& node = model.mesh.findNode(nodePosition);
+    checkClose(nodeGlobal, VectorialValue(node.x, node.y, node.z));
+    vector<double> local;
+    for (const auto& point : points) {
+        local.insert(local.end(), { point.x(), point.y(), point.z() });
+    }
+    vector<double> batchPositions(local.size()), batchVectors(local.size());
+    coordSystemCyl->positionsToGlobal(local.data(), batchPositions.data(), points.size());
+    coordSystemCyl->vectorsToGlobal(local.data(), local.data(), batchVectors.data(), points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        checkClose(positions2[i], coordSystem2->positionToGlobal(points[i]));
+        checkClose(vectors2[i], coordSystem2->vectorToGlobal(points[i]));
+        checkClose(positionsCyl[i], coordSystemCyl->positionToGlobal(points[i]));
+        checkClose(vectorsCyl[i], coordSystemCyl->vectorToGlobalAt(points[i], points[i]));
+        checkClose(positionsCyl[i], VectorialValue(batchPositions[3 * i], batchPositions[3 * i + 1], batchPositions[3 * i + 2]));
+        checkClose(vectorsCyl[i], VectorialValue(batchVectors[3 * i], batchVectors[3 * i + 1], batchVectors[3 * i + 2]));
+    }
+    vector<double> batchSph(local.size());
+    coordSystemSph->positionsToGlobal(local.data(), batchSph.data(), points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        checkClose(positionsSph[i], coordSystemSph->positionToGlobal(points[i]));
+        checkClose(positionsSph[i], VectorialValue(batchSph[3 * i], batchSph[3 * i + 1], batchSph[3 * i + 2]));
+    }
+
+    // A reference to a cylindrical coordinate system is not flattened
+    CartesianCoordinateSystem cs4(model.mesh, VectorialValue(1., 0., 0.), VectorialValue::X, VectorialValue::Y,
+            Reference<CoordinateSystem>(CoordinateSystem::Type::ABSOLUTE, 3), 4);
+    model.mesh.add(cs4);
+    const auto& coordSystem4 = model.mesh.findCoordinateSystem(Reference<CoordinateSystem>(CoordinateSystem::Type::ABSOLUTE, 4));
+    coordSystem4->flatten();
+    BOOST_CHECK(not coordSystem4->isFlattened());
+    vector<double> global4(local.size());
+    coordSystem4->positionsToGlobal(local.data(), global4.data(), points.size());
+    checkClose(coordSystem4->positionToGlobal(points[1]), VectorialValue(global4[3], global4[4], global4[5]));
+}
+
 BOOST_AUTO_TEST_CASE( test_globalcs ) {
 
     Reference<CoordinateSystem> gcsRef(CoordinateSystem::Type::ABSOLUTE, CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID);
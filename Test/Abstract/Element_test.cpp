@@ -41,3 +41,33 @@ BOOST_AUTO_TEST_CASE( test_structuralsegment ) {
 	BOOST_CHECK(structuralElement->isDiagonal());
 	BOOST_CHECK(structuralElement->hasRotations());
 }
+
+BOOST_AUTO_TEST_CASE( test_matrixelement_blocks ) {
+	Model model("fakemodel");
+	StiffnessMatrix matrix(model, MatrixType::SYMMETRIC);
+	matrix.addComponent(3, DOF::DX, 3, DOF::DX, 10.0);
+	matrix.addComponent(3, DOF::RY, 1, DOF::DX, -2.0);
+	matrix.addComponent(1, DOF::DZ, 2, DOF::DY, 4.0);
+	matrix.addComponent(1, DOF::DX, 1, DOF::DX, 5.0);
+	const int pos1 = model.mesh.findNodePosition(1);
+	const int pos2 = model.mesh.findNodePosition(2);
+	const int pos3 = model.mesh.findNodePosition(3);
+	BOOST_CHECK_EQUAL(matrix.nodePositions().size(), 3);
+	const auto& nodePairs = matrix.nodePairs();
+	BOOST_CHECK_EQUAL(nodePairs.size(), 4);
+	BOOST_CHECK(is_sorted(nodePairs.begin(), nodePairs.end()));
+	BOOST_CHECK_EQUAL(matrix.countCoupledNodes(pos1), 2);
+	BOOST_CHECK_EQUAL(matrix.countCoupledNodes(pos2), 1);
+	BOOST_CHECK_EQUAL(matrix.countCoupledNodes(pos3), 1);
+	// Off diagonal blocks are stored with the lowest node position first
+	const DOFMatrix& block13 = pos1 < pos3 ? matrix.findSubmatrix(pos1, pos3) : matrix.findSubmatrix(pos3, pos1);
+	BOOST_CHECK_EQUAL(block13.size(), 1);
+	const auto& component = *block13.begin();
+	BOOST_CHECK(is_equal(component.value, -2.0));
+	BOOST_CHECK(matrix.findSubmatrix(pos3, pos3).findComponent(DOF::DX, DOF::DX) > 9.0);
+	BOOST_CHECK(matrix.getDOFSForNode(pos2) == DOFS::TRANSLATIONS);
+	BOOST_CHECK(matrix.getDOFSForNode(pos3) == DOFS::ALL_DOFS);
+	matrix.clear();
+	BOOST_CHECK(not matrix.effective());
+	BOOST_CHECK(matrix.nodePairs().empty());
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * Mesh_benchmark.cpp
+ *
+ * Insert and lookup throughput of the id index, compared to the std::map it replaced.
+ * Ids are either consecutive (usual meshes) or spread with a large stride (merged meshes).
+ * Usage: Mesh_benchmark [number of ids (default 10000000)]
+ */
+
+#include "../../Abstract/Mesh.h"
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+
+using namespace std;
+using namespace vega;
+
+int main(int argc, char* argv[]) {
+	const int size = argc > 1 ? stoi(argv[1]) : 10000000;
+	for (const int stride : { 1, 97 }) {
+		auto start = chrono::steady_clock::now();
+		IdIndex index;
+		for (int i = 0; i < size; i++) {
+			index.set(i * stride, i);
+		}
+		const auto insertTime = chrono::steady_clock::now() - start;
+		start = chrono::steady_clock::now();
+		long long sum = 0;
+		for (int i = 0; i < size; i++) {
+			sum += index.find(i * stride);
+		}
+		const auto lookupTime = chrono::steady_clock::now() - start;
+		cout << "IdIndex " << size << " ids, stride " << stride << (index.isDense() ? " (dense)" : " (hashed)")
+				<< ": insert " << chrono::duration_cast<chrono::milliseconds>(insertTime).count() << " ms, lookup "
+				<< chrono::duration_cast<chrono::milliseconds>(lookupTime).count() << " ms" << endl;
+
+		start = chrono::steady_clock::now();
+		map<int, int> positionById;
+		for (int i = 0; i < size; i++) {
+			positionById[i * stride] = i;
+		}
+		const auto mapInsertTime = chrono::steady_clock::now() - start;
+		start = chrono::steady_clock::now();
+		long long mapSum = 0;
+		for (int i = 0; i < size; i++) {
+			mapSum += positionById.find(i * stride)->second;
+		}
+		const auto mapLookupTime = chrono::steady_clock::now() - start;
+		cout << "std::map " << size << " ids, stride " << stride << ": insert "
+				<< chrono::duration_cast<chrono::milliseconds>(mapInsertTime).count() << " ms, lookup "
+				<< chrono::duration_cast<chrono::milliseconds>(mapLookupTime).count() << " ms"
+				<< (sum == mapSum ? "" : " (lookups differ)") << endl;
+	}
+	return 0;
+}
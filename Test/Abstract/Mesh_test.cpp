@@ -46,6 +46,65 @@ BOOST_AUTO_TEST_CASE( test_mesh_stats ) {
     BOOST_CHECK(stats.quadraticMeanLength < 20);
     const auto& stats2 = mesh.calcStats();
     BOOST_CHECK_EQUAL(stats2.maxLength, 20);
+    BOOST_CHECK_EQUAL(stats2.edgeCount, 5);
+    BOOST_CHECK_EQUAL(stats2.zeroLengthEdgeCount, 1);
+}
+
+BOOST_AUTO_TEST_CASE( test_mesh_stats_edges ) {
+    Mesh mesh(LogLevel::INFO, "test_mesh_stats_edges");
+    // Unit cube: the statistics only measure its 12 edges, not the diagonals
+    mesh.addNode(1, 0.0, 0.0, 0.0);
+    mesh.addNode(2, 1.0, 0.0, 0.0);
+    mesh.addNode(3, 1.0, 1.0, 0.0);
+    mesh.addNode(4, 0.0, 1.0, 0.0);
+    mesh.addNode(5, 0.0, 0.0, 1.0);
+    mesh.addNode(6, 1.0, 0.0, 1.0);
+    mesh.addNode(7, 1.0, 1.0, 1.0);
+    mesh.addNode(8, 0.0, 1.0, 1.0);
+    mesh.addCell(1, CellType::HEXA8, {1, 2, 3, 4, 5, 6, 7, 8});
+    mesh.addCell(2, CellType::SEG2, {1, 7});
+    const auto& hexaStats = mesh.calcStats({CellType::HEXA8});
+    BOOST_CHECK_EQUAL(hexaStats.edgeCount, 12);
+    BOOST_CHECK_CLOSE(hexaStats.minLength, 1.0, 1e-9);
+    BOOST_CHECK_CLOSE(hexaStats.maxLength, 1.0, 1e-9);
+    BOOST_CHECK_CLOSE(hexaStats.quadraticMeanLength, 1.0, 1e-9);
+    const auto& stats = mesh.calcStats();
+    BOOST_CHECK_EQUAL(stats.edgeCount, 13);
+    BOOST_CHECK_CLOSE(stats.maxLength, sqrt(3.0), 1e-9);
+    BOOST_CHECK_CLOSE(stats.quadraticMeanLength, sqrt(15.0 / 13.0), 1e-9);
+    BOOST_CHECK_EQUAL(mesh.calcStats({CellType::TETRA4}).edgeCount, 0);
+}
+
+BOOST_AUTO_TEST_CASE( test_mesh_stats_parallel ) {
+    // Enough cells for the parallel reduction: unit HEXA8 grid, every edge has length 1
+    Mesh mesh(LogLevel::INFO, "test_mesh_stats_parallel");
+    const int side = 50;
+    auto nodeId = [side](int i, int j, int k) {
+        return 1 + i + (side + 1) * (j + (side + 1) * k);
+    };
+    for (int k = 0; k <= side; k++) {
+        for (int j = 0; j <= side; j++) {
+            for (int i = 0; i <= side; i++) {
+                mesh.addNode(nodeId(i, j, k), i, j, k);
+            }
+        }
+    }
+    int cellId = 1;
+    for (int k = 0; k < side; k++) {
+        for (int j = 0; j < side; j++) {
+            for (int i = 0; i < side; i++) {
+                mesh.addCell(cellId++, CellType::HEXA8, {nodeId(i, j, k), nodeId(i + 1, j, k),
+                        nodeId(i + 1, j + 1, k), nodeId(i, j + 1, k), nodeId(i, j, k + 1),
+                        nodeId(i + 1, j, k + 1), nodeId(i + 1, j + 1, k + 1), nodeId(i, j + 1, k + 1)});
+            }
+        }
+    }
+    const auto& stats = mesh.calcStats();
+    BOOST_CHECK_EQUAL(stats.edgeCount, 12 * static_cast<size_t>(side * side * side));
+    BOOST_CHECK_EQUAL(stats.zeroLengthEdgeCount, 0);
+    BOOST_CHECK_CLOSE(stats.minLength, 1.0, 1e-9);
+    BOOST_CHECK_CLOSE(stats.maxLength, 1.0, 1e-9);
+    BOOST_CHECK_CLOSE(stats.quadraticMeanLength, 1.0, 1e-9);
 }
 
 BOOST_AUTO_TEST_CASE( test_faceIds )
@@ -79,6 +138,66 @@ BOOST_AUTO_TEST_CASE( test_faceIds_pload4 )
                                   expectedFace1NodeIds.begin(), expectedFace1NodeIds.end());
 }
 
+BOOST_AUTO_TEST_CASE( test_volume_face_index )
+{
+    Mesh mesh(LogLevel::INFO, "faces");
+    const int hexa1 = mesh.addCell(1, CellType::HEXA8, { 1, 2, 3, 4, 5, 6, 7, 8 });
+    mesh.addCell(2, CellType::HEXA8, { 5, 6, 7, 8, 9, 10, 11, 12 });
+    const int tetra = mesh.addCell(3, CellType::TETRA4, { 9, 10, 11, 13 });
+    const int quad = mesh.addCell(4, CellType::QUAD4, { 2, 3, 4, 1 });
+    const int tri = mesh.addCell(5, CellType::TRI3, { 13, 9, 11 });
+
+    const auto& quadFace = mesh.volcellAndFaceNum_from_skincell(mesh.findCell(quad));
+    BOOST_CHECK_EQUAL(hexa1, quadFace.first.position);
+    BOOST_CHECK_EQUAL(1, quadFace.second);
+    const auto& triFace = mesh.volcellAndFaceNum_from_skincell(mesh.findCell(tri));
+    BOOST_CHECK_EQUAL(tetra, triFace.first.position);
+    BOOST_CHECK_EQUAL(3, triFace.second);
+    // A face shared by two cells is found on the first one
+    const auto& sharedFace = mesh.findVolumeFace({ mesh.findNodePosition(8), mesh.findNodePosition(7),
+        mesh.findNodePosition(6), mesh.findNodePosition(5) });
+    BOOST_CHECK_EQUAL(hexa1, sharedFace.first);
+    BOOST_CHECK_EQUAL(2, sharedFace.second);
+    // Not a face: diagonal of a hexa
+    BOOST_CHECK(mesh.findVolumeFace({ mesh.findNodePosition(1), mesh.findNodePosition(3),
+        mesh.findNodePosition(6) }).first == Cell::UNAVAILABLE_CELL);
+
+    // The index follows the cells added after its first use
+    const int lastTetra = mesh.addCell(6, CellType::TETRA4, { 1, 2, 3, 14 });
+    const int skin = mesh.addCell(7, CellType::TRI3, { 14, 2, 1 });
+    const auto& lastFace = mesh.volcellAndFaceNum_from_skincell(mesh.findCell(skin));
+    BOOST_CHECK_EQUAL(lastTetra, lastFace.first.position);
+    BOOST_CHECK_EQUAL(2, lastFace.second);
+}
+
+BOOST_AUTO_TEST_CASE( test_node_cell_index )
+{
+    Mesh mesh(LogLevel::INFO, "nodecells");
+    const int hexa = mesh.addCell(1, CellType::HEXA8, { 1, 2, 3, 4, 5, 6, 7, 8 });
+    const int quad = mesh.addCell(2, CellType::QUAD4, { 5, 6, 7, 8 });
+    const int seg = mesh.addCell(3, CellType::SEG2, { 8, 9 });
+
+    const auto& cells8 = mesh.findNodeCellPositions(mesh.findNodePosition(8));
+    const vector<int> expectedCells8 = { hexa, quad, seg };
+    BOOST_CHECK_EQUAL_COLLECTIONS(cells8.begin(), cells8.end(), expectedCells8.begin(), expectedCells8.end());
+    BOOST_CHECK_EQUAL(1, mesh.findNodeCellPositions(mesh.findNodePosition(1)).size());
+    BOOST_CHECK(mesh.findNodeCellPositions(-1).empty());
+
+    // The index follows the cells added or updated after its first use
+    const int node10 = mesh.addNode(10, 0, 0, 0);
+    BOOST_CHECK(mesh.findNodeCellPositions(node10).empty());
+    const int seg2 = mesh.addCell(4, CellType::SEG2, { 9, 10 });
+    BOOST_CHECK_EQUAL(seg2, *mesh.findNodeCellPositions(node10).begin());
+    const int seg3 = mesh.updateCell(3, CellType::SEG2, { 1, 10 });
+    const auto& cells8After = mesh.findNodeCellPositions(mesh.findNodePosition(8));
+    const vector<int> expectedCells8After = { hexa, quad };
+    BOOST_CHECK_EQUAL_COLLECTIONS(cells8After.begin(), cells8After.end(),
+            expectedCells8After.begin(), expectedCells8After.end());
+    const auto& cells10 = mesh.findNodeCellPositions(node10);
+    const vector<int> expectedCells10 = { seg2, seg3 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(cells10.begin(), cells10.end(), expectedCells10.begin(), expectedCells10.end());
+}
+
 BOOST_AUTO_TEST_CASE( test_NodeGroup )
 {
     Mesh mesh(LogLevel::INFO, "test");
@@ -155,3 +274,149 @@ BOOST_AUTO_TEST_CASE( test_node_iterator )
     }
     BOOST_CHECK_EQUAL(mesh.countNodes(), i);
 }
+
+BOOST_AUTO_TEST_CASE( test_cell_view )
+{
+    Mesh mesh(LogLevel::INFO, "test");
+    for (int nodeId = 1; nodeId <= 6; nodeId++) {
+        mesh.addNode(nodeId, nodeId, 0., 0.);
+    }
+    mesh.addCell(11, CellType::SEG2, {1, 2});
+    mesh.addCell(12, CellType::TRI3, {2, 3, 4}, false, CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID, 7);
+    mesh.addCell(13, CellType::SEG2, {5, 6}, true);
+    mesh.addCell(14, CellType::TRI3, {4, 5, 6});
+    for (int cellId = 11; cellId <= 14; cellId++) {
+        const int cellPosition = mesh.findCellPosition(cellId);
+        const Cell& cell = mesh.findCell(cellPosition);
+        const CellView& view = mesh.viewCell(cellPosition);
+        BOOST_CHECK_EQUAL(cell.id, view.id);
+        BOOST_CHECK_EQUAL(cellPosition, view.position);
+        BOOST_CHECK_EQUAL(cell.type, view.type);
+        BOOST_CHECK_EQUAL(cell.elementId, view.elementId);
+        BOOST_CHECK_EQUAL(cell.cellTypePosition, view.cellTypePosition);
+        BOOST_CHECK_EQUAL(cell.nodePositions.size(), view.nodeCount());
+        BOOST_CHECK_EQUAL_COLLECTIONS(cell.nodePositions.begin(), cell.nodePositions.end(),
+                view.nodePositions.begin(), view.nodePositions.end());
+    }
+    BOOST_CHECK(mesh.viewCell(mesh.findCellPosition(13)).isvirtual);
+
+    vector<int> iteratedIds;
+    auto cellIterator = mesh.cells.cells_begin(CellType::TRI3);
+    while (cellIterator.hasNext()) {
+        const CellView& view = cellIterator.nextView();
+        iteratedIds.push_back(view.id);
+        BOOST_CHECK_EQUAL(mesh.findNodeId(view.nodePositions[2]), view.id == 12 ? 4 : 6);
+    }
+    const vector<int> expectedIds = { 12, 14 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(expectedIds.begin(), expectedIds.end(), iteratedIds.begin(), iteratedIds.end());
+}
+
+BOOST_AUTO_TEST_CASE( test_connectivity )
+{
+    Mesh mesh(LogLevel::INFO, "test");
+    mesh.reserveCells(CellType::TRI3, 2);
+    mesh.reserveCells(CellType::QUAD4, 10);
+    for (int nodeId = 1; nodeId <= 5; nodeId++) {
+        mesh.addNode(nodeId, nodeId, 0., 0.);
+    }
+    mesh.addCell(1, CellType::TRI3, {1, 2, 3});
+    mesh.addCell(2, CellType::SEG2, {4, 5});
+    mesh.addCell(3, CellType::TRI3, {5, 4, 3});
+    const vector<int>& triConnectivity = mesh.cells.connectivity(CellType::TRI3);
+    const vector<int> expected = { 0, 1, 2, 4, 3, 2 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), triConnectivity.begin(), triConnectivity.end());
+    BOOST_CHECK(mesh.cells.connectivity(CellType::QUAD4).empty());
+    BOOST_CHECK(mesh.cells.connectivity(CellType::HEXA8).empty());
+    // Reserved but unused types are not reported
+    BOOST_CHECK_EQUAL(2u, mesh.cells.cellTypes().size());
+}
+
+BOOST_AUTO_TEST_CASE( test_id_index )
+{
+    IdIndex index;
+    BOOST_CHECK_EQUAL(IdIndex::NOT_FOUND, index.find(1));
+    // Decreasing dense ids
+    for (int id = 2000; id > 0; id--) {
+        index.set(id, 2000 - id);
+    }
+    BOOST_CHECK(index.isDense());
+    BOOST_CHECK_EQUAL(2000, index.size());
+    BOOST_CHECK_EQUAL(1, index.minId());
+    BOOST_CHECK_EQUAL(2000, index.maxId());
+    BOOST_CHECK_EQUAL(1999, index.find(1));
+    BOOST_CHECK_EQUAL(IdIndex::NOT_FOUND, index.find(0));
+    BOOST_CHECK_EQUAL(IdIndex::NOT_FOUND, index.find(2001));
+    index.set(1, 42);
+    BOOST_CHECK_EQUAL(42, index.find(1));
+    BOOST_CHECK_EQUAL(2000, index.size());
+    // An automatic id far away
+    index.set(9999999, 2000);
+    BOOST_CHECK(not index.isDense());
+    BOOST_CHECK_EQUAL(2001, index.size());
+    BOOST_CHECK_EQUAL(42, index.find(1));
+    BOOST_CHECK_EQUAL(0, index.find(2000));
+    BOOST_CHECK_EQUAL(2000, index.find(9999999));
+    BOOST_CHECK_EQUAL(IdIndex::NOT_FOUND, index.find(5000));
+    index.set(-7, 2001);
+    const auto& sorted = index.sorted();
+    BOOST_REQUIRE_EQUAL(2002, sorted.size());
+    BOOST_CHECK(is_sorted(sorted.begin(), sorted.end()));
+    BOOST_CHECK_EQUAL(-7, sorted.front().first);
+    BOOST_CHECK_EQUAL(9999999, sorted.back().first);
+    BOOST_CHECK_EQUAL(-7, index.minId());
+}
+
+BOOST_AUTO_TEST_CASE( test_node_iterator_sparse_ids )
+{
+    Mesh mesh(LogLevel::INFO, "test");
+    const vector<int> nodeIds = { 500000, 3, 120, 7000000, 45 };
+    for (int nodeId : nodeIds) {
+        mesh.addNode(nodeId, nodeId, 0., 0.);
+    }
+    vector<int> iteratedIds;
+    for (const auto& node : mesh.nodes) {
+        iteratedIds.push_back(node.id);
+        BOOST_CHECK_EQUAL(node.id, node.x);
+    }
+    vector<int> expectedIds(nodeIds);
+    sort(expectedIds.begin(), expectedIds.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(expectedIds.begin(), expectedIds.end(), iteratedIds.begin(), iteratedIds.end());
+    BOOST_CHECK_EQUAL(3, mesh.nodes.getMinNodeId());
+    BOOST_CHECK_EQUAL(7000000, mesh.nodes.getMaxNodeId());
+    BOOST_CHECK_EQUAL(1, mesh.findNodePosition(3));
+    BOOST_CHECK(mesh.findNodePosition(4) == Node::UNAVAILABLE_NODE);
+}
+
+BOOST_AUTO_TEST_CASE( test_global_coordinates )
+{
+    Mesh mesh(LogLevel::INFO, "test");
+    CylindricalCoordinateSystem cylindrical(mesh, VectorialValue(1., 2., 3.), VectorialValue::X, VectorialValue::Y,
+            CoordinateSystem::GLOBAL_COORDINATE_SYSTEM, 7);
+    mesh.add(cylindrical);
+    const int cpPos = mesh.findOrReserveCoordinateSystem(cylindrical.getReference());
+    const int globalPos = mesh.addNode(1, 5., 6., 7.);
+    const int localPos = mesh.addNode(2, 2., 90., 1., cpPos);
+
+    const Node& localNode = mesh.findNode(localPos);
+    BOOST_CHECK_CLOSE(1., localNode.x, 1e-10);
+    BOOST_CHECK_CLOSE(4., localNode.y, 1e-10);
+    BOOST_CHECK_CLOSE(4., localNode.z, 1e-10);
+    BOOST_CHECK_EQUAL(2., localNode.lx);
+
+    const vector<double>& globalXs = mesh.getGlobalXs();
+    const vector<double>& globalYs = mesh.getGlobalYs();
+    BOOST_REQUIRE_EQUAL(2u, globalXs.size());
+    BOOST_CHECK_EQUAL(5., globalXs[globalPos]);
+    BOOST_CHECK_CLOSE(4., globalYs[localPos], 1e-10);
+    // Cached values must be the same as the ones computed on the fly
+    const Node& cachedNode = mesh.findNode(localPos);
+    BOOST_CHECK_EQUAL(localNode.x, cachedNode.x);
+    BOOST_CHECK_EQUAL(localNode.y, cachedNode.y);
+    BOOST_CHECK_EQUAL(localNode.z, cachedNode.z);
+
+    // Moving a node invalidates the cache
+    mesh.addNode(2, 3., 0., 1., cpPos);
+    BOOST_CHECK_CLOSE(4., mesh.findNode(localPos).x, 1e-10);
+    BOOST_CHECK_CLOSE(4., mesh.getGlobalXs()[localPos], 1e-10);
+    BOOST_CHECK_CLOSE(2., mesh.getGlobalYs()[localPos], 1e-10);
+}
@@ -275,6 +275,52 @@ BOOST_AUTO_TEST_CASE( test_create_skin2d ) {
 			expectedFace1NodeIds.begin(), expectedFace1NodeIds.end());
 }
 
+BOOST_AUTO_TEST_CASE( test_skin_batching ) {
+	unique_ptr<Model> model = createModelWith1HEXA8();
+	const auto& loadSet = make_shared<LoadSet>(*model, LoadSet::Type::LOAD, 1);
+	model->add(loadSet);
+	const auto& bottom = make_shared<NormalPressionFaceTwoNodes>(*model, loadSet, 50, 52, 1.0);
+	const auto& top = make_shared<NormalPressionFaceTwoNodes>(*model, loadSet, 54, 56, 1.0);
+	const auto& bottomAgain = make_shared<NormalPressionFaceTwoNodes>(*model, loadSet, 50, 52, 2.0);
+	for (const auto& pressure : {bottom, top, bottomAgain}) {
+		pressure->addCellId(1);
+		model->add(pressure);
+		model->addLoadingIntoLoadSet(*pressure, *loadSet);
+	}
+	model->finish();
+
+	// The bottom face is generated once, the two pressures of 1.0 become one loading
+	BOOST_CHECK_EQUAL(2, model->mesh.countCells(CellType::QUAD4));
+	BOOST_CHECK_EQUAL(2, model->loadings.size());
+	BOOST_CHECK_EQUAL(2, bottom->getCellsIncludingGroups().size());
+	BOOST_CHECK_EQUAL(1, bottomAgain->getCellsIncludingGroups().size());
+	BOOST_CHECK(bottom->containsCellPosition(bottomAgain->getCellsIncludingGroups().begin()->position));
+	BOOST_CHECK_EQUAL(1, model->elementSets.filter(ElementSet::Type::SKIN).size());
+	BOOST_CHECK_EQUAL(2, loadSet->size());
+}
+
+BOOST_AUTO_TEST_CASE( test_skin_batching_same_face ) {
+	unique_ptr<Model> model = createModelWith1HEXA8();
+	const auto& loadSet = make_shared<LoadSet>(*model, LoadSet::Type::LOAD, 1);
+	model->add(loadSet);
+	const auto& bottom = make_shared<NormalPressionFaceTwoNodes>(*model, loadSet, 50, 52, 1.0);
+	const auto& bottomAgain = make_shared<NormalPressionFaceTwoNodes>(*model, loadSet, 50, 52, 1.0);
+	for (const auto& pressure : {bottom, bottomAgain}) {
+		pressure->addCellId(1);
+		model->add(pressure);
+		model->addLoadingIntoLoadSet(*pressure, *loadSet);
+	}
+	model->finish();
+
+	// Two identical pressures on the same face add up: the skin cell is shared, the loadings are kept
+	BOOST_CHECK_EQUAL(1, model->mesh.countCells(CellType::QUAD4));
+	BOOST_CHECK_EQUAL(2, model->loadings.size());
+	BOOST_CHECK_EQUAL(1, bottom->getCellsIncludingGroups().size());
+	BOOST_CHECK_EQUAL(1, bottomAgain->getCellsIncludingGroups().size());
+	BOOST_CHECK(bottom->containsCellPosition(bottomAgain->getCellsIncludingGroups().begin()->position));
+	BOOST_CHECK_EQUAL(2, loadSet->size());
+}
+
 BOOST_AUTO_TEST_CASE(test_Analysis) {
 	Model model{"inputfile", "10.3", SolverName::NASTRAN};
 	double coords[12] = { -433., 250., 0., 433., 250., 0., 0., -500., 0., 0., 0., 1000. };
@@ -386,6 +432,64 @@ BOOST_AUTO_TEST_CASE( combined_loadset1 ) {
 	BOOST_CHECK_EQUAL(model.getLoadingsByLoadSet(combination).size(), 3);
 }
 
+BOOST_AUTO_TEST_CASE( test_bulk_nodal_force ) {
+	Model model{"inputfile", "10.3", SolverName::NASTRAN};
+	const auto& loadSet1 = make_shared<LoadSet>(model, LoadSet::Type::LOAD, 1);
+	model.add(loadSet1);
+	model.mesh.addNode(1, 0.0, 0.0, 0.0);
+	model.mesh.addNode(2, 1.0, 0.0, 0.0);
+	model.mesh.addNode(3, 2.0, 0.0, 0.0);
+	const auto& bulkForce = make_shared<BulkNodalForce>(model, loadSet1);
+	bulkForce->addEntry(2, VectorialValue(1.0, 0.0, 0.0), VectorialValue(0.0, 0.0, 0.0));
+	bulkForce->addEntry(1, VectorialValue(0.0, 2.0, 0.0), VectorialValue(0.0, 0.0, 0.0));
+	bulkForce->addEntry(2, VectorialValue(0.0, 0.0, 3.0), VectorialValue(0.0, 4.0, 0.0));
+	bulkForce->addEntry(3, VectorialValue(0.0, 0.0, 0.0), VectorialValue(0.0, 0.0, 0.0));
+	model.add(bulkForce);
+	BOOST_CHECK_EQUAL(bulkForce->entryCount(), 3);
+	BOOST_CHECK_EQUAL(bulkForce->nodePositions().size(), 2);
+	BOOST_CHECK_EQUAL(loadSet1->getLoadingsByType(Loading::Type::NODAL_FORCE).size(), 1);
+
+	const int position2 = model.mesh.findNodePosition(2);
+	BOOST_CHECK(bulkForce->getForceInGlobalCS(position2) == VectorialValue(1.0, 0.0, 3.0));
+	BOOST_CHECK(bulkForce->getMomentInGlobalCS(position2) == VectorialValue(0.0, 4.0, 0.0));
+	BOOST_CHECK_EQUAL(bulkForce->getDOFSForNode(position2), DOFS(DOF::DX) + DOF::DZ + DOF::RY);
+	BOOST_CHECK_THROW(bulkForce->getForceInGlobalCS(model.mesh.findNodePosition(3)), logic_error);
+
+	bulkForce->scale(2.0);
+	BOOST_CHECK(bulkForce->getForceInGlobalCS(model.mesh.findNodePosition(1)) == VectorialValue(0.0, 4.0, 0.0));
+	BOOST_CHECK(not bulkForce->ineffective());
+	bulkForce->scale(0.0);
+	BOOST_CHECK(bulkForce->ineffective());
+}
+
+BOOST_AUTO_TEST_CASE( test_bulk_nodal_force_local_cs ) {
+	Model model{"inputfile", "10.3", SolverName::NASTRAN};
+	const auto& loadSet1 = make_shared<LoadSet>(model, LoadSet::Type::LOAD, 1);
+	model.add(loadSet1);
+	CartesianCoordinateSystem cs(model.mesh, VectorialValue(1.0, 2.0, 3.0), VectorialValue(0.0, 1.0, 0.0),
+			VectorialValue(0.0, 0.0, 1.0), CoordinateSystem::GLOBAL_COORDINATE_SYSTEM, 7);
+	model.mesh.add(cs);
+	const int csPosition = model.mesh.findOrReserveCoordinateSystem(
+			Reference<CoordinateSystem>(CoordinateSystem::Type::ABSOLUTE, 7));
+	const int nodeCount = 100;
+	const auto& bulkForce = make_shared<BulkNodalForce>(model, loadSet1);
+	for (int i = 1; i <= nodeCount; i++) {
+		model.mesh.addNode(i, i, 0.0, 0.0);
+		bulkForce->addEntry(i, VectorialValue(1.0, 0.0, i), VectorialValue(0.0, 2.0, 0.0), csPosition);
+	}
+	model.add(bulkForce);
+
+	// What a writer does for each node of the loading
+	VectorialValue forceSum, momentSum;
+	for (int nodePosition = 0; nodePosition < nodeCount; nodePosition++) {
+		forceSum = forceSum + bulkForce->getForceInGlobalCS(nodePosition);
+		momentSum = momentSum + bulkForce->getMomentInGlobalCS(nodePosition);
+	}
+	const double n = nodeCount;
+	BOOST_CHECK(forceSum == VectorialValue(n * (n + 1) / 2, n, 0.0));
+	BOOST_CHECK(momentSum == VectorialValue(0.0, 0.0, 2 * n));
+}
+
 BOOST_AUTO_TEST_CASE(auto_analysis_linst) {
     ModelConfiguration configuration;
     configuration.autoDetectAnalysis = true;
@@ -571,6 +675,111 @@ BOOST_AUTO_TEST_CASE(test_spc_dof_remove) {
 	}
 }
 
+BOOST_AUTO_TEST_CASE(test_container_indexes) {
+	Model model{"containers", "10.3", SolverName::NASTRAN};
+	const auto& load1 = make_shared<LoadSet>(model, LoadSet::Type::LOAD, 1);
+	const auto& dload1 = make_shared<LoadSet>(model, LoadSet::Type::DLOAD, 1);
+	const auto& load2 = make_shared<LoadSet>(model, LoadSet::Type::LOAD, 2);
+	const auto& load3 = make_shared<LoadSet>(model, LoadSet::Type::LOAD, 3);
+	// Added out of id order: iterations still follow the ids
+	model.add(load2);
+	model.add(load1);
+	model.add(dload1);
+	BOOST_CHECK_EQUAL(model.loadSets.size(), 3);
+	BOOST_CHECK(model.loadSets.first() == load1);
+	BOOST_CHECK(model.loadSets.last() == load2);
+	const auto& loads = model.loadSets.filter(LoadSet::Type::LOAD);
+	BOOST_CHECK_EQUAL(loads.size(), 2);
+	BOOST_CHECK(loads[0] == load1);
+	BOOST_CHECK(model.loadSets.contains(LoadSet::Type::DLOAD));
+	BOOST_CHECK(not model.loadSets.contains(LoadSet::Type::EXCITEID));
+	BOOST_CHECK(model.loadSets.filter(LoadSet::Type::EXCITEID).empty());
+	BOOST_CHECK(model.loadSets.find(1) == load1);
+	BOOST_CHECK(model.loadSets.find(2) == load2);
+	BOOST_CHECK(model.loadSets.find(4) == nullptr);
+	BOOST_CHECK(model.loadSets.get(dload1->getId()) == dload1);
+
+	// Objects erased during an iteration are skipped, objects added with a greater id are visited
+	vector<int> visited;
+	for (const auto& loadSet : model.loadSets.filter(LoadSet::Type::LOAD)) {
+		visited.push_back(loadSet->getOriginalId());
+		if (loadSet == load1) {
+			model.loadSets.erase(load2->getReference());
+			model.add(load3);
+		}
+	}
+	const vector<int> expectedVisited = { 1, 3 };
+	BOOST_CHECK_EQUAL_COLLECTIONS(visited.begin(), visited.end(), expectedVisited.begin(), expectedVisited.end());
+	BOOST_CHECK(model.loadSets.find(2) == nullptr);
+	BOOST_CHECK(model.find(Reference<LoadSet>(LoadSet::Type::LOAD, 2)) == nullptr);
+	model.loadSets.erase(load1->getReference());
+	BOOST_CHECK(model.loadSets.find(1) == dload1);
+	const vector<shared_ptr<LoadSet>> all(model.loadSets.begin(), model.loadSets.end());
+	const vector<shared_ptr<LoadSet>> expectedAll = { dload1, load3 };
+	BOOST_CHECK(all == expectedAll);
+
+	// The loop variable stays valid when the loop body adds (reallocating the vectors) or erases
+	for (const auto& loadSet : model.loadSets.filter(LoadSet::Type::LOAD)) {
+		if (loadSet != load3) {
+			continue;
+		}
+		for (int original_id = 100; original_id < 200; original_id++) {
+			model.add(make_shared<LoadSet>(model, LoadSet::Type::LOAD, original_id));
+		}
+		BOOST_CHECK(loadSet == load3);
+		BOOST_CHECK_EQUAL(loadSet->getOriginalId(), 3);
+		model.loadSets.erase(load3->getReference());
+		BOOST_CHECK(loadSet == load3);
+		BOOST_CHECK_EQUAL(loadSet->getOriginalId(), 3);
+		break;
+	}
+	BOOST_CHECK(model.loadSets.find(3) == nullptr);
+	BOOST_CHECK_EQUAL(model.loadSets.filter(LoadSet::Type::LOAD).size(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(test_membership_index) {
+	Model model{"membership", "10.3", SolverName::NASTRAN};
+	const auto& constraintSet1 = make_shared<ConstraintSet>(model, ConstraintSet::Type::SPC, 1);
+	const auto& constraintSet2 = make_shared<ConstraintSet>(model, ConstraintSet::Type::MPC, 2);
+	model.add(constraintSet1);
+	model.add(constraintSet2);
+	const auto& spc = make_shared<SinglePointConstraint>(model, DOFS::ALL_DOFS, 0.0, 10);
+	const auto& lmpc = make_shared<LinearMultiplePointConstraint>(model, 0.0, 11);
+	model.add(spc);
+	model.add(lmpc);
+	model.addConstraintIntoConstraintSet(spc->getReference(), constraintSet1->getReference());
+	model.addConstraintIntoConstraintSet(lmpc->getReference(), constraintSet1->getReference());
+	model.addConstraintIntoConstraintSet(spc->getReference(), constraintSet2->getReference());
+
+	BOOST_CHECK_EQUAL(constraintSet1->size(), 2);
+	BOOST_CHECK_EQUAL(constraintSet1->getConstraintsByType(Constraint::Type::SPC).size(), 1);
+	BOOST_CHECK_EQUAL(constraintSet1->getConstraintsByType(Constraint::Type::LMPC).size(), 1);
+	BOOST_CHECK_EQUAL(constraintSet1->getConstraintsByType(Constraint::Type::RBE3).size(), 0);
+	BOOST_CHECK_EQUAL(model.getConstraintSetsByConstraint(spc->getReference()).size(), 2);
+	BOOST_CHECK_EQUAL(model.getConstraintSetsByConstraint(lmpc->getReference()).size(), 1);
+
+	// Adding a membership after a query must be seen by the next query
+	const auto& spc2 = make_shared<SinglePointConstraint>(model, DOFS::ALL_DOFS, 0.0, 12);
+	model.add(spc2);
+	model.addConstraintIntoConstraintSet(spc2->getReference(), constraintSet2->getReference());
+	BOOST_CHECK_EQUAL(constraintSet2->size(), 2);
+	BOOST_CHECK_EQUAL(model.getConstraintSetsByConstraint(spc2->getReference()).size(), 1);
+
+	model.remove(spc->getReference());
+	BOOST_CHECK_EQUAL(constraintSet1->size(), 1);
+	BOOST_CHECK_EQUAL(constraintSet1->getConstraintsByType(Constraint::Type::SPC).size(), 0);
+	BOOST_CHECK_EQUAL(constraintSet2->getConstraints().size(), 1);
+	BOOST_CHECK_EQUAL(model.getConstraintSetsByConstraint(spc->getReference()).size(), 0);
+
+	model.remove(lmpc->getReference(), constraintSet1->getReference());
+	BOOST_CHECK(constraintSet1->empty());
+	BOOST_CHECK_EQUAL(model.getConstraintSetsByConstraint(lmpc->getReference()).size(), 0);
+
+	// A member that is not in the model is reported and left out
+	model.addConstraintIntoConstraintSet(Reference<Constraint>(Constraint::Type::SPC, 99), constraintSet2->getReference());
+	BOOST_CHECK_EQUAL(model.getResolvedConstraints(constraintSet2->getReference()).size(), 1);
+	BOOST_CHECK_EQUAL(constraintSet2->getConstraints().size(), 1);
+}
 
 BOOST_AUTO_TEST_CASE( test_cdnoanalysis )
 {
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * Utility_benchmark.cpp
+ *
+ * Time of a node list written the way the .comm writer does, through a std::ofstream
+ * and through a BufferedOutputFile.
+ * Usage: Utility_benchmark [number of nodes (default 1000000)]
+ */
+
+#include "../../Abstract/Utility.h"
+#include "../../Abstract/MeshComponents.h"
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace vega;
+namespace fs = boost::filesystem;
+
+int main(int argc, char* argv[]) {
+	const int nodeCount = argc > 1 ? stoi(argv[1]) : 1000000;
+	const fs::path legacyPath = fs::temp_directory_path() / fs::unique_path("vega-%%%%-legacy.comm");
+	const fs::path bufferedPath = fs::temp_directory_path() / fs::unique_path("vega-%%%%-buffered.comm");
+
+	auto start = chrono::steady_clock::now();
+	{
+		ofstream out(legacyPath.string(), ios::out | ios::trunc);
+		for (int nodePosition = 0; nodePosition < nodeCount; nodePosition++) {
+			out << "'" << Node::MedName(nodePosition) << "',";
+			if (nodePosition % 6 == 5) {
+				out << endl << "                             ";
+			}
+		}
+	}
+	const auto legacyTime = chrono::steady_clock::now() - start;
+
+	start = chrono::steady_clock::now();
+	{
+		BufferedOutputFile out(bufferedPath.string());
+		for (int nodePosition = 0; nodePosition < nodeCount; nodePosition++) {
+			out << "'";
+			Node::writeMedName(out, nodePosition);
+			out << "',";
+			if (nodePosition % 6 == 5) {
+				out << endl << "                             ";
+			}
+		}
+		out.close();
+	}
+	const auto bufferedTime = chrono::steady_clock::now() - start;
+
+	cout << nodeCount << " nodes, " << fs::file_size(bufferedPath) / 1024 << " kB, ofstream: "
+			<< chrono::duration_cast<chrono::milliseconds>(legacyTime).count() << " ms, buffered: "
+			<< chrono::duration_cast<chrono::milliseconds>(bufferedTime).count() << " ms" << endl;
+	fs::remove(legacyPath);
+	fs::remove(bufferedPath);
+	return 0;
+}
@@ -6,7 +6,9 @@
 #define BOOST_TEST_MODULE utility_tests
 #include "build_properties.h"
 #include "../../Abstract/Utility.h"
+#include "../../Abstract/MeshComponents.h"
 #include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
 
 using namespace std;
 using namespace vega;
@@ -15,3 +17,98 @@ BOOST_AUTO_TEST_CASE( test_backtrace ) {
 	stacktrace(); // Only to check if this works
 	BOOST_CHECK(true);
 }
+
+BOOST_AUTO_TEST_CASE( test_profiler ) {
+	const shared_ptr<Profiler> profiler = make_shared<Profiler>(false);
+	long cells = 0;
+	const auto& counter = [&cells]() {return Profiler::Counts(0, cells, 0);};
+	{
+		Profiler::Scope outer(profiler, "outer", counter);
+		{
+			Profiler::Scope inner(profiler, "inner \"quoted\"", counter);
+			cells += 3;
+		}
+		cells += 2;
+	}
+	{
+		// Without profiler nothing is measured
+		Profiler::Scope ignored(nullptr, "ignored", counter);
+	}
+	const auto& phases = profiler->getPhases();
+	BOOST_REQUIRE_EQUAL(2u, phases.size());
+	BOOST_CHECK_EQUAL("outer", phases[0].name);
+	BOOST_CHECK_EQUAL(0, phases[0].depth);
+	BOOST_CHECK_EQUAL(5, phases[0].after.cells - phases[0].before.cells);
+	BOOST_CHECK_EQUAL(1, phases[1].depth);
+	BOOST_CHECK_EQUAL(3, phases[1].after.cells - phases[1].before.cells);
+	BOOST_CHECK(phases[0].seconds >= phases[1].seconds);
+	BOOST_CHECK(phases[1].peakRssAfter >= phases[1].peakRssBefore);
+	BOOST_CHECK_THROW(profiler->stop(), logic_error);
+
+	ostringstream json;
+	profiler->writeJson(json);
+	BOOST_CHECK(json.str().find("\"name\": \"inner \\\"quoted\\\"\"") != string::npos);
+	BOOST_CHECK(json.str().find("\"cellsDelta\": 5") != string::npos);
+}
+
+BOOST_AUTO_TEST_CASE( test_format_general ) {
+	char number[32];
+	for (double value : {0.0, -0.0, 1.0, -250019.5, 1.0 / 3.0, 1e-300, 6.02214076e23, DBL_MAX}) {
+		for (int precision : {6, DBL_DIG}) {
+			ostringstream expected;
+			expected.precision(precision);
+			expected << value;
+			BOOST_CHECK_EQUAL(expected.str(), string(number, formatGeneral(value, precision, number)));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( test_buffered_output_file ) {
+	char digits[20];
+	char* end = digits + sizeof(digits);
+	BOOST_CHECK_EQUAL("0", string(formatDecimal(0, end), end));
+	BOOST_CHECK_EQUAL("-42", string(formatDecimal(-42, end), end));
+	BOOST_CHECK_EQUAL("9223372036854775807", string(formatDecimal(9223372036854775807LL, end), end));
+
+	// Writes a node list the way the .comm writer does, enough to flush several blocks
+	// (timings are in Utility_benchmark)
+	const int nodeCount = 200000;
+	const boost::filesystem::path tempDir = boost::filesystem::temp_directory_path();
+	const string legacyPath = (tempDir / boost::filesystem::unique_path("vega-%%%%-legacy.comm")).string();
+	const string bufferedPath = (tempDir / boost::filesystem::unique_path("vega-%%%%-buffered.comm")).string();
+
+	{
+		ofstream out(legacyPath, ios::out | ios::trunc);
+		for (int nodePosition = 0; nodePosition < nodeCount; nodePosition++) {
+			out << "'" << Node::MedName(nodePosition) << "',";
+			if (nodePosition % 6 == 5) {
+				out << endl << "                             ";
+			}
+		}
+	}
+
+	{
+		BufferedOutputFile out(bufferedPath);
+		BOOST_REQUIRE(out.is_open());
+		for (int nodePosition = 0; nodePosition < nodeCount; nodePosition++) {
+			out << "'";
+			Node::writeMedName(out, nodePosition);
+			out << "',";
+			if (nodePosition % 6 == 5) {
+				out << endl << "                             ";
+			}
+		}
+		out.close();
+		BOOST_CHECK(out.good());
+	}
+
+	ifstream legacy(legacyPath);
+	ifstream buffered(bufferedPath);
+	const string legacyText((istreambuf_iterator<char>(legacy)), istreambuf_iterator<char>());
+	const string bufferedText((istreambuf_iterator<char>(buffered)), istreambuf_iterator<char>());
+	BOOST_CHECK_GT(bufferedText.size(), 2 * BufferedOutputFile::BLOCK_SIZE);
+	BOOST_CHECK(legacyText == bufferedText);
+	BOOST_CHECK_EQUAL(string("'N1','N2',"), bufferedText.substr(0, 10));
+	boost::filesystem::remove(legacyPath);
+	boost::filesystem::remove(bufferedPath);
+}
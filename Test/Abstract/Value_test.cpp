@@ -36,6 +36,23 @@ BOOST_AUTO_TEST_CASE( test_vectorial_value ) {
 
 }
 
+BOOST_AUTO_TEST_CASE( test_vectorial_value_triplets ) {
+	double xyz[6] = { 1., 2., 3., -4., 0., 0.5 };
+	VectorialValue::scaleTriplets(xyz, 2, 2.0);
+	const double expectedScaled[6] = { 2., 4., 6., -8., 0., 1. };
+	BOOST_CHECK_EQUAL_COLLECTIONS(xyz, xyz + 6, expectedScaled, expectedScaled + 6);
+	// Only count triplets are scaled
+	VectorialValue::scaleTriplets(xyz, 1, 0.5);
+	const double expectedFirst[6] = { 1., 2., 3., -8., 0., 1. };
+	BOOST_CHECK_EQUAL_COLLECTIONS(xyz, xyz + 6, expectedFirst, expectedFirst + 6);
+
+	// out = origin + u*e1 + v*e2 + w*e3, in place
+	VectorialValue::combine(VectorialValue(10., 20., 30.), VectorialValue::Y, VectorialValue::Z, VectorialValue::X,
+			xyz, xyz, 2);
+	const double expectedCombined[6] = { 13., 21., 32., 11., 12., 30. };
+	BOOST_CHECK_EQUAL_COLLECTIONS(xyz, xyz + 6, expectedCombined, expectedCombined + 6);
+}
+
 BOOST_AUTO_TEST_CASE( valueOrReference_val ) {
 	ValueOrReference val1(2.3);
 	ValueOrReference val2(2);
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * MedWriter_benchmark.cpp
+ *
+ * Time of each stage of MedWriter::writeMED on a synthetic HEXA8 block mesh.
+ * Usage: MedWriter_benchmark [cells by side (default 171, about 5M cells)]
+ */
+
+#include "../../Abstract/Model.h"
+#include "../../Aster/MedWriter.h"
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace vega;
+using namespace aster;
+namespace fs = boost::filesystem;
+
+int main(int argc, char* argv[]) {
+	const int side = argc > 1 ? stoi(argv[1]) : 171;
+	const int nodesBySide = side + 1;
+	auto start = chrono::steady_clock::now();
+	Model model{"medwriter_benchmark", "unknown", SolverName::NASTRAN};
+	auto nodeId = [nodesBySide](int i, int j, int k) {
+		return 1 + i + nodesBySide * (j + nodesBySide * k);
+	};
+	for (int k = 0; k < nodesBySide; k++) {
+		for (int j = 0; j < nodesBySide; j++) {
+			for (int i = 0; i < nodesBySide; i++) {
+				model.mesh.addNode(nodeId(i, j, k), i, j, k);
+			}
+		}
+	}
+	model.mesh.reserveCells(CellType::HEXA8, static_cast<size_t>(side) * side * side);
+	// One cell group by layer of cells, one node group by face of the block
+	int cellId = 1;
+	for (int k = 0; k < side; k++) {
+		const auto& layer = model.mesh.createCellGroup("LAYER" + to_string(k));
+		for (int j = 0; j < side; j++) {
+			for (int i = 0; i < side; i++) {
+				model.mesh.addCell(cellId, CellType::HEXA8, {nodeId(i, j, k), nodeId(i + 1, j, k),
+						nodeId(i + 1, j + 1, k), nodeId(i, j + 1, k), nodeId(i, j, k + 1),
+						nodeId(i + 1, j, k + 1), nodeId(i + 1, j + 1, k + 1), nodeId(i, j + 1, k + 1)});
+				layer->addCellId(cellId++);
+			}
+		}
+	}
+	const auto& bottom = model.mesh.findOrCreateNodeGroup("BOTTOM");
+	const auto& left = model.mesh.findOrCreateNodeGroup("LEFT");
+	for (int a = 0; a < nodesBySide; a++) {
+		for (int b = 0; b < nodesBySide; b++) {
+			bottom->addNodeId(nodeId(a, b, 0));
+			left->addNodeId(nodeId(0, a, b));
+		}
+	}
+	cout << "Mesh: " << model.mesh.countNodes() << " nodes, " << model.mesh.countCells() << " cells, built in "
+			<< chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count() << " ms" << endl;
+
+	model.profiler = make_shared<Profiler>(false);
+	const fs::path medPath = fs::temp_directory_path() / fs::unique_path("medwriter_benchmark_%%%%-%%%%.med");
+	start = chrono::steady_clock::now();
+	MedWriter medWriter;
+	medWriter.writeMED(model, medPath.string());
+	const auto writeTime = chrono::steady_clock::now() - start;
+	for (const auto& phase : model.profiler->getPhases()) {
+		cout << phase.name << ": " << static_cast<long>(phase.seconds * 1000) << " ms" << endl;
+	}
+	cout << "writeMED: " << chrono::duration_cast<chrono::milliseconds>(writeTime).count() << " ms, "
+			<< fs::file_size(medPath) / 1024 / 1024 << " MB" << endl;
+	fs::remove(medPath);
+	return 0;
+}
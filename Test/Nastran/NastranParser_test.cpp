@@ -13,7 +13,10 @@
 #include "build_properties.h"
 #include <boost/test/unit_test.hpp>
 #include <boost/filesystem.hpp>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #if defined VDEBUG && defined __GNUC_ && !defined(_WIN32)
 #include <valgrind/memcheck.h>
 #endif
@@ -163,6 +166,62 @@ BOOST_AUTO_TEST_CASE(nastran_issue23_doubleload) {
 	}
 }
 
+BOOST_AUTO_TEST_CASE(nastran_spc_grouping) {
+	string testLocation = fs::path(
+		PROJECT_BASE_DIR "/testdata/unitTest/nastranparser/spc_grouping.nas").make_preferred().string();
+	nastran::NastranParser parser;
+	try {
+		// Parsed twice with the same parser: the grouping of a parse must not leak into the next one
+		for (int pass = 0; pass < 2; pass++) {
+			const unique_ptr<Model> model = parser.parse(
+				ConfigurationParameters{testLocation, SolverName::CODE_ASTER, "", ""});
+			BOOST_CHECK_EQUAL(model->constraints.filter(Constraint::Type::SPC).size(), 4);
+
+			// SPC1 cards with the same set and DOFs share a constraint, other DOFs get their own
+			const auto& spcs = model->getConstraintsByConstraintSet(Reference<ConstraintSet>(ConstraintSet::Type::SPC, 1));
+			BOOST_REQUIRE_EQUAL(spcs.size(), 2);
+			const int position1 = model->mesh.findNodePosition(1);
+			const int position6 = model->mesh.findNodePosition(6);
+			for (const auto& constraint : spcs) {
+				const auto& spc = static_pointer_cast<SinglePointConstraint>(constraint);
+				if (spc->nodePositions().count(position1)) {
+					BOOST_CHECK_EQUAL(spc->nodePositions().size(), 2);
+					BOOST_CHECK(spc->nodePositions().count(model->mesh.findNodePosition(2)));
+					BOOST_CHECK_EQUAL(spc->getDOFSForNode(position1), DOFS::ALL_DOFS);
+				} else {
+					BOOST_CHECK_EQUAL(spc->nodePositions().size(), 1);
+					BOOST_CHECK(spc->nodePositions().count(position6));
+					BOOST_CHECK_EQUAL(spc->getDOFSForNode(position6), DOFS::TRANSLATIONS);
+				}
+			}
+
+			// GRID PS fields: one constraint by code
+			const auto& psSpcs = model->getConstraintsByConstraintSet(model->commonConstraintSet->getReference());
+			BOOST_REQUIRE_EQUAL(psSpcs.size(), 2);
+			const int position3 = model->mesh.findNodePosition(3);
+			const int position5 = model->mesh.findNodePosition(5);
+			for (const auto& constraint : psSpcs) {
+				const auto& spc = static_pointer_cast<SinglePointConstraint>(constraint);
+				if (spc->nodePositions().count(position3)) {
+					BOOST_CHECK_EQUAL(spc->nodePositions().size(), 2);
+					BOOST_CHECK(spc->nodePositions().count(model->mesh.findNodePosition(4)));
+					BOOST_CHECK_EQUAL(spc->getDOFSForNode(position3), DOFS::TRANSLATIONS);
+				} else {
+					BOOST_CHECK_EQUAL(spc->nodePositions().size(), 1);
+					BOOST_CHECK(spc->nodePositions().count(position5));
+					BOOST_CHECK_EQUAL(spc->getDOFSForNode(position5), DOFS::ROTATIONS);
+				}
+			}
+		}
+	}
+	catch (exception& e) {
+		cerr << e.what() << endl;
+		BOOST_TEST_MESSAGE(string("Application exception") + e.what());
+
+		BOOST_FAIL(string("Parse threw exception ") + e.what());
+	}
+}
+
 BOOST_AUTO_TEST_CASE(nastran_issue22_lowercasecommands) {
 	string testLocation = fs::path(
 		PROJECT_BASE_DIR "/testdata/unitTest/nastranparser/github_issue22.nas").make_preferred().string();
@@ -307,4 +366,157 @@ BOOST_AUTO_TEST_CASE(test_github_issue28_conm2_coord) {
 }
 
 
+/**
+ * Compares the models read by the sequential and the parallel parsing of the BULK section.
+ */
+static void checkSameModel(const Model& expected, const Model& actual) {
+	BOOST_REQUIRE_EQUAL(expected.mesh.countNodes(), actual.mesh.countNodes());
+	auto actualNode = actual.mesh.nodes.begin();
+	map<int, int> csPositions;
+	for (const auto& node : expected.mesh.nodes) {
+		const Node& other = *actualNode;
+		BOOST_CHECK_EQUAL(node.id, other.id);
+		BOOST_CHECK_EQUAL(node.position, other.position);
+		BOOST_CHECK_EQUAL(node.lx, other.lx);
+		BOOST_CHECK_EQUAL(node.ly, other.ly);
+		BOOST_CHECK_EQUAL(node.lz, other.lz);
+		// Coordinate system positions are numbered across models: they must only match one to one
+		BOOST_CHECK_EQUAL(csPositions.insert({node.positionCS, other.positionCS}).first->second, other.positionCS);
+		BOOST_CHECK_EQUAL(csPositions.insert({node.displacementCS, other.displacementCS}).first->second, other.displacementCS);
+		++actualNode;
+	}
+	BOOST_REQUIRE_EQUAL(expected.mesh.countCells(), actual.mesh.countCells());
+	for (const auto& cellType : expected.mesh.cells.cellTypes()) {
+		BOOST_REQUIRE_EQUAL(expected.mesh.countCells(cellType), actual.mesh.countCells(cellType));
+		auto actualCell = actual.mesh.cells.cells_begin(cellType);
+		for (auto it = expected.mesh.cells.cells_begin(cellType); it != expected.mesh.cells.cells_end(cellType); ++it) {
+			const Cell& cell = *it;
+			const Cell& other = *actualCell;
+			BOOST_CHECK_EQUAL(cell.id, other.id);
+			BOOST_CHECK_EQUAL(cell.position, other.position);
+			BOOST_CHECK_EQUAL(cell.elementId, other.elementId);
+			BOOST_CHECK_EQUAL(cell.offset, other.offset);
+			BOOST_CHECK_EQUAL_COLLECTIONS(cell.nodeIds.begin(), cell.nodeIds.end(), other.nodeIds.begin(), other.nodeIds.end());
+			++actualCell;
+		}
+	}
+	const auto& cellGroups = expected.mesh.getCellGroups();
+	const auto& otherCellGroups = actual.mesh.getCellGroups();
+	BOOST_REQUIRE_EQUAL(cellGroups.size(), otherCellGroups.size());
+	for (size_t i = 0; i < cellGroups.size(); i++) {
+		BOOST_CHECK_EQUAL(cellGroups[i]->getName(), otherCellGroups[i]->getName());
+		BOOST_CHECK_EQUAL(cellGroups[i]->getComment(), otherCellGroups[i]->getComment());
+		const auto& cellIds = cellGroups[i]->cellIds();
+		const auto& otherCellIds = otherCellGroups[i]->cellIds();
+		BOOST_CHECK_EQUAL_COLLECTIONS(cellIds.begin(), cellIds.end(), otherCellIds.begin(), otherCellIds.end());
+	}
+	BOOST_CHECK_EQUAL(expected.materials.size(), actual.materials.size());
+	BOOST_CHECK_EQUAL(expected.elementSets.size(), actual.elementSets.size());
+	BOOST_CHECK_EQUAL(expected.constraints.size(), actual.constraints.size());
+	BOOST_CHECK_EQUAL(expected.loadings.size(), actual.loadings.size());
+}
+
+BOOST_AUTO_TEST_CASE(nastran_parallel_bulk) {
+	// Short format fields
+	auto line = [](const vector<string>& fields) {
+		ostringstream oss;
+		for (const auto& field : fields) {
+			oss << left << setw(8) << field;
+		}
+		return oss.str() + "\n";
+	};
+	const int n = 12;
+	auto gridId = [n](int i, int j, int k) {
+		return 1 + i + n * (j + n * k);
+	};
+	ostringstream deck;
+	deck << "SOL 101\nCEND\nBEGIN BULK\n";
+	deck << line({"CORD2R", "5", "", "0.", "0.", "0.", "0.", "0.", "1."}) << line({"", "1.", "0.", "0."});
+	deck << "$HMNAME COMP                 1\"solid\"\n";
+	deck << line({"PSOLID", "1", "1"}) << line({"PSHELL", "2", "1", "0.1"}) << line({"MAT1", "1", "210000.", "", "0.3"});
+	for (int k = 0; k < n; k++) {
+		if (k == n / 2) {
+			// Changes the default displacement system of the following grids
+			deck << line({"GRDSET", "", "", "", "", "", "5"});
+			deck << "$HMNAME COMP                 2\"skin\"\n";
+		}
+		for (int j = 0; j < n; j++) {
+			for (int i = 0; i < n; i++) {
+				const int id = gridId(i, j, k);
+				const string x = to_string(i) + ".", y = to_string(j) + ".", z = to_string(k) + ".";
+				if (id % 7 == 0) {
+					deck << "GRID," << id << ",," << x << "," << y << "," << z << "\n";
+				} else if (id % 11 == 0) {
+					deck << line({"GRID", to_string(id), "5", x, y, z});
+				} else if (id % 13 == 0) {
+					deck << left << setw(8) << "GRID*" << right << setw(16) << id << setw(16) << "" << setw(16) << x
+							<< setw(16) << y << "\n" << left << setw(8) << "*" << right << setw(16) << z << "\n";
+				} else {
+					deck << line({"GRID", to_string(id), "", x, y, z});
+				}
+			}
+		}
+	}
+	int cellId = 1;
+	for (int k = 0; k + 1 < n; k++) {
+		for (int j = 0; j + 1 < n; j++) {
+			for (int i = 0; i + 1 < n; i++) {
+				const vector<int> nodes = { gridId(i, j, k), gridId(i + 1, j, k), gridId(i + 1, j + 1, k), gridId(i, j + 1, k),
+						gridId(i, j, k + 1), gridId(i + 1, j, k + 1), gridId(i + 1, j + 1, k + 1), gridId(i, j + 1, k + 1) };
+				if ((i + j) % 3 == 0) {
+					deck << line({"CTETRA", to_string(cellId++), "1", to_string(nodes[0]), to_string(nodes[1]), to_string(nodes[3]), to_string(nodes[4])});
+				} else {
+					deck << line({"CHEXA", to_string(cellId++), "1", to_string(nodes[0]), to_string(nodes[1]), to_string(nodes[2]),
+							to_string(nodes[3]), to_string(nodes[4]), to_string(nodes[5]), "+H" + to_string(cellId)});
+					deck << line({"+H" + to_string(cellId), to_string(nodes[6]), to_string(nodes[7])});
+				}
+			}
+		}
+	}
+	for (int j = 0; j + 1 < n; j++) {
+		for (int i = 0; i + 1 < n; i++) {
+			const string theta = (i == j) ? "30." : "";
+			deck << line({"CQUAD4", to_string(cellId++), "2", to_string(gridId(i, j, 0)), to_string(gridId(i + 1, j, 0)),
+					to_string(gridId(i + 1, j + 1, 0)), to_string(gridId(i, j + 1, 0)), theta});
+			deck << line({"CTRIA3", to_string(cellId++), "2", to_string(gridId(i, j, n - 1)), to_string(gridId(i + 1, j, n - 1)),
+					to_string(gridId(i + 1, j + 1, n - 1))});
+		}
+	}
+	deck << line({"SPC1", "1", "123", "1", "THRU", "12"});
+	deck << "ENDDATA\n";
+
+	const fs::path deckPath = fs::temp_directory_path() / fs::unique_path("parallel_bulk_%%%%-%%%%.dat");
+	{
+		ofstream deckFile(deckPath.string());
+		deckFile << deck.str();
+	}
+	const ConfigurationParameters configuration{deckPath.string(), SolverName::CODE_ASTER, "", ""};
+	nastran::NastranParser sequentialParser;
+	sequentialParser.setBulkParsingThreads(1);
+	const unique_ptr<Model> sequentialModel = sequentialParser.parse(configuration);
+	nastran::NastranParser parallelParser;
+	parallelParser.setBulkParsingThreads(4, 0);
+	const unique_ptr<Model> parallelModel = parallelParser.parse(configuration);
+	fs::remove(deckPath);
+
+	BOOST_CHECK_EQUAL(n * n * n, sequentialModel->mesh.countNodes());
+	BOOST_CHECK_EQUAL(cellId - 1, sequentialModel->mesh.countCells());
+	checkSameModel(*sequentialModel, *parallelModel);
+}
+
+BOOST_AUTO_TEST_CASE(nastran_parallel_bulk_testdata) {
+	for (const string file : { "/testdata/nastran/alneos/test4a/test4a.dat", "/testdata/unitTest/nastranparser/include.dat" }) {
+		const ConfigurationParameters configuration{fs::path(PROJECT_BASE_DIR + file).make_preferred().string(),
+				SolverName::CODE_ASTER, "", ""};
+		nastran::NastranParser sequentialParser;
+		sequentialParser.setBulkParsingThreads(1);
+		const unique_ptr<Model> sequentialModel = sequentialParser.parse(configuration);
+		nastran::NastranParser parallelParser;
+		parallelParser.setBulkParsingThreads(3, 0);
+		const unique_ptr<Model> parallelModel = parallelParser.parse(configuration);
+		checkSameModel(*sequentialModel, *parallelModel);
+	}
+}
+
+
 //____________________________________________________________________________//
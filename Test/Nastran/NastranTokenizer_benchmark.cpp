@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * NastranTokenizer_benchmark.cpp
+ *
+ * Time of the single pass field decoder against the former conversion
+ * (normalization of the string then lexical_cast).
+ * Usage: NastranTokenizer_benchmark [rounds (default 100000)]
+ */
+
+#include "../../Nastran/NastranTokenizer.h"
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace vega;
+using namespace nastran;
+
+int main(int argc, char* argv[]) {
+	const int rounds = argc > 1 ? stoi(argv[1]) : 100000;
+	const vector<string> reals = { "7.0", ".7E1", "0.7+1", ".70+1", "7.E+0", "70.-1", "5.000388 D+5",
+			"8.9553", "108.9553", "1.00000000E+00", "1.5-3", "2.", "4.", "51.0", "100.0" };
+	const vector<string> ints = { "123456789", "12345", "1234567", "89", "125505" };
+
+	auto legacyDouble = [](string value) {
+		boost::replace_all(value, "d", "e");
+		boost::replace_all(value, "D", "E");
+		boost::algorithm::erase_all(value, " ");
+		size_t position = value.find_first_of("+-", 1);
+		if (position != string::npos and position != value.find_first_of("eE", 1) + 1) {
+			value.insert(position, "E");
+		}
+		return boost::lexical_cast<double>(value);
+	};
+
+	double legacySum = 0;
+	auto start = chrono::steady_clock::now();
+	for (int round = 0; round < rounds; round++) {
+		for (const auto& real : reals) {
+			legacySum += legacyDouble(real);
+		}
+		for (const auto& integer : ints) {
+			legacySum += boost::lexical_cast<int>(integer);
+		}
+	}
+	const auto legacyTime = chrono::steady_clock::now() - start;
+
+	double decodedSum = 0;
+	start = chrono::steady_clock::now();
+	for (int round = 0; round < rounds; round++) {
+		for (const auto& real : reals) {
+			double value = 0;
+			NastranTokenizer::decodeDouble(real, value);
+			decodedSum += value;
+		}
+		for (const auto& integer : ints) {
+			int value = 0;
+			NastranTokenizer::decodeInt(integer, value);
+			decodedSum += value;
+		}
+	}
+	const auto decodedTime = chrono::steady_clock::now() - start;
+
+	cout << rounds * (reals.size() + ints.size()) << " fields, lexical_cast: "
+			<< chrono::duration_cast<chrono::milliseconds>(legacyTime).count() << " ms, decode: "
+			<< chrono::duration_cast<chrono::milliseconds>(decodedTime).count() << " ms (sums "
+			<< legacySum << ", " << decodedSum << ")" << endl;
+	return 0;
+}
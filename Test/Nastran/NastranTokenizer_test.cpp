@@ -24,6 +24,8 @@
 #define BOOST_TEST_MODULE nastran_tokenizer_tests
 #include <boost/test/unit_test.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
 #include <cstddef>
 #include <fstream>
 #include <vector>
@@ -493,3 +495,148 @@ BOOST_AUTO_TEST_CASE(nastran_cord2c_multiline) {
     BOOST_CHECK_EQUAL(100.0, tok.nextDouble());
     BOOST_CHECK_EQUAL(0.0, tok.nextDouble());
 }
+
+BOOST_AUTO_TEST_CASE(nastran_buffer_same_as_stream) {
+    const string nastranLines =
+           "$ comment\n"
+           "GRID*   " "               1" "               0" "  1.00000000E+00" "  2.00000000E+00\n"
+           "*       " "             3.0" "               0\n"
+           "CQUAD4  1       1       1       2\t3\t4\n"
+           "chexa, 10, 1, 2, 3, 4, 5, 6, 7, +HX1\n"
+           "+HX1, 8, 9\n"
+           "FORCE   1       1       0       1.5-3   1.0     0.0     0.0  $ trailing";
+    istringstream istr(nastranLines);
+    NastranTokenizer streamTok(istr);
+    NastranTokenizer bufferTok(nastranLines.data(), nastranLines.data() + nastranLines.size());
+    streamTok.bulkSection();
+    bufferTok.bulkSection();
+    streamTok.nextLine();
+    bufferTok.nextLine();
+    while (streamTok.nextSymbolType != NastranTokenizer::SymbolType::SYMBOL_EOF) {
+        BOOST_REQUIRE(bufferTok.nextSymbolType == NastranTokenizer::SymbolType::SYMBOL_KEYWORD);
+        BOOST_CHECK_EQUAL(streamTok.currentRawDataLine(), bufferTok.currentRawDataLine());
+        BOOST_CHECK_EQUAL(streamTok.getLineNumber(), bufferTok.getLineNumber());
+        const auto& streamFields = streamTok.currentDataLine();
+        const auto& bufferFields = bufferTok.currentDataLine();
+        BOOST_CHECK_EQUAL_COLLECTIONS(streamFields.begin(), streamFields.end(), bufferFields.begin(), bufferFields.end());
+        streamTok.nextLine();
+        bufferTok.nextLine();
+    }
+    BOOST_CHECK(bufferTok.nextSymbolType == NastranTokenizer::SymbolType::SYMBOL_EOF);
+}
+
+BOOST_AUTO_TEST_CASE(nastran_buffer_fields) {
+    const string nastranLines =
+           "GRID*   " "               1" "               0" "  1.00000000E+00" "  2.00000000E+00\n"
+           "*       " "             3.0" "               0\n";
+    NastranTokenizer tok(nastranLines.data(), nastranLines.data() + nastranLines.size());
+    tok.bulkSection();
+    tok.nextLine();
+    BOOST_CHECK_EQUAL("GRID", tok.nextString());
+    BOOST_CHECK_EQUAL(1, tok.nextInt());
+    BOOST_CHECK_EQUAL(0, tok.nextInt());
+    BOOST_CHECK_EQUAL(1.0, tok.nextDouble());
+    BOOST_CHECK_EQUAL(2.0, tok.nextDouble());
+    BOOST_CHECK_EQUAL(3.0, tok.nextDouble());
+    BOOST_CHECK_EQUAL(0, tok.nextInt());
+    tok.nextLine();
+    BOOST_CHECK(tok.nextSymbolType == NastranTokenizer::SymbolType::SYMBOL_EOF);
+}
+
+BOOST_AUTO_TEST_CASE(nastran_decode_fields) {
+    double d = -1;
+    BOOST_CHECK(NastranTokenizer::decodeDouble("7.0", d));
+    BOOST_CHECK_EQUAL(7.0, d);
+    BOOST_CHECK(NastranTokenizer::decodeDouble(".7E1", d));
+    BOOST_CHECK_EQUAL(7.0, d);
+    BOOST_CHECK(NastranTokenizer::decodeDouble("0.7+1", d));
+    BOOST_CHECK_EQUAL(7.0, d);
+    BOOST_CHECK(NastranTokenizer::decodeDouble("70.-1", d));
+    BOOST_CHECK_EQUAL(7.0, d);
+    BOOST_CHECK(NastranTokenizer::decodeDouble("5.000388 D+5", d));
+    BOOST_CHECK_EQUAL(500038.8, d);
+    BOOST_CHECK(NastranTokenizer::decodeDouble("-1.5-3", d));
+    BOOST_CHECK_EQUAL(-1.5E-3, d);
+    BOOST_CHECK(NastranTokenizer::decodeDouble("1.234567890123456789012E-300", d));
+    BOOST_CHECK_EQUAL(1.234567890123456789012E-300, d);
+    d = -1;
+    BOOST_CHECK(not NastranTokenizer::decodeDouble("", d));
+    BOOST_CHECK(not NastranTokenizer::decodeDouble(".", d));
+    BOOST_CHECK(not NastranTokenizer::decodeDouble("1.5E", d));
+    BOOST_CHECK(not NastranTokenizer::decodeDouble("1.5.3", d));
+    BOOST_CHECK(not NastranTokenizer::decodeDouble("THRU", d));
+    BOOST_CHECK_EQUAL(-1, d);
+
+    int i = -1;
+    BOOST_CHECK(NastranTokenizer::decodeInt("-2147483648", i));
+    BOOST_CHECK_EQUAL(numeric_limits<int>::min(), i);
+    BOOST_CHECK(NastranTokenizer::decodeInt("+125505", i));
+    BOOST_CHECK_EQUAL(125505, i);
+    BOOST_CHECK(not NastranTokenizer::decodeInt("2147483648", i));
+    BOOST_CHECK(not NastranTokenizer::decodeInt("1.0", i));
+    BOOST_CHECK(not NastranTokenizer::decodeInt("-", i));
+    BOOST_CHECK_EQUAL(125505, i);
+}
+
+/**
+ * Compares the single pass decoder with the former conversion (normalization
+ * of the string then lexical_cast) on the fields used in this file.
+ * Timings are in NastranTokenizer_benchmark.
+ */
+BOOST_AUTO_TEST_CASE(nastran_decode_legacy) {
+    const vector<string> reals = { "7.0", ".7E1", "0.7+1", ".70+1", "7.E+0", "70.-1", "5.000388 D+5",
+            "8.9553", "108.9553", "1.00000000E+00", "1.5-3", "2.", "4.", "51.0", "100.0" };
+    const vector<string> ints = { "123456789", "12345", "1234567", "89", "125505" };
+
+    auto legacyDouble = [](string value) {
+        boost::replace_all(value, "d", "e");
+        boost::replace_all(value, "D", "E");
+        boost::algorithm::erase_all(value, " ");
+        size_t position = value.find_first_of("+-", 1);
+        if (position != string::npos and position != value.find_first_of("eE", 1) + 1) {
+            value.insert(position, "E");
+        }
+        return boost::lexical_cast<double>(value);
+    };
+
+    for (const auto& real : reals) {
+        double value = 0;
+        BOOST_REQUIRE(NastranTokenizer::decodeDouble(real, value));
+        BOOST_CHECK_EQUAL(legacyDouble(real), value);
+    }
+    for (const auto& integer : ints) {
+        int value = 0;
+        BOOST_REQUIRE(NastranTokenizer::decodeInt(integer, value));
+        BOOST_CHECK_EQUAL(boost::lexical_cast<int>(integer), value);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(nastran_input_context) {
+    const fs::path deckPath = fs::temp_directory_path() / fs::unique_path("input_context_%%%%-%%%%.dat");
+    {
+        ofstream deckFile(deckPath.string());
+        for (int i = 1; i <= 3000; i++) {
+            deckFile << "GRID    " << i << "\n";
+        }
+    }
+    ifstream deck(deckPath.string());
+    NastranTokenizer tokenizer(deck, LogLevel::INFO, deckPath.string());
+    tokenizer.bulkSection();
+    for (int i = 1; i <= 2500; i++) {
+        tokenizer.nextLine();
+    }
+    BOOST_CHECK_EQUAL(tokenizer.nextString(), "GRID");
+    BOOST_CHECK_EQUAL(tokenizer.nextInt(), 2500);
+    const InputContext inputContext = tokenizer.getInputContext();
+    BOOST_CHECK_EQUAL(inputContext.lineNumber, 2500);
+    BOOST_CHECK_EQUAL(inputContext.fileName(), deckPath.string());
+    BOOST_CHECK_EQUAL(inputContext.line(), "GRID    2500");
+    // Contexts are compact handles: the text is read back from the file
+    BOOST_CHECK_EQUAL(InputContext::registerFile(deckPath.string()), inputContext.fileIndex);
+    tokenizer.keepInputContext(false);
+    BOOST_CHECK_EQUAL(tokenizer.getInputContext().lineNumber, -1);
+    BOOST_CHECK_EQUAL(tokenizer.getInputContext().line(), "");
+    deck.close();
+    fs::remove(deckPath);
+    BOOST_CHECK_EQUAL(inputContext.line(), "");
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * NastranWriter_benchmark.cpp
+ *
+ * Time of GRID cards written as NastranWriter::writeNodes does, with the dedicated real
+ * encoder and with the former boost::format based formatting.
+ * Usage: NastranWriter_benchmark [number of nodes (default 1000000)]
+ */
+
+#include "../../Nastran/NastranWriter.h"
+#include <boost/algorithm/string.hpp>
+#include <boost/format.hpp>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace vega;
+using namespace nastran;
+
+/**
+ * Formatting of Line::add(double) before the dedicated encoder, as in NastranWriter_test.
+ */
+static string legacyReal(double value) {
+	if (is_zero(value)) {
+		return "0.";
+	}
+	string str1 = str(boost::format("%8.11e") % value);
+	boost::algorithm::trim(str1);
+	size_t pos = str1.find("e");
+	double mant = stod(str1.substr(0, pos));
+	string exp2 = to_string(stoi(str1.substr(pos + 1)));
+	boost::algorithm::trim_left_if(exp2, boost::is_any_of("-+"));
+	char sign = abs(value) < 1. ? '-' : '+';
+	size_t leftover = 5 - exp2.size();
+	leftover -= value < 0 ? 1 : 0;
+	const string fmt = str(boost::format("%%1.%sf") % leftover);
+	string svalue3 = str(boost::format(fmt) % mant);
+	boost::algorithm::trim_if(svalue3, boost::is_any_of("0"));
+	return svalue3 + sign + exp2;
+}
+
+int main(int argc, char* argv[]) {
+	const int nodeCount = argc > 1 ? stoi(argv[1]) : 1000000;
+	vector<double> coordinates;
+	for (int i = 0; i < 3 * nodeCount; i++) {
+		coordinates.push_back(0.001 * i - 12.5 + 1.0 / (i + 3));
+	}
+
+	ostringstream legacyOut;
+	auto start = chrono::steady_clock::now();
+	for (int i = 0; i < nodeCount; i++) {
+		legacyOut << Line("GRID").add(i + 1).add().add(legacyReal(coordinates[3 * i]))
+				.add(legacyReal(coordinates[3 * i + 1])).add(legacyReal(coordinates[3 * i + 2]));
+	}
+	const auto legacyTime = chrono::steady_clock::now() - start;
+
+	ostringstream out;
+	start = chrono::steady_clock::now();
+	for (int i = 0; i < nodeCount; i++) {
+		out << Line("GRID").add(i + 1).add().add(coordinates[3 * i]).add(coordinates[3 * i + 1])
+				.add(coordinates[3 * i + 2]);
+	}
+	const auto time = chrono::steady_clock::now() - start;
+
+	cout << nodeCount << " GRID cards, boost::format: "
+			<< chrono::duration_cast<chrono::milliseconds>(legacyTime).count() << " ms ("
+			<< legacyOut.str().size() << " bytes), formatReal: "
+			<< chrono::duration_cast<chrono::milliseconds>(time).count() << " ms ("
+			<< out.str().size() << " bytes)" << endl;
+	return 0;
+}
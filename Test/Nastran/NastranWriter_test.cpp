@@ -10,9 +10,12 @@
 
 #define BOOST_TEST_MODULE nastran_parser_tests
 #include "../../Nastran/NastranWriter.h"
+#include "../../Nastran/NastranTokenizer.h"
 #include "build_properties.h"
 #include <boost/test/unit_test.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/format.hpp>
 #include <iostream>
 #if defined VDEBUG && defined __GNUC_ && !defined(_WIN32)
 #include <valgrind/memcheck.h>
@@ -27,7 +30,98 @@ using namespace nastran;
 BOOST_AUTO_TEST_CASE( test_float_write ) {
     std::ostringstream strs;
     strs << Line("GRID").add(3.141593);
-    BOOST_CHECK_EQUAL(strs.str(), "GRID    3.1416+0\n");
+    BOOST_CHECK_EQUAL(strs.str(), "GRID    3.141593\n");
+}
+
+BOOST_AUTO_TEST_CASE( test_real_formats ) {
+    auto small = [](double value) {
+        char buffer[Line::REAL_BUFFER_SIZE];
+        return string(buffer, Line::formatReal(value, 8, buffer));
+    };
+    auto large = [](double value) {
+        char buffer[Line::REAL_BUFFER_SIZE];
+        return string(buffer, Line::formatReal(value, 16, buffer));
+    };
+    BOOST_CHECK_EQUAL("0.", small(0.0));
+    BOOST_CHECK_EQUAL("1.5", small(1.5));
+    BOOST_CHECK_EQUAL("-.25", small(-0.25));
+    BOOST_CHECK_EQUAL("100.", small(100.0));
+    BOOST_CHECK_EQUAL("1234567.", small(1234567.0));
+    BOOST_CHECK_EQUAL("1.2346+7", small(12345678.0));
+    BOOST_CHECK_EQUAL(".0012346", small(0.00123456));
+    BOOST_CHECK_EQUAL("1.2346-5", small(1.23456e-5));
+    BOOST_CHECK_EQUAL("-1.235-5", small(-1.23456e-5));
+    BOOST_CHECK_EQUAL("1.+100", small(1e100));
+    BOOST_CHECK_EQUAL("10.", small(9.99999999));
+    BOOST_CHECK_EQUAL("1.-7", small(9.99999999e-8));
+    BOOST_CHECK_EQUAL("3.14159265358979", large(3.14159265358979));
+    BOOST_CHECK_EQUAL("-1.2345678901-12", large(-1.2345678901e-12));
+
+    std::ostringstream strs;
+    strs << Line("GRID*").add(-0.25);
+    BOOST_CHECK_EQUAL(strs.str(), "GRID*               -.25\n");
+}
+
+/**
+ * Formatting of Line::add(double) before the dedicated encoder, kept as a reference.
+ */
+static string legacyReal(double value) {
+    if (is_zero(value)) {
+        return "0.";
+    }
+    string str1 = str(boost::format("%8.11e") % value);
+    boost::algorithm::trim(str1);
+    size_t pos = str1.find("e");
+    double mant = stod(str1.substr(0, pos));
+    string exp2 = to_string(stoi(str1.substr(pos + 1)));
+    boost::algorithm::trim_left_if(exp2, boost::is_any_of("-+"));
+    char sign = abs(value) < 1. ? '-' : '+';
+    size_t leftover = 5 - exp2.size();
+    leftover -= value < 0 ? 1 : 0;
+    const string fmt = str(boost::format("%%1.%sf") % leftover);
+    string svalue3 = str(boost::format(fmt) % mant);
+    boost::algorithm::trim_if(svalue3, boost::is_any_of("0"));
+    return svalue3 + sign + exp2;
+}
+
+BOOST_AUTO_TEST_CASE( test_real_round_trip ) {
+    vector<double> values;
+    unsigned long long seed = 12345;
+    for (int i = 0; i < 20000; i++) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        const double mantissa = static_cast<double>(seed >> 11) / static_cast<double>(1ULL << 53);
+        const int exponent = static_cast<int>((seed >> 3) % 27) - 13;
+        values.push_back((i % 2 == 0 ? 1 : -1) * (1.0 + 9.0 * mantissa) * pow(10.0, exponent));
+    }
+    values.insert(values.end(), {1.0, -1.0, 0.1, 1e-14, 9.9999999e99, 123456.5, 0.5, 99999999.9});
+
+    for (double value : values) {
+        // Small field: written in a GRID card, read back by the tokenizer (values below
+        // Globals::DOUBLE_COMPARE_TOLERANCE are written as 0.)
+        std::ostringstream card;
+        card << Line("GRID").add(1).add().add(value);
+        istringstream istr(card.str());
+        NastranTokenizer tokenizer(istr);
+        tokenizer.bulkSection();
+        tokenizer.nextLine();
+        BOOST_CHECK_EQUAL("GRID", tokenizer.nextString());
+        BOOST_CHECK_EQUAL(1, tokenizer.nextInt());
+        tokenizer.skip(1);
+        const double smallValue = tokenizer.nextDouble();
+
+        double legacyValue = 0;
+        BOOST_REQUIRE(NastranTokenizer::decodeDouble(legacyReal(value), legacyValue));
+        // never less accurate than the previous formatting
+        BOOST_CHECK_LE(abs(smallValue - value), abs(legacyValue - value) * (1 + 1e-12));
+        BOOST_CHECK_LE(abs(smallValue - value), 5e-3 * abs(value));
+
+        char buffer[Line::REAL_BUFFER_SIZE];
+        const size_t length = Line::formatReal(value, 16, buffer);
+        BOOST_CHECK_LE(length, 16u);
+        double largeValue = 0;
+        BOOST_REQUIRE(NastranTokenizer::decodeDouble(boost::string_ref(buffer, length), largeValue));
+        BOOST_CHECK_LE(abs(largeValue - value), 1e-9 * abs(value));
+    }
 }
 
 
@@ -21,6 +21,21 @@ using namespace std;
 using namespace vega;
 using vega::result::F06Parser;
 
+/**
+ * Count the assertions, one by entry of the bulk assertions.
+ */
+static size_t countAssertions(const vector<shared_ptr<Assertion>>& assertions) {
+	size_t count = 0;
+	for (const auto& assertion : assertions) {
+		if (assertion->type == Objective::Type::BULK_NODAL_DISPLACEMENT_ASSERTION) {
+			count += static_pointer_cast<BulkNodalDisplacementAssertion>(assertion)->entryCount();
+		} else {
+			count++;
+		}
+	}
+	return count;
+}
+
 BOOST_AUTO_TEST_CASE(nastran_f06_parsing) {
 
 	string testLocation(
@@ -55,25 +70,34 @@ BOOST_AUTO_TEST_CASE(nastran_f06_parsing) {
 			model->find(Reference<Analysis>(Analysis::Type::LINEAR_MECA_STAT, 1)));
 	BOOST_ASSERT(linearMecaStat1!=nullptr);
 	vector<shared_ptr<Assertion>> assertions = linearMecaStat1->getAssertions();
-	BOOST_CHECK_EQUAL(assertions.size(), 30);
+	BOOST_CHECK_EQUAL(countAssertions(assertions), 30);
 
 	model->finish();
 	//ineffective assertions are removed by model->finish()
 	vector<shared_ptr<Assertion>> assertions2 = linearMecaStat1->getAssertions();
-	BOOST_CHECK_EQUAL(assertions2.size(), 30);
+	BOOST_CHECK_EQUAL(countAssertions(assertions2), 30);
 	bool found = false;
 	for (const auto& assertion : assertions) {
 
-		BOOST_CHECK(assertion->type == Objective::Type::NODAL_DISPLACEMENT_ASSERTION);
-		NodalDisplacementAssertion & nodalDispAssertion =
-				dynamic_cast<NodalDisplacementAssertion&>(*assertion);
-		int nodeId = model->mesh.findNodeId(nodalDispAssertion.nodePosition);
-		if (nodeId == 3 && nodalDispAssertion.dof == DOF::DX) {
-			found = true;
-			BOOST_CHECK_EQUAL(nodalDispAssertion.value, 4.901961E-01);
+		BOOST_CHECK(assertion->type == Objective::Type::BULK_NODAL_DISPLACEMENT_ASSERTION);
+		const auto& bulkAssertion = dynamic_pointer_cast<BulkNodalDisplacementAssertion>(assertion);
+		for (size_t entry = 0; entry < bulkAssertion->entryCount(); entry++) {
+			int nodeId = model->mesh.findNodeId(bulkAssertion->getNodePosition(entry));
+			if (nodeId == 3 && bulkAssertion->getDOF(entry) == DOF::DX) {
+				found = true;
+				BOOST_CHECK_EQUAL(bulkAssertion->getValue(entry), 4.901961E-01);
+				BOOST_CHECK_EQUAL(bulkAssertion->getTolerance(entry), 0.0003);
+			}
 		}
 	}
 	BOOST_CHECK_EQUAL(found, true);
+
+	// Sampling keeps every DOF of the chosen nodes
+	const auto& bulkAssertion = dynamic_pointer_cast<BulkNodalDisplacementAssertion>(assertions2[0]);
+	bulkAssertion->sampleNodes(2);
+	BOOST_CHECK_EQUAL(bulkAssertion->entryCount(), 12);
+	BOOST_CHECK_EQUAL(bulkAssertion->nodePositions().size(), 2);
+	BOOST_CHECK_EQUAL(bulkAssertion->getDOFSForNode(bulkAssertion->getNodePosition(0)), DOFS::ALL_DOFS);
 }
 
 BOOST_AUTO_TEST_CASE(node_not_in_elements) {
@@ -107,7 +131,7 @@ BOOST_AUTO_TEST_CASE(node_not_in_elements) {
 
 	//assertion skipped because nodes are not in elements
 	vector<shared_ptr<Assertion>> assertions = linearMecaStat1->getAssertions();
-	BOOST_CHECK_EQUAL(assertions.size(), 0);
+	BOOST_CHECK_EQUAL(countAssertions(assertions), 0);
 
 }
 
@@ -151,12 +175,12 @@ BOOST_AUTO_TEST_CASE(test_4a) {
 	BOOST_ASSERT(linearMecaStat1 != nullptr);
 	//before finish() in the model are present all the assertion found in the f06 file
 	vector<shared_ptr<Assertion>> all_assertions = linearMecaStat1->getAssertions();
-	BOOST_CHECK_EQUAL(all_assertions.size(), 54);
+	BOOST_CHECK_EQUAL(countAssertions(all_assertions), 54);
 
 	model->finish();
 	//assertion deleted because nodes are not in elements
 	vector<shared_ptr<Assertion>> assertions = linearMecaStat1->getAssertions();
-	BOOST_CHECK_EQUAL(assertions.size(), 30);
+	BOOST_CHECK_EQUAL(countAssertions(assertions), 30);
 
 }
 
@@ -219,7 +243,7 @@ BOOST_AUTO_TEST_CASE(test_modal_disp) {
 			model->find(Reference<Analysis>(Analysis::Type::LINEAR_MECA_STAT, 2)));
 	BOOST_ASSERT(linearStatic2!=nullptr);
 	vector<shared_ptr<Assertion>> all_assertions2 = linearStatic2->getAssertions();
-	BOOST_CHECK_EQUAL(all_assertions2.size(), 42);
+	BOOST_CHECK_EQUAL(countAssertions(all_assertions2), 42);
 	//before finish() in the model are present all the assertion found in the f06 file
 
 